@@ -11,8 +11,8 @@
 #ifndef FAUNA_OUTPUT_COMBINED_DATA_H
 #define FAUNA_OUTPUT_COMBINED_DATA_H
 
-#include "habitat_data.h"
-#include "herbivore_data.h"
+#include "Fauna/Output/habitat_data.h"
+#include "Fauna/Output/herbivore_data.h"
 
 namespace Fauna {
 namespace Output {
@@ -13,8 +13,8 @@
 
 #include <string>
 
-#include "combined_data.h"
-#include "date_interval.h"
+#include "Fauna/Output/combined_data.h"
+#include "Fauna/date_interval.h"
 
 namespace Fauna {
 namespace Output {
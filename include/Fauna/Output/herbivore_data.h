@@ -13,8 +13,9 @@
 
 #include <map>
 
-#include "forage_values.h"
-#include "hft.h"
+#include "Fauna/forage_values.h"
+#include "Fauna/hft.h"
+#include "Fauna/storage_real.h"
 
 namespace Fauna {
 namespace Output {
@@ -24,13 +25,13 @@ struct HerbivoreData {
   /** @{ \name Per-individual variables */
 
   /// Age in years.
-  double age_years = 0.0;
+  StorageReal age_years = 0.0;
 
   /// Body fat [fraction].
-  double bodyfat = 0.0;
+  StorageReal bodyfat = 0.0;
 
   /// Energy expenditure [MJ/ind/day].
-  double expenditure = 0.0;
+  StorageReal expenditure = 0.0;
 
   /** @} */  // Per-Individual variables
 
@@ -38,16 +39,16 @@ struct HerbivoreData {
   /** @{ \name Per-habitat variables */
 
   /// Individual density [ind/km²].
-  double inddens = 0.0;
+  StorageReal inddens = 0.0;
 
   /// Mass density [kg/km²].
-  double massdens = 0.0;
+  StorageReal massdens = 0.0;
 
   /// Daily mortality rate [ind/ind/day].
   std::map<Fauna::MortalityFactor, double> mortality;
 
   /// Newborns (offspring) per day [ind/km²/day].
-  double offspring = 0.0;
+  StorageReal offspring = 0.0;
 
   /// Eaten forage per individual [kgDM/ind/day].
   Fauna::ForageMass eaten_forage_per_ind = 0.0;
@@ -56,7 +57,7 @@ struct HerbivoreData {
   Fauna::ForageMass eaten_forage_per_mass = 0.0;
 
   /// Ingested nitrogen mass per individual and day [mgN/ind/day].
-  double eaten_nitrogen_per_ind = 0.0;
+  StorageReal eaten_nitrogen_per_ind = 0.0;
 
   /// Net energy content of available forage [MJ/kgDM].
   Fauna::ForageEnergyContent energy_content = 0.0;
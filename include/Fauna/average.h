@@ -13,7 +13,13 @@
 
 #include <vector>
 
+#include "Fauna/storage_real.h"
+
 namespace Fauna {
+// Forward declarations
+class CheckpointReader;
+class CheckpointWriter;
+
 
 /// Build weighted average of two numbers.
 /**
@@ -65,8 +71,20 @@ class PeriodAverage {
    */
   double get_first() const;
 
+  /// Memory that the recorded values occupy on the heap [bytes].
+  std::size_t get_heap_bytes() const {
+    return values.capacity() * sizeof(StorageReal);
+  }
+
+  /// Restore the recorded values from a checkpoint.
+  /** \throw std::runtime_error If the checkpoint data is corrupt. */
+  void load_state(CheckpointReader& in);
+
+  /// Append the recorded values to a checkpoint.
+  void save_state(CheckpointWriter& out) const;
+
  private:
-  std::vector<double> values;
+  std::vector<StorageReal> values;
   unsigned int count;  // constant
   unsigned int current_index = 0;
 };
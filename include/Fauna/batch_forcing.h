@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Forage and environment of many habitats as arrays.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_BATCH_FORCING_H
+#define FAUNA_BATCH_FORCING_H
+
+#include <cstddef>
+
+namespace Fauna {
+
+/// Today’s forcing for all batch habitats as structure of arrays.
+/**
+ * A host program that keeps its vegetation in contiguous arrays can pass
+ * them directly to \ref World::simulate_day(const Date&, const
+ * BatchForcing&, const World::SimDayOptions&) instead of implementing
+ * \ref Habitat for every cell.
+ *
+ * Every array is indexed by the number that
+ * \ref World::create_batch_simulation_unit() has returned for the habitat.
+ * It must have at least \ref World::get_batch_habitat_count() elements.
+ * The arrays are not copied; they only need to stay valid during the call
+ * of `simulate_day()`.
+ *
+ * \see \ref sec_design_batch_forcing
+ */
+struct BatchForcing {
+  /// Dry matter grass mass available to herbivores [kgDM/km²].
+  const double* grass_mass = NULL;
+
+  /// Digestibility of the grass [fractional].
+  const double* grass_digestibility = NULL;
+
+  /// Nitrogen mass in the grass [kgN/km²].
+  const double* grass_nitrogen_mass = NULL;
+
+  /// Fraction of the habitat covered by grass [fractional].
+  /** \see \ref GrassForage::get_fpc() */
+  const double* grass_fpc = NULL;
+
+  /// Ambient air temperature near ground [°C], whole-day average.
+  const double* air_temperature = NULL;
+
+  /// Output: Dry matter grass mass eaten by herbivores today [kgDM/km²].
+  /**
+   * The array is set to zero at the beginning of the day. The host program
+   * is responsible to remove the eaten forage from its vegetation.
+   */
+  double* eaten_grass = NULL;
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_BATCH_FORCING_H
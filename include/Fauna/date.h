@@ -56,6 +56,14 @@ class Date {
   /// The year specified in the constructor.
   int get_year() const { return year; }
 
+  /// The following day.
+  /**
+   * This assumes a non-leap year like \ref is_successive(): Julian day 364
+   * is followed by day 0 of the next year. Day 365 of a leap year is also
+   * followed by day 0.
+   */
+  Date get_next() const;
+
   /// Whether another Date object represents the following day.
   /**
    * This assumes a non-leap year: A Julian day of 364 (0==Jan 1st) can be
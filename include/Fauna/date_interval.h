@@ -11,7 +11,7 @@
 #ifndef FAUNA_DATE_INTERVAL_H
 #define FAUNA_DATE_INTERVAL_H
 
-#include "date.h"
+#include "Fauna/date.h"
 
 namespace Fauna {
 // Forward Declarations
@@ -0,0 +1,327 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Record and replay the habitat forcing of the host program.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_FORCING_TRACE_H
+#define FAUNA_FORCING_TRACE_H
+
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Fauna/Output/habitat_data.h"
+#include "Fauna/environment.h"
+#include "Fauna/habitat.h"
+#include "Fauna/habitat_forage.h"
+
+namespace Fauna {
+
+/// Writes the daily forcing of \ref RecordingHabitat objects to a file.
+/**
+ * The binary trace file contains one record for each habitat (aggregation
+ * unit and initial environment) and one record for each day of each habitat
+ * (available forage, environment, and habitat output after
+ * \ref Habitat::init_day()). The records are written as they come, so the
+ * file grows while the simulation runs.
+ *
+ * Like a checkpoint, the format depends on the platform and on the memory
+ * layout of the forage classes. It is meant to reproduce a simulation on
+ * a similar machine, not for archiving.
+ *
+ * All functions are thread-safe.
+ * \see \ref sec_design_forcing_trace
+ */
+class ForcingRecorder {
+ public:
+  /// Constructor: Create the trace file and write the header.
+  /**
+   * \param filename Path to the trace file. An existing file is overwritten.
+   * \throw std::runtime_error If the file cannot be opened.
+   */
+  ForcingRecorder(const std::string& filename);
+
+  /// Write all buffered records to the file.
+  /**
+   * \throw std::runtime_error If writing fails.
+   */
+  void flush();
+
+  /// Number of habitats registered so far.
+  int get_habitat_count() const;
+
+ private:
+  /// Register a new habitat and return its ID.
+  int add_habitat(const std::string& aggregation_unit,
+                  const HabitatEnvironment& environment);
+
+  /// Write the forcing of one habitat on one day.
+  void add_day(const int id, const int day, const HabitatForage& forage,
+               const HabitatEnvironment& environment,
+               const Output::HabitatData& output);
+
+  /// Throw an exception if the file stream is not good.
+  void check_file(const std::string& caller) const;
+
+  std::ofstream file;
+  const std::string filename;
+  int habitat_count = 0;
+  mutable std::mutex mutex;
+
+  friend class RecordingHabitat;
+};
+
+/// Decorator for a habitat of the host program to record its forcing.
+/**
+ * Pass an object of this class to \ref World::create_simulation_unit()
+ * instead of the original habitat. All calls are forwarded to the wrapped
+ * habitat, and each day is written to the \ref ForcingRecorder.
+ *
+ * \warning \ref Habitat::kill() is not virtual. Call it on the recording
+ * habitat, not on the wrapped one.
+ */
+class RecordingHabitat : public Habitat {
+ public:
+  /// Constructor: Register the habitat with the recorder.
+  /**
+   * \param habitat The habitat of the host program.
+   * \param recorder The trace file to write to.
+   * \throw std::invalid_argument If a pointer is NULL.
+   */
+  RecordingHabitat(std::shared_ptr<Habitat> habitat,
+                   std::shared_ptr<ForcingRecorder> recorder);
+
+  virtual const char* get_aggregation_unit() const {
+    return habitat->get_aggregation_unit();
+  }
+  virtual HabitatForage get_available_forage() const {
+    return habitat->get_available_forage();
+  }
+  virtual HabitatEnvironment get_environment() const {
+    return habitat->get_environment();
+  }
+
+  /// Initialize the wrapped habitat and record the day.
+  /**
+   * The output of this object is copied from the wrapped habitat.
+   */
+  virtual void init_day(const int today);
+
+  /// Remove the forage from the wrapped habitat and copy its output.
+  virtual void remove_eaten_forage(const ForageMass& eaten_forage);
+
+  /// The wrapped habitat.
+  Habitat& get_habitat() { return *habitat; }
+
+ private:
+  /// Check the pointers and register the habitat with the recorder.
+  static int register_habitat(
+      const std::shared_ptr<Habitat>& habitat,
+      const std::shared_ptr<ForcingRecorder>& recorder);
+
+  std::shared_ptr<Habitat> habitat;
+  std::shared_ptr<ForcingRecorder> recorder;
+  const int id;
+};
+
+/// Reads a trace file written by \ref ForcingRecorder.
+/**
+ * On construction, the file is scanned once for the habitat records. The
+ * daily records are then streamed from the file as the
+ * \ref ReplayHabitat objects request them. Records of other habitats that
+ * are read on the way are kept in memory until requested, so the memory
+ * usage is small if the habitats are simulated in the same order as when
+ * they were recorded.
+ *
+ * All functions are thread-safe.
+ * \see \ref sec_design_forcing_trace
+ */
+class ForcingPlayer {
+ public:
+  /// The recorded forcing of one habitat on one day.
+  struct Day {
+    /// Day of the year as passed to \ref Habitat::init_day().
+    int day;
+    /// Forage available to the herbivores.
+    HabitatForage forage;
+    /// Abiotic environment.
+    HabitatEnvironment environment;
+    /// Habitat output after \ref Habitat::init_day().
+    Output::HabitatData output;
+  };
+
+  /// Constructor: Open the trace file and read the habitat records.
+  /**
+   * \param filename Path to the trace file.
+   * \throw std::runtime_error If the file cannot be read, is not a forcing
+   * trace, or was written on an incompatible platform.
+   */
+  ForcingPlayer(const std::string& filename);
+
+  /// Number of recorded habitats.
+  int get_habitat_count() const { return habitats.size(); }
+
+  /// Aggregation unit of a habitat.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  const std::string& get_aggregation_unit(const int id) const;
+
+  /// Number of recorded days of a habitat.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  int get_day_count(const int id) const;
+
+  /// Environment of a habitat before the first day.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  const HabitatEnvironment& get_initial_environment(const int id) const;
+
+  /// Read the next day of a habitat.
+  /**
+   * \throw std::out_of_range If `id` is not a valid habitat ID.
+   * \throw std::runtime_error If there are no more days for this habitat or
+   * if the file is corrupt.
+   */
+  Day read_day(const int id);
+
+ private:
+  /// Header information of one habitat.
+  struct HabitatRecord {
+    std::string aggregation_unit;
+    HabitatEnvironment environment;
+    int day_count = 0;
+    /// Days read from the file but not yet requested.
+    std::deque<Day> pending;
+  };
+
+  /// Get the habitat record or throw std::out_of_range.
+  const HabitatRecord& get_record(const int id) const;
+
+  std::ifstream file;
+  const std::string filename;
+  std::vector<HabitatRecord> habitats;
+  mutable std::mutex mutex;
+};
+
+/// A forcing trace that is read completely into memory.
+/**
+ * Unlike \ref ForcingPlayer, this object is not changed by replaying it.
+ * Therefore many \ref ReplayHabitat objects in different \ref World
+ * objects can share it, for example to simulate an ensemble of parameter
+ * sets with identical forcing. All functions are thread-safe because they
+ * only read.
+ * \see \ref sec_design_forcing_trace
+ */
+class ForcingTrace {
+ public:
+  /// Constructor: Read all days of all habitats.
+  /**
+   * \param player The trace file. Its days are consumed.
+   * \throw std::runtime_error If the file is corrupt.
+   */
+  ForcingTrace(ForcingPlayer& player);
+
+  /// Number of recorded habitats.
+  int get_habitat_count() const { return habitats.size(); }
+
+  /// Aggregation unit of a habitat.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  const std::string& get_aggregation_unit(const int id) const;
+
+  /// Number of recorded days of a habitat.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  int get_day_count(const int id) const;
+
+  /// Environment of a habitat before the first day.
+  /** \throw std::out_of_range If `id` is not a valid habitat ID. */
+  const HabitatEnvironment& get_initial_environment(const int id) const;
+
+  /// A recorded day of a habitat.
+  /**
+   * \param id Habitat ID.
+   * \param index Zero-based index of the recorded day.
+   * \throw std::out_of_range If `id` or `index` is out of range.
+   */
+  const ForcingPlayer::Day& get_day(const int id, const int index) const;
+
+ private:
+  /// All information of one habitat.
+  struct HabitatRecord {
+    std::string aggregation_unit;
+    HabitatEnvironment environment;
+    std::vector<ForcingPlayer::Day> days;
+  };
+
+  /// Get the habitat record or throw std::out_of_range.
+  const HabitatRecord& get_record(const int id) const;
+
+  std::vector<HabitatRecord> habitats;
+};
+
+/// A habitat that repeats the forcing from a trace file.
+/**
+ * Forage, environment, and habitat output are set from the next recorded day
+ * in \ref init_day(). This reproduces the herbivore simulation of the
+ * recording run without the host program.
+ */
+class ReplayHabitat : public Habitat {
+ public:
+  /// Constructor.
+  /**
+   * \param player The trace file to read from.
+   * \param id Index of the recorded habitat, in the order the
+   * \ref RecordingHabitat objects were created.
+   * \throw std::invalid_argument If `player` is NULL.
+   * \throw std::out_of_range If `id` is not a valid habitat ID.
+   */
+  ReplayHabitat(std::shared_ptr<ForcingPlayer> player, const int id);
+
+  /// Constructor for a trace in memory.
+  /**
+   * \param trace The trace, which may be shared with other habitats.
+   * \param id Index of the recorded habitat.
+   * \throw std::invalid_argument If `trace` is NULL.
+   * \throw std::out_of_range If `id` is not a valid habitat ID.
+   */
+  ReplayHabitat(std::shared_ptr<const ForcingTrace> trace, const int id);
+
+  virtual const char* get_aggregation_unit() const {
+    return aggregation_unit.c_str();
+  }
+  virtual HabitatForage get_available_forage() const { return forage; }
+  virtual HabitatEnvironment get_environment() const { return environment; }
+
+  /// Read the next day from the trace.
+  /**
+   * \throw std::runtime_error If the recorded day doesn’t match `today` or
+   * if there are no more recorded days.
+   */
+  virtual void init_day(const int today);
+
+  /// Whether all recorded days have been replayed.
+  /**
+   * This is how the host program learns that the recorded habitat has been
+   * killed or that the recording has ended.
+   */
+  bool is_exhausted() const { return remaining_days <= 0; }
+
+ private:
+  /// Source of the days if the trace is streamed from file.
+  std::shared_ptr<ForcingPlayer> player;
+  /// Source of the days if the trace is in memory.
+  std::shared_ptr<const ForcingTrace> trace;
+  const int id;
+  const std::string aggregation_unit;
+  HabitatForage forage;
+  HabitatEnvironment environment;
+  const int day_count;
+  int remaining_days;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_FORCING_TRACE_H
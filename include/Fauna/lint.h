@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Check instruction files without running a simulation.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_LINT_H
+#define FAUNA_LINT_H
+
+#include <string>
+#include <vector>
+
+namespace Fauna {
+
+/// The result of checking one instruction file.
+struct LintResult {
+  /// Path to the instruction file.
+  std::string filename;
+
+  /// Whether a simulation could be started with the instruction file.
+  bool valid = false;
+
+  /// Why the instruction file is not valid.
+  /** Empty if \ref valid is true. */
+  std::string errors;
+
+  /// Warnings about a valid instruction file, e.g. deprecated parameters.
+  std::string warnings;
+};
+
+/// Check an instruction file without running a simulation.
+/**
+ * This constructs a \ref World in \ref SimMode::Lint, exactly like the
+ * program `megafauna_insfile_linter`. No files are created.
+ * \param filename Path to the instruction file.
+ * \return The result; this function doesn’t throw on invalid files.
+ */
+LintResult lint_instruction_file(const std::string& filename);
+
+/// Check many instruction files in parallel.
+/**
+ * \param filenames Paths to the instruction files.
+ * \param threads Number of worker threads. Zero means one thread per CPU
+ * core.
+ * \return One result for each file, in the same order as `filenames`.
+ * \see \ref lint_instruction_file()
+ */
+std::vector<LintResult> lint_instruction_files(
+    const std::vector<std::string>& filenames, int threads = 0);
+
+}  // namespace Fauna
+
+#endif  // FAUNA_LINT_H
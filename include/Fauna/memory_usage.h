@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Estimated memory use of a megafauna world.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_MEMORY_USAGE_H
+#define FAUNA_MEMORY_USAGE_H
+
+#include <cstddef>
+#include <ostream>
+
+namespace Fauna {
+
+/// Approximate memory held by the parts of a \ref World object.
+/**
+ * All sizes are estimates in bytes. They include the objects themselves
+ * and what they allocate on the heap, but not the overhead of the heap
+ * allocator or the habitats of the host program.
+ * \see \ref World::get_memory_usage()
+ * \see \ref sec_design_memory_usage
+ */
+struct MemoryUsage {
+  /// Number of \ref SimulationUnit objects.
+  std::size_t simulation_unit_count = 0;
+
+  /// Number of herbivore populations in all simulation units.
+  std::size_t population_count = 0;
+
+  /// Number of herbivore objects (e.g. cohorts) in all populations.
+  std::size_t cohort_count = 0;
+
+  /// Simulation units without their populations [bytes].
+  std::size_t simulation_units = 0;
+
+  /// Population objects without their herbivores [bytes].
+  std::size_t populations = 0;
+
+  /// Herbivore objects, including free memory in their pools [bytes].
+  std::size_t cohorts = 0;
+
+  /// Output datapoints waiting to be written or retrieved [bytes].
+  std::size_t output_buffers = 0;
+
+  /// Output data being aggregated for the current output interval [bytes].
+  std::size_t aggregator = 0;
+
+  /// Sum of all sizes [bytes].
+  std::size_t get_total() const {
+    return simulation_units + populations + cohorts + output_buffers +
+           aggregator;
+  }
+
+  /// Write all values as human-readable lines of text.
+  void print(std::ostream& out) const;
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_MEMORY_USAGE_H
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Memory statistics of the herbivore node pools.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_POOL_STATISTICS_H
+#define FAUNA_POOL_STATISTICS_H
+
+#include <cstddef>
+
+namespace Fauna {
+
+/// Memory held by one or more node pools.
+/**
+ * \see \ref World::get_pool_statistics()
+ * \see \ref sec_design_node_pools
+ */
+struct PoolStatistics {
+  /// Number of memory chunks currently reserved from the system.
+  std::size_t chunks = 0;
+
+  /// Number of nodes that fit into all reserved chunks.
+  std::size_t capacity = 0;
+
+  /// Number of nodes currently in use.
+  std::size_t in_use = 0;
+
+  /// Bytes currently reserved from the system.
+  std::size_t bytes = 0;
+
+  /// Number of node allocations since the pools were created.
+  long long allocations = 0;
+
+  /// How many of the \ref allocations recycled a previously freed node.
+  long long reuses = 0;
+
+  /// Add the numbers of another pool.
+  PoolStatistics& operator+=(const PoolStatistics& other) {
+    chunks += other.chunks;
+    capacity += other.capacity;
+    in_use += other.in_use;
+    bytes += other.bytes;
+    allocations += other.allocations;
+    reuses += other.reuses;
+    return *this;
+  }
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_POOL_STATISTICS_H
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Run-time measurements of the simulation phases.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_PROFILE_H
+#define FAUNA_PROFILE_H
+
+#include <array>
+#include <ostream>
+#include <string>
+
+namespace Fauna {
+
+/// Phases of \ref World::simulate_day() that are timed separately.
+/** \see \ref Profile */
+enum class ProfilePhase {
+  /// Marking non-viable herbivores as dead: PopulationInterface::kill_nonviable
+  KillNonviable,
+  /// (Re-)establishing herbivores in empty populations.
+  Establishment,
+  /// Daily simulation of each herbivore: HerbivoreInterface::simulate_day()
+  SimulateHerbivores,
+  /// Calculating forage demands: HerbivoreInterface::get_forage_demands()
+  FeedingDemand,
+  /// Distributing forage among herbivores: DistributeForage
+  FeedingDistribute,
+  /// Feeding the forage portions: HerbivoreInterface::eat()
+  FeedingEat,
+  /// Creating new herbivores: PopulationInterface::create_offspring()
+  CreateOffspring,
+  /// Removing dead herbivores: PopulationInterface::purge_of_dead()
+  PurgeOfDead,
+  /// Collecting the output of one day: SimulationUnit::get_output()
+  GetOutput,
+  /// Aggregating output over space and time: Output::Aggregator
+  Aggregation,
+  /// Passing completed output to the output writer.
+  OutputWriting
+};
+
+/// Number of entries in \ref ProfilePhase.
+const int PROFILE_PHASE_COUNT = 11;
+
+/// Get a short, unique name for the profile phase.
+/** \see \ref ProfilePhase */
+const std::string& get_profile_phase_name(const ProfilePhase);
+
+/// Accumulated run-time measurements and counters of the simulation.
+/**
+ * Profiling is disabled by default. Enable it with
+ * \ref World::enable_profiling(). The timers then measure the wall-clock
+ * time of each \ref ProfilePhase, summed over all simulation units and days.
+ */
+struct Profile {
+  /// Summed run time of one phase.
+  struct Timer {
+    /// Wall-clock time [s].
+    double seconds = 0.0;
+    /// How often the timer was started.
+    long long calls = 0;
+  };
+
+  /// Timers for each phase, indexed by \ref ProfilePhase.
+  std::array<Timer, PROFILE_PHASE_COUNT> timers;
+
+  /// Number of calls to \ref World::simulate_day().
+  long long days = 0;
+
+  /// Number of simulated days summed over all simulation units.
+  long long unit_days = 0;
+
+  /// Part of \ref unit_days without herbivores in the simulation unit.
+  /**
+   * On these days only the habitat was updated.
+   * \see \ref sec_design_empty_units
+   */
+  long long empty_unit_days = 0;
+
+  /// Number of simulated days summed over all herbivore objects (cohorts).
+  long long herbivore_days = 0;
+
+  /// Number of feeding loops summed over all simulation units and days.
+  /**
+   * Herbivores are fed in several iterations to allow prey switching.
+   * \see \ref FeedHerbivores
+   */
+  long long feeding_iterations = 0;
+
+  /// Access the timer of one phase.
+  Timer& operator[](const ProfilePhase phase) {
+    return timers[static_cast<int>(phase)];
+  }
+
+  /// Read-only access to the timer of one phase.
+  const Timer& operator[](const ProfilePhase phase) const {
+    return timers[static_cast<int>(phase)];
+  }
+
+  /// Add the timers and counters of another profile.
+  /**
+   * With parallel simulation units, each thread measures into its own
+   * profile, and they are summed up afterwards.
+   * \see \ref World::enable_threads()
+   */
+  Profile& operator+=(const Profile& other);
+
+  /// The sum of all timers [s].
+  double get_total_seconds() const;
+
+  /// Write a human-readable table of all timers and counters.
+  void print(std::ostream& stream) const;
+
+  /// Set all timers and counters to zero.
+  void reset() { *this = Profile(); }
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_PROFILE_H
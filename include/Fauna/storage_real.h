@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Floating point type for stored herbivore state and output.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_STORAGE_REAL_H
+#define FAUNA_STORAGE_REAL_H
+
+namespace Fauna {
+
+/// Floating point type to store herbivore state variables and output.
+/**
+ * Calculations are always done in `double`. Only the values that are kept
+ * from one day to the next in every herbivore cohort and in the output
+ * containers use this type. With the CMake option `MEGAFAUNA_FLOAT_STORAGE`
+ * it is `float`, which halves the memory and bandwidth for them.
+ *
+ * The macro changes the layout of public classes. A host program that
+ * includes the library headers must be compiled with the same definition.
+ * Linking against the CMake target `ModularMegafaunaModel` does that
+ * automatically.
+ * \see \ref sec_design_float_storage
+ */
+#ifdef MEGAFAUNA_FLOAT_STORAGE
+typedef float StorageReal;
+#else
+typedef double StorageReal;
+#endif
+
+}  // namespace Fauna
+
+#endif  // FAUNA_STORAGE_REAL_H
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Work and waiting time of one thread of the scheduler.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_THREAD_STATISTICS_H
+#define FAUNA_THREAD_STATISTICS_H
+
+namespace Fauna {
+
+/// Counters of one thread of the \ref WorkStealingScheduler.
+/**
+ * Use these to tune the number of chunks per thread: Much idle time with
+ * few stolen chunks means that the chunks are too coarse. Many stolen chunks
+ * with little idle time are fine because stealing balances the load. Very
+ * many chunks with little work each mean that they are too fine.
+ * \see \ref World::enable_threads()
+ * \see \ref sec_design_work_stealing
+ */
+struct ThreadStatistics {
+  /// Number of parallel runs the thread has taken part in.
+  long long runs = 0;
+
+  /// Number of tasks (simulation units) the thread has executed.
+  long long tasks = 0;
+
+  /// Number of chunks of tasks the thread has executed.
+  long long chunks = 0;
+
+  /// Part of \ref chunks that the thread took from another thread’s queue.
+  long long stolen_chunks = 0;
+
+  /// Number of tasks in the \ref stolen_chunks.
+  long long stolen_tasks = 0;
+
+  /// Time spent executing tasks [s].
+  double busy_seconds = 0.0;
+
+  /// Time between running out of work and the end of each run [s].
+  /** The thread is waiting for the other threads during this time. */
+  double idle_seconds = 0.0;
+
+  /// Add the counters of another thread.
+  ThreadStatistics& operator+=(const ThreadStatistics& other) {
+    runs += other.runs;
+    tasks += other.tasks;
+    chunks += other.chunks;
+    stolen_chunks += other.stolen_chunks;
+    stolen_tasks += other.stolen_tasks;
+    busy_seconds += other.busy_seconds;
+    idle_seconds += other.idle_seconds;
+    return *this;
+  }
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_THREAD_STATISTICS_H
@@ -11,17 +11,33 @@
 #ifndef FAUNA_WORLD_H
 #define FAUNA_WORLD_H
 
+#include <cstddef>
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
+#include <ostream>
+#include <string>
 #include <vector>
 
+#include "Fauna/thread_statistics.h"
+
 namespace Fauna {
 // Forward declarations
+class BatchHabitat;
+struct BatchForcing;
 class Date;
+class FeedHerbivores;
 class Habitat;
 class Hft;
+struct MemoryUsage;
 struct Parameters;
+struct PoolStatistics;
+struct Profile;
 class SimulationUnit;
+class TaskQueue;
+class Tracer;
+class WorkStealingScheduler;
 class WorldConstructor;
 
 // Repeat typedef from hft.h
@@ -29,6 +45,9 @@ typedef std::vector<std::shared_ptr<const Hft> > HftList;
 
 namespace Output {
 class Aggregator;
+struct CombinedData;
+struct Datapoint;
+class MemoryWriter;
 class WriterInterface;
 }  // namespace Output
 
@@ -42,6 +61,13 @@ enum class SimMode {
 };
 
 /// Central class to construct and own megafauna habitats and populations.
+/**
+ * Different \ref World objects can be used concurrently in different threads
+ * because they share no mutable state. One object must not be used by two
+ * threads at the same time. With \ref enable_threads(), one object
+ * simulates its simulation units in several threads itself.
+ * \see \ref sec_design_thread_safety
+ */
 class World {
  public:
   /// Constructor: Read parameters and HFTs from instruction file.
@@ -50,12 +76,17 @@ class World {
    * model. It contains global settings and herbivore parameters.
    * \param mode Whether we are only checking the instruction file or running a
    * simulation. If set to \ref SimMode::Lint, no files will be created.
+   * \param cache_filename If not empty, the parsed instruction file is
+   * loaded from this binary cache file if it matches the content of the
+   * instruction file. Otherwise the instruction file is parsed and the cache
+   * is written. \see \ref sec_design_insfile_cache
    *
    * \throw std::logic_error If a selected instruction file parameter is not
    * implemented.
    */
   World(const std::string instruction_filename,
-        const SimMode mode = SimMode::Simulate);
+        const SimMode mode = SimMode::Simulate,
+        const std::string cache_filename = "");
 
   /// Constructor for unit tests
   /**
@@ -81,7 +112,12 @@ class World {
    */
   World();
 
-  /// Default destructor.
+  /// Destructor: Write all remaining output and the trace file.
+  /**
+   * If writing the output fails, the error is printed to STDERR because a
+   * destructor must not throw. Call \ref flush_output() and
+   * \ref write_trace() beforehand to handle errors yourself.
+   */
   ~World();
 
   /// Compose a new simulation from an external habitat and new populations.
@@ -101,6 +137,227 @@ class World {
    */
   void create_simulation_unit(std::shared_ptr<Habitat> habitat);
 
+  /// Create a simulation unit whose habitat is forced with arrays.
+  /**
+   * Instead of implementing \ref Habitat, the host program passes today’s
+   * forage and environment of all these simulation units at once to
+   * \ref simulate_day(const Date&, const BatchForcing&, const
+   * SimDayOptions&). Batch simulation units and those created with
+   * \ref create_simulation_unit() can be mixed.
+   *
+   * \param aggregation_unit \copybrief Habitat::get_aggregation_unit()
+   * \return The index of this habitat in the arrays of \ref BatchForcing.
+   * Indices count up from zero in the order of creation and are never
+   * reused.
+   * \see \ref sec_design_batch_forcing
+   */
+  int create_batch_simulation_unit(const std::string& aggregation_unit);
+
+  /// Start tracking whether the herbivore populations have stabilized.
+  /**
+   * This is meant for the spin-up phase of a simulation, when the same
+   * climate is repeated until the populations are in equilibrium. For each
+   * simulation unit, the annual mean individual and mass density of each HFT
+   * is compared with the previous year. A simulation unit has converged if
+   * the relative change has been below `tolerance` for `years` consecutive
+   * complete years.
+   *
+   * Query the state with \ref is_equilibrium_reached() and
+   * \ref is_converged(). With \ref SimDayOptions::skip_converged, the
+   * herbivores in converged simulation units are not simulated anymore.
+   *
+   * Calling this again changes the criteria, but keeps the data collected so
+   * far.
+   *
+   * \param tolerance Maximum relative change of densities between two years,
+   * for instance 0.01 for one percent.
+   * \param years Number of consecutive years that need to be below
+   * `tolerance`.
+   * \throw std::invalid_argument If `tolerance` is negative or not finite, or
+   * if `years < 1`.
+   */
+  void enable_equilibrium_monitor(const double tolerance, const int years = 1);
+
+  /// Start measuring the run time of the simulation phases.
+  /**
+   * Afterwards, \ref simulate_day() adds the time of each \ref ProfilePhase
+   * and counts simulated herbivores and feeding iterations. The
+   * measurements accumulate until \ref reset_profile() is called.
+   *
+   * Profiling only adds the cost of reading a clock a few times per
+   * simulation unit and day. When it is disabled, there is no measurable
+   * overhead.
+   *
+   * Calling this again keeps the measurements, but replaces `dump`.
+   *
+   * \param dump If not NULL, the profile is printed to this stream
+   * (\ref Profile::print()) every time output is written, i.e. at the end
+   * of each output interval. The stream must stay valid as long as this
+   * object simulates.
+   */
+  void enable_profiling(std::ostream* dump = NULL);
+
+  /// Simulate the simulation units in several threads.
+  /**
+   * Afterwards, \ref simulate_day() and \ref simulate_days() distribute
+   * the simulation units over `threads` threads, including the calling
+   * thread. A \ref WorkStealingScheduler orders them by their estimated cost,
+   * which is the number of herbivore objects (cohorts) of all HFTs at the
+   * beginning of the day. Threads that run out of work take over simulation
+   * units from the others. The output is aggregated in the original order
+   * afterwards, so the results are identical to a serial simulation.
+   * \ref submit_day() is not affected.
+   *
+   * The \ref Habitat objects of different simulation units are then called
+   * from different threads at the same time. So the host program must make
+   * sure that they don’t share mutable state.
+   *
+   * Calling this again replaces the threads and resets the statistics.
+   *
+   * \param threads Number of threads. With one thread, the simulation
+   * units are simulated in the calling thread, as without this call, but
+   * the statistics are recorded.
+   * \param chunks_per_thread The simulation units are grouped into about
+   * this many chunks of equal estimated cost per thread. More chunks balance
+   * the load better, but cost more synchronization.
+   * \throw std::invalid_argument If a parameter is smaller than 1. The
+   * previous threads and statistics are then kept.
+   * \see \ref get_thread_statistics()
+   * \see \ref sec_design_work_stealing
+   */
+  void enable_threads(const int threads, const int chunks_per_thread = 4);
+
+  /// Record a timeline of the simulation phases in each simulation unit.
+  /**
+   * Each call of \ref simulate_day() then records when each phase begins and
+   * ends, for every simulation unit and in every thread. This includes the
+   * calls of the virtual \ref Habitat functions implemented by the host
+   * program. The timeline is written as Chrome trace JSON, which can be
+   * viewed in `chrome://tracing` or <https://ui.perfetto.dev>, to find
+   * simulation units that take unusually long.
+   *
+   * All events are kept in memory until the file is written by
+   * \ref write_trace() or by the destructor. So enable tracing only for a
+   * limited number of simulation days.
+   *
+   * \param filename Path of the JSON file to write.
+   * \throw std::logic_error If tracing has already been enabled.
+   */
+  void enable_tracing(const std::string& filename);
+
+  /// Block until all output data has been written.
+  /**
+   * This is only relevant if output is written in a background thread
+   * (\ref Parameters::output_async). Otherwise all output is already written
+   * when \ref simulate_day() returns.
+   * \throw std::exception Any error from writing the output.
+   */
+  void flush_output();
+
+  /// Restore the herbivores and output aggregation from a checkpoint file.
+  /**
+   * Use this to continue a simulation that has been saved with
+   * \ref save_checkpoint(). The host program must have recreated the
+   * habitats with \ref create_simulation_unit() in the same order and with
+   * the same aggregation units as at the time of saving. Each
+   * \ref SimulationUnit then gets back its herbivores. The next call of
+   * \ref simulate_day() must pass the day after the last simulated day.
+   *
+   * The file is read completely into memory at once. If loading fails, this
+   * object remains unchanged.
+   *
+   * \param filename Path to a file created by \ref save_checkpoint().
+   * \throw std::runtime_error If the file cannot be read, is corrupt, was
+   * written by another version of the checkpoint format, or if the HFTs or
+   * simulation units don’t match.
+   * \throw std::logic_error If not in \ref SimMode::Simulate.
+   */
+  void load_checkpoint(const std::string& filename);
+
+  /// Set all timers and counters of the profile to zero.
+  /**
+   * \throw std::logic_error If \ref enable_profiling() hasn’t been called.
+   */
+  void reset_profile();
+
+  /// Get all output datapoints that have been completed since the last call.
+  /**
+   * This is the “pull” interface for \ref OutputFormat::InMemory: The
+   * datapoints are collected in memory until the host program takes them.
+   * \return The datapoints in the order they were completed. The vector is
+   * empty if a callback has been set with \ref set_output_callback().
+   * \throw std::logic_error If \ref Parameters::output_format is not
+   * \ref OutputFormat::InMemory or if not in \ref SimMode::Simulate.
+   */
+  std::vector<Output::Datapoint> retrieve_output();
+
+  /// Save the complete state of all herbivores to a binary file.
+  /**
+   * The checkpoint contains all herbivore populations of all simulation
+   * units, the output data aggregated in the current output interval, the
+   * last simulation date, and the establishment cycle.
+   *
+   * Not included are the habitats, which belong to the host program, and
+   * output that has already been passed to the output writer. Call
+   * \ref flush_output() before to make sure that output files are complete.
+   *
+   * The binary format depends on the platform (byte order, floating point
+   * representation) and on the list of HFTs. The file is meant for restarting
+   * a simulation on the same system, not for archiving.
+   *
+   * \param filename Path to the checkpoint file. An existing file will be
+   * overwritten.
+   * \throw std::runtime_error If the file cannot be written.
+   * \throw std::logic_error If not in \ref SimMode::Simulate or if a
+   * population class doesn’t support checkpoints.
+   */
+  void save_checkpoint(const std::string& filename) const;
+
+  /// Write the timeline of simulation phases and stop tracing.
+  /**
+   * This does nothing if tracing is not enabled. Otherwise, the trace file
+   * is written and all recorded events are released.
+   * \throw std::runtime_error If the trace file cannot be written.
+   * \see \ref enable_tracing()
+   */
+  void write_trace();
+
+  /// Let a function receive each output datapoint when it is complete.
+  /**
+   * This is the “push” interface for \ref OutputFormat::InMemory. The
+   * callback is called from within \ref simulate_day(). The datapoint is
+   * passed by reference and is only valid during the call.
+   * \param callback The function to call. Pass an empty function object to
+   * collect the datapoints again for \ref retrieve_output().
+   * \throw std::logic_error If \ref Parameters::output_format is not
+   * \ref OutputFormat::InMemory or if not in \ref SimMode::Simulate.
+   */
+  void set_output_callback(
+      std::function<void(const Output::Datapoint&)> callback);
+
+  /// Number of simulation units whose herbivore populations have converged.
+  /**
+   * \throw std::logic_error If \ref enable_equilibrium_monitor() hasn’t been
+   * called.
+   * \see \ref enable_equilibrium_monitor()
+   */
+  std::size_t get_converged_count() const;
+
+  /// Counters of each thread since \ref enable_threads() was called.
+  /**
+   * Use them to tune `chunks_per_thread` of \ref enable_threads().
+   * \return One element for each thread. The first one is the calling
+   * thread.
+   * \throw std::logic_error If \ref enable_threads() hasn’t been called.
+   */
+  std::vector<ThreadStatistics> get_thread_statistics() const;
+
+  /// The run-time measurements since profiling was enabled or reset.
+  /**
+   * \throw std::logic_error If \ref enable_profiling() hasn’t been called.
+   */
+  const Profile& get_profile() const;
+
   /// Get global simulation parameters.
   /**
    * The global megafauna parameters are public because they might be required
@@ -111,6 +368,34 @@ class World {
    */
   const Parameters& get_params() const;
 
+  /// Estimate how much memory this object holds.
+  /**
+   * Use this to extrapolate the memory requirements of a large simulation
+   * from a small one. The habitats of the host program are not included.
+   * Don’t call this while a day from \ref submit_day() is still running.
+   * \see \ref sec_design_memory_usage
+   */
+  MemoryUsage get_memory_usage() const;
+
+  /// Memory held for herbivores in all simulation units.
+  /**
+   * The statistics of the \ref NodePool of every population are summed up.
+   * Don’t call this while a day from \ref submit_day() is still running.
+   * \see \ref sec_design_node_pools
+   */
+  PoolStatistics get_pool_statistics() const;
+
+  /// Warnings from reading the instruction file.
+  /**
+   * Parameters that are valid, but probably not what the user intended,
+   * are reported here. The library doesn’t print the warnings; the host
+   * program should show them to the user.
+   * \return Human-readable lines of text, or an empty string if there were
+   * no warnings or if the \ref World object was not created from an
+   * instruction file.
+   */
+  const std::string& get_warnings() const { return insfile.warnings; }
+
   /// List of all the simulation units in the world.
   /**
    * This is read-only. Unit tests can use it to check if
@@ -118,9 +403,46 @@ class World {
    */
   const std::list<SimulationUnit>& get_sim_units() const { return sim_units; }
 
+  /// Number of habitats created with \ref create_batch_simulation_unit().
+  /**
+   * This includes killed habitats, so it is the minimum length of the arrays
+   * in \ref BatchForcing.
+   */
+  int get_batch_habitat_count() const { return batch_habitats.size(); }
+
   /// Whether this \ref World object is in \ref SimMode::Simulate mode.
   const bool is_activated() const { return mode == SimMode::Simulate; }
 
+  /// Whether the herbivores in the habitat have reached an equilibrium.
+  /**
+   * \param habitat A habitat that has been passed to
+   * \ref create_simulation_unit().
+   * \throw std::invalid_argument If the habitat is not found.
+   * \throw std::logic_error If \ref enable_equilibrium_monitor() hasn’t been
+   * called.
+   * \see \ref enable_equilibrium_monitor()
+   */
+  bool is_converged(const Habitat& habitat) const;
+
+  /// Whether the herbivores in all simulation units have converged.
+  /**
+   * The spin-up phase can be stopped when this becomes true.
+   * \return False if there are no simulation units.
+   * \throw std::logic_error If \ref enable_equilibrium_monitor() hasn’t been
+   * called.
+   * \see \ref enable_equilibrium_monitor()
+   */
+  bool is_equilibrium_reached() const;
+
+  /// Mark a habitat created by \ref create_batch_simulation_unit() as dead.
+  /**
+   * Its simulation unit is released in the next call of \ref simulate_day().
+   * The index is not reused.
+   * \throw std::out_of_range If there is no batch habitat with that index.
+   * \see \ref Habitat::kill()
+   */
+  void kill_batch_simulation_unit(const int index);
+
   /// Options passed to \ref simulate_day()
   struct SimDayOptions {
     /// Constructor
@@ -143,6 +465,22 @@ class World {
      * dead habitats will automatically be cleared.
      */
     bool reset_date = false;
+
+    /// Whether to skip herbivore simulation in converged simulation units.
+    /**
+     * Use this in the spin-up phase to fast-forward simulation units whose
+     * herbivore populations have already reached an equilibrium, while the
+     * others continue. The herbivores in converged simulation units are
+     * frozen in their current state; the habitats are still updated and
+     * the output is still produced. Simulation units without herbivores are
+     * never skipped, so that they are re-established according to
+     * \ref Parameters::herbivore_establish_interval.
+     *
+     * This has no effect if \ref enable_equilibrium_monitor() hasn’t been
+     * called.
+     * \see \ref is_converged()
+     */
+    bool skip_converged = false;
   };
 
   /// Iterate through all simulation units and perform simulation for this day.
@@ -159,6 +497,9 @@ class World {
    * \param date The current simulation day.
    * \param opts Options for today’s simulation.
    *
+   * \throw std::exception If writing output in the background
+   * (\ref Parameters::output_async) has failed since the last call.
+   *
    * \throw std::invalid_argument If `date` has not been correctly incremented
    * by one day since the last call. However, no exception will be thrown if
    * \ref SimDayOptions::reset_date is `true`.
@@ -177,6 +518,101 @@ class World {
   void simulate_day(const Date& date,
                     const SimDayOptions& opts = SimDayOptions());
 
+  /// Simulate one day with forcing arrays for all batch habitats.
+  /**
+   * This is the array-based alternative to implementing \ref Habitat. All
+   * simulation units are simulated as in
+   * \ref simulate_day(const Date&, const SimDayOptions&). The habitats
+   * created with \ref create_batch_simulation_unit() read their forage and
+   * environment from `forcing`, and the eaten grass is written to
+   * \ref BatchForcing::eaten_grass.
+   *
+   * \param date The current simulation day.
+   * \param forcing Arrays with at least \ref get_batch_habitat_count()
+   * elements each.
+   * \param opts Options for today’s simulation.
+   * \throw std::invalid_argument If one of the arrays in `forcing` is NULL
+   * while there are batch habitats.
+   * \throw std::exception The same as
+   * \ref simulate_day(const Date&, const SimDayOptions&), and if forcing
+   * values are out of range.
+   * \see \ref sec_design_batch_forcing
+   */
+  void simulate_day(const Date& date, const BatchForcing& forcing,
+                    const SimDayOptions& opts = SimDayOptions());
+
+  /// Simulate a range of days at once.
+  /**
+   * This has the same effect as calling
+   * \ref simulate_day(const Date&, const SimDayOptions&) for every day from
+   * `first` to `last`, and the output is identical. Use it if the habitats
+   * can provide their forcing without the host program intervening between
+   * the days, for instance in offline simulations.
+   *
+   * Each simulation unit is simulated for several days in a row, so its
+   * herbivores stay in the CPU cache. The output of the simulation units
+   * is kept in memory and aggregated day by day in the usual order. To limit
+   * memory, long ranges with many simulation units are divided into
+   * blocks of days.
+   *
+   * Habitats must not be killed during the call.
+   *
+   * \param first The first simulation day.
+   * \param last The last simulation day. It may be in another year than
+   * `first`. Years have 365 days (\ref Date::get_next()).
+   * \param opts Options for all days. \ref SimDayOptions::reset_date only
+   * applies to `first`.
+   * \throw std::invalid_argument If `last` is before `first`.
+   * \throw std::exception The same as
+   * \ref simulate_day(const Date&, const SimDayOptions&).
+   */
+  void simulate_days(const Date& first, const Date& last,
+                     const SimDayOptions& opts = SimDayOptions());
+
+  /// Simulate some simulation units in the background.
+  /**
+   * This is the asynchronous alternative to
+   * \ref simulate_day(const Date&, const SimDayOptions&). The host program
+   * can submit the simulation units of some aggregation units as soon as
+   * their habitats are ready for `date`, and continue with its own work,
+   * for instance the vegetation of other grid cells. The submitted
+   * simulation units are simulated in a background thread, one submission
+   * after the other.
+   *
+   * The day is complete when all simulation units have been submitted and
+   * simulated. Then the output is aggregated in the same order as in
+   * \ref simulate_day(), so the results are identical.
+   *
+   * Submitting the first simulation units of the next day or calling
+   * \ref simulate_day() blocks until the previous day is complete. Until
+   * then, the host program must not call other functions of this object nor
+   * change its submitted habitats.
+   *
+   * \param date The current simulation day. All calls for one day must pass
+   * the same date.
+   * \param aggregation_units Submit the simulation units of these
+   * aggregation units (\ref Habitat::get_aggregation_unit()). If empty, all
+   * remaining simulation units of the day are submitted.
+   * \param opts Options for today’s simulation. Only the options of the
+   * first call for a day are used.
+   * \return Handle that becomes ready when the submitted simulation units
+   * are simulated. It rethrows any exception from the simulation. After an
+   * exception, the day cannot be completed.
+   * \throw std::invalid_argument If an aggregation unit has no simulation
+   * units that haven’t been submitted yet for this day.
+   * \throw std::logic_error If `date` is a new day, but not all simulation
+   * units of the previous day have been submitted.
+   * \throw std::exception The same as
+   * \ref simulate_day(const Date&, const SimDayOptions&) when starting a
+   * new day.
+   * \see \ref sec_design_submit_day
+   */
+  std::shared_future<void> submit_day(
+      const Date& date,
+      const std::vector<std::string>& aggregation_units =
+          std::vector<std::string>(),
+      const SimDayOptions& opts = SimDayOptions());
+
   /// \copybrief simulate_day(const Date&, const SimDayOptions&)
   /**
    * \param date The current simulation day.
@@ -190,6 +626,87 @@ class World {
   }
 
  private:
+  /// Simulation units and what to do with them on one day.
+  struct DayPlan;
+
+  /// Check that `date` may be simulated next and check the habitat counts.
+  /**
+   * This also resets the date and the equilibrium monitors if requested.
+   * \throw std::exception The same as \ref simulate_day().
+   */
+  void check_date(const Date& date, const SimDayOptions& opts);
+
+  /// Create a function object to feed the herbivores.
+  std::shared_ptr<const FeedHerbivores> create_feed_herbivores();
+
+  /// Advance the establishment cycle and list the simulation units.
+  /**
+   * Dead simulation units are removed here.
+   * \param date The simulation day, which must have been checked with
+   * \ref check_date().
+   * \param opts Options for the simulation day.
+   * \param feed_herbivores Function object to feed the herbivores with.
+   */
+  std::unique_ptr<DayPlan> plan_day(
+      const Date& date, const SimDayOptions& opts,
+      const std::shared_ptr<const FeedHerbivores> feed_herbivores);
+
+  /// Simulate one simulation unit of the plan and get its output.
+  /**
+   * \param plan The plan of the day.
+   * \param unit_index Index of the task in \ref DayPlan::tasks.
+   * \param unit_profile Where to add the run-time measurements, or NULL.
+   * \param feed_herbivores Function object to feed the herbivores with. It
+   * must measure into `unit_profile`.
+   */
+  Output::CombinedData simulate_unit(const DayPlan& plan,
+                                     const int unit_index,
+                                     Profile* unit_profile,
+                                     const FeedHerbivores& feed_herbivores);
+
+  /// Function to simulate one task of \ref simulate_units().
+  /**
+   * The parameters are the index of the task, the profile to measure into
+   * (possibly NULL), and a function object to feed the herbivores.
+   */
+  typedef std::function<void(const int, Profile*, const FeedHerbivores&)>
+      UnitFunction;
+
+  /// Call a function for each task, in parallel if threads are enabled.
+  /**
+   * Without \ref scheduler, the tasks are simulated in order in the calling
+   * thread. Otherwise, each thread gets its own profile and function object
+   * for feeding, and the profiles are added to \ref profile at the end.
+   * \param costs Estimated cost of each task.
+   * \param feed_herbivores Function object for the calling thread without
+   * \ref scheduler.
+   * \param function Called once for each task.
+   */
+  void simulate_units(const std::vector<double>& costs,
+                      const FeedHerbivores& feed_herbivores,
+                      const UnitFunction& function);
+
+  /// Add the output of one simulation unit of the plan to the aggregator.
+  void aggregate_output(const DayPlan& plan, const int unit_index,
+                        const Output::CombinedData& output);
+
+  /// Write output if the output interval is complete and remember the date.
+  void end_day(const DayPlan& plan);
+
+  /// Block until the day started by \ref submit_day() is complete.
+  /**
+   * \param caller Name of the calling function for the error message.
+   * \throw std::logic_error If not all simulation units have been submitted.
+   */
+  void wait_for_submitted_day(const std::string& caller);
+
+  /// The day started by \ref submit_day(), or NULL.
+  std::unique_ptr<DayPlan> submitted_day;
+
+  /// Runs the tasks of \ref submit_day() one at a time, or NULL.
+  /** It is created on the first call of \ref submit_day(). */
+  std::unique_ptr<TaskQueue> submit_queue;
+
   /// Get the number of habitats per aggregation unit.
   /**
    * \throw std::logic_error If the number of habitats differs between
@@ -203,15 +720,53 @@ class World {
 
   /// Create \ref Output::WriterInterface implementation according to params.
   /**
+   * This also sets \ref memory_writer.
    * \throw std::logic_error If \ref Parameters::output_format is not
    * implemented.
    * \see \ref output_writer
    */
-  Output::WriterInterface* construct_output_writer() const;
+  Output::WriterInterface* construct_output_writer();
+
+  /// Get the output writer for \ref OutputFormat::InMemory.
+  /**
+   * \throw std::logic_error If the output format is not
+   * \ref OutputFormat::InMemory.
+   */
+  Output::MemoryWriter& get_memory_writer();
 
   /// Whether this object is going to simulate or just lint an instruction file.
   const SimMode mode = SimMode::Simulate;
 
+  /// Throw an exception if the equilibrium monitor is not enabled.
+  void check_equilibrium_monitor(const std::string& caller) const;
+
+  /// Maximum relative change for the equilibrium monitor.
+  /** A negative value means that the monitor is disabled. */
+  double equilibrium_tolerance = -1.0;
+
+  /// Consecutive years below \ref equilibrium_tolerance for convergence.
+  int equilibrium_years = 1;
+
+  /// Habitats created by \ref create_batch_simulation_unit(), by index.
+  /**
+   * They are also owned by their simulation units, which are released when
+   * the habitat is killed.
+   */
+  std::vector<std::shared_ptr<BatchHabitat> > batch_habitats;
+
+  /// Run-time measurements, or NULL if profiling is disabled.
+  std::unique_ptr<Profile> profile;
+
+  /// Stream to print \ref profile to whenever output is written.
+  std::ostream* profile_dump = NULL;
+
+  /// Timeline of simulation phases, or NULL if tracing is disabled.
+  std::unique_ptr<Tracer> tracer;
+
+  /// Threads to simulate the simulation units, or NULL if disabled.
+  /** \see \ref enable_threads() */
+  std::unique_ptr<WorkStealingScheduler> scheduler;
+
   /// Whether the habitat counts per aggregation unit have been checked.
   /**
    * By setting this variable, we don’t need to check on every call of
@@ -236,6 +791,8 @@ class World {
     const std::shared_ptr<const HftList> hftlist;
     /// Global, immutable set of simulation parameters.
     const std::shared_ptr<const Parameters> params;
+    /// Warnings from reading the instruction file.
+    const std::string warnings;
   } insfile;
 
   /// Number of days since extinct populations were re-established.
@@ -251,11 +808,23 @@ class World {
   /// Collects output data per time interval and aggregation unit.
   const std::unique_ptr<Output::Aggregator> output_aggregator;
 
+  /// Non-owning pointer to \ref output_writer if it is in-memory output.
+  /**
+   * This must be declared before \ref output_writer because it is set in
+   * \ref construct_output_writer().
+   */
+  Output::MemoryWriter* memory_writer = NULL;
+
   /// Output writer as selected by \ref Parameters::output_format.
   std::unique_ptr<Output::WriterInterface> output_writer;
 
   /// Helper function to initialize World::InsfileContent object.
-  static InsfileContent read_instruction_file(const std::string& filename);
+  /**
+   * \param filename Path to the instruction file.
+   * \param cache_filename Path to the binary cache or empty to always parse.
+   */
+  static InsfileContent read_instruction_file(
+      const std::string& filename, const std::string& cache_filename);
 
   /// List of all the simulation units in the world.
   /**
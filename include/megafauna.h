@@ -11,11 +11,18 @@
 #ifndef MODULAR_MEGAFAUNA_LIBRARY_H
 #define MODULAR_MEGAFAUNA_LIBRARY_H
 
+#include "Fauna/Output/datapoint.h"
+#include "Fauna/batch_forcing.h"
 #include "Fauna/date.h"
 #include "Fauna/forage_types.h"
 #include "Fauna/forage_values.h"
+#include "Fauna/forcing_trace.h"
 #include "Fauna/habitat.h"
 #include "Fauna/habitat_forage.h"
+#include "Fauna/lint.h"
+#include "Fauna/memory_usage.h"
+#include "Fauna/pool_statistics.h"
+#include "Fauna/profile.h"
 #include "Fauna/world.h"
 
 #endif  // MODULAR_MEGAFAUNA_LIBRARY_H
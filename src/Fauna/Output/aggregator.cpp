@@ -10,8 +10,12 @@
  */
 #include "aggregator.h"
 
+#include <cstdint>
+
+#include "checkpoint.h"
 #include "date.h"
 #include "habitat.h"
+#include "heap_bytes.h"
 #include "herbivore_interface.h"
 #include "population_list.h"
 #include "simulation_unit.h"
@@ -51,9 +55,28 @@ const DateInterval& Aggregator::get_interval() const {
   return interval;
 }
 
+std::size_t Aggregator::get_memory_usage() const {
+  return sizeof(*this) + get_heap_bytes(datapoints);
+}
+
+void Aggregator::load_state(CheckpointReader& in) {
+  std::uint64_t size;
+  in.read(size);
+  datapoints.clear();
+  datapoints.resize(size);
+  for (auto& datapoint : datapoints) in.read(datapoint);
+  in.read(interval);
+}
+
 std::vector<Datapoint> Aggregator::retrieve() {
   for (auto& i : datapoints) i.interval = interval;
   std::vector<Datapoint> result;  // Create empty vector.
   std::swap(result, datapoints);  // Use efficient move semantics.
   return result;
 }
+
+void Aggregator::save_state(CheckpointWriter& out) const {
+  out.write((std::uint64_t)datapoints.size());
+  for (const auto& datapoint : datapoints) out.write(datapoint);
+  out.write(interval);
+}
@@ -15,6 +15,8 @@
 
 namespace Fauna {
 // Forward Declarations
+class CheckpointReader;
+class CheckpointWriter;
 class Date;
 
 namespace Output {
@@ -47,6 +49,13 @@ class Aggregator {
    */
   const DateInterval& get_interval() const;
 
+  /// Estimated memory of the data being aggregated [bytes].
+  std::size_t get_memory_usage() const;
+
+  /// Restore data that has been added, but not yet retrieved.
+  /** \throw std::runtime_error If the checkpoint data is corrupt. */
+  void load_state(CheckpointReader& in);
+
   /// Get the aggregated data and reset object state.
   /**
    * \return The aggregated data as one datapoint per aggregation unit. All
@@ -55,6 +64,9 @@ class Aggregator {
    */
   std::vector<Datapoint> retrieve();
 
+  /// Append data that has been added, but not yet retrieved, to a checkpoint.
+  void save_state(CheckpointWriter& out) const;
+
  private:
   /// Find the datapoint for a given aggregation unit (create it if missing).
   Datapoint& get_datapoint(const std::string& agg_unit);
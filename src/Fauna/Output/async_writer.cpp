@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Output writer that delegates writing to a background thread.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "async_writer.h"
+
+#include <stdexcept>
+
+#include "heap_bytes.h"
+
+using namespace Fauna;
+using namespace Fauna::Output;
+
+AsyncWriter::AsyncWriter(WriterInterface* writer, const int queue_size)
+    : writer(writer), queue_size(queue_size) {
+  if (writer == NULL)
+    throw std::invalid_argument(
+        "Fauna::Output::AsyncWriter::AsyncWriter() "
+        "Parameter `writer` is NULL.");
+  if (queue_size < 1)
+    throw std::invalid_argument(
+        "Fauna::Output::AsyncWriter::AsyncWriter() "
+        "Parameter `queue_size` must be at least 1.");
+  writer_bytes = writer->get_buffer_bytes();
+  thread = std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  queue_filled.notify_one();
+  if (thread.joinable()) thread.join();
+}
+
+void AsyncWriter::check_errors() {
+  std::lock_guard<std::mutex> lock(mutex);
+  rethrow_error();
+}
+
+void AsyncWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  queue_drained.wait(lock, [this] { return queue.empty() && !busy; });
+  rethrow_error();
+  // The writer thread is idle and cannot take a new datapoint while the
+  // mutex is locked, so the wrapped writer can be called from here.
+  writer->flush();
+  writer_bytes = writer->get_buffer_bytes();
+}
+
+void AsyncWriter::rethrow_error() {
+  if (error) {
+    std::exception_ptr e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+void AsyncWriter::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    queue_filled.wait(lock, [this] { return stop || !queue.empty(); });
+    // When asked to stop, finish the queue first.
+    if (queue.empty()) return;
+
+    Datapoint datapoint = std::move(queue.front());
+    queue.pop_front();
+    busy = true;
+    // A caller might be waiting for space in the queue.
+    queue_drained.notify_all();
+
+    lock.unlock();
+    std::exception_ptr new_error;
+    try {
+      writer->write_datapoint(datapoint);
+    } catch (...) {
+      new_error = std::current_exception();
+    }
+    const std::size_t new_writer_bytes = writer->get_buffer_bytes();
+    lock.lock();
+
+    busy = false;
+    writer_bytes = new_writer_bytes;
+    if (new_error) {
+      // The output is broken now. Don’t write anything more until the error
+      // has been reported.
+      if (!error) error = new_error;
+      queue.clear();
+    }
+    queue_drained.notify_all();
+  }
+}
+
+std::size_t AsyncWriter::get_buffer_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return get_heap_bytes(queue) + writer_bytes;
+}
+
+void AsyncWriter::take_datapoint(Datapoint&& datapoint) {
+  std::unique_lock<std::mutex> lock(mutex);
+  rethrow_error();
+  // Back-pressure: wait until the writer thread has made space.
+  queue_drained.wait(lock, [this] {
+    return (int)queue.size() < queue_size || error;
+  });
+  rethrow_error();
+  queue.push_back(std::move(datapoint));
+  lock.unlock();
+  queue_filled.notify_one();
+}
+
+void AsyncWriter::write_datapoint(const Datapoint& datapoint) {
+  take_datapoint(Datapoint(datapoint));
+}
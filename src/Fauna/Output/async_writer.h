@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Output writer that delegates writing to a background thread.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_OUTPUT_ASYNC_WRITER_H
+#define FAUNA_OUTPUT_ASYNC_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "datapoint.h"
+#include "writer_interface.h"
+
+namespace Fauna {
+namespace Output {
+
+/// Writes datapoints with another output writer in a background thread.
+/**
+ * Datapoints passed to \ref write_datapoint() are copied into a bounded
+ * queue (or moved with \ref take_datapoint()). A dedicated writer thread
+ * takes them from the queue and hands them on to the wrapped
+ * \ref WriterInterface object. So the simulation doesn’t need to wait for
+ * disk I/O.
+ *
+ * **Back-pressure:** If the queue is full, \ref write_datapoint() blocks
+ * until the writer thread has taken an element. So the memory use is
+ * limited even if the writer cannot keep up with the simulation.
+ *
+ * **Error propagation:** If the wrapped writer throws an exception, the
+ * writer thread stores it and discards all datapoints that are still queued.
+ * The exception is rethrown in the calling thread on the next call of
+ * \ref write_datapoint(), \ref flush(), or \ref check_errors(). It is
+ * reported only once.
+ *
+ * The wrapped writer is never called from two threads at the same time.
+ * It doesn’t need to be thread-safe itself.
+ */
+class AsyncWriter : public WriterInterface {
+ public:
+  /// Constructor: Start the writer thread.
+  /**
+   * \param writer The output writer to delegate to. This object takes
+   * ownership of it.
+   * \param queue_size Maximum number of datapoints waiting to be written.
+   * \throw std::invalid_argument If `writer` is NULL.
+   * \throw std::invalid_argument If `queue_size` is smaller than 1.
+   */
+  AsyncWriter(WriterInterface* writer, const int queue_size);
+
+  /// Delete copy constructor because of the thread and pointer ownership.
+  AsyncWriter(AsyncWriter const&) = delete;
+
+  /// Delete copy assignment because of the thread and pointer ownership.
+  void operator=(AsyncWriter const&) = delete;
+
+  /// Destructor: Write all remaining datapoints and stop the writer thread.
+  /**
+   * Errors from the writer thread that have not been reported yet are
+   * silently dropped. Call \ref flush() beforehand to catch them.
+   */
+  virtual ~AsyncWriter();
+
+  /// Rethrow an error from the writer thread, if there is one.
+  virtual void check_errors();
+
+  /// Block until all queued datapoints have been written, then flush.
+  /**
+   * Once the queue is empty, the wrapped writer’s
+   * \ref WriterInterface::flush() is called.
+   * \throw The exception thrown by the wrapped writer, if any.
+   */
+  virtual void flush();
+
+  /// Estimated memory of the queued datapoints and of the wrapped writer.
+  virtual std::size_t get_buffer_bytes() const;
+
+  /// Put a copy of the datapoint into the queue.
+  /**
+   * If the queue is full, this blocks until there is space.
+   * \param datapoint The output data to write.
+   * \throw The exception that the wrapped writer had thrown in the writer
+   * thread for a previous datapoint.
+   */
+  virtual void write_datapoint(const Datapoint& datapoint);
+
+  /// Move the datapoint into the queue.
+  /** \copydetails write_datapoint() */
+  virtual void take_datapoint(Datapoint&& datapoint);
+
+ private:
+  /// Rethrow and clear \ref error. The mutex must be locked by the caller.
+  void rethrow_error();
+
+  /// Main function of the writer thread.
+  void run();
+
+  /// The output writer that does the actual work.
+  const std::unique_ptr<WriterInterface> writer;
+
+  /// Maximum length of \ref queue.
+  const int queue_size;
+
+  /// Datapoints waiting to be written.
+  std::deque<Datapoint> queue;
+
+  /// Whether the writer thread is currently writing a datapoint.
+  bool busy = false;
+
+  /// Buffer memory of the wrapped writer after its last use [bytes].
+  /**
+   * The writer thread updates this after each datapoint, so that
+   * \ref get_buffer_bytes() doesn’t need to call the wrapped writer while
+   * it might be writing.
+   */
+  std::size_t writer_bytes = 0;
+
+  /// Signal for the writer thread to finish.
+  bool stop = false;
+
+  /// Unreported exception from the writer thread.
+  std::exception_ptr error;
+
+  /// Guards all mutable member variables that are shared between threads.
+  mutable std::mutex mutex;
+
+  /// Notifies the writer thread that a datapoint is waiting or to stop.
+  std::condition_variable queue_filled;
+
+  /// Notifies waiting callers that space in the queue became available.
+  std::condition_variable queue_drained;
+
+  /// The writer thread.
+  /** This must be the last member so that it starts after all others have
+   * been initialized. */
+  std::thread thread;
+};
+
+}  // namespace Output
+}  // namespace Fauna
+
+#endif  // FAUNA_OUTPUT_ASYNC_WRITER_H
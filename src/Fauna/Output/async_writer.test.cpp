@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::Output::AsyncWriter.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "async_writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "catch.hpp"
+using namespace Fauna;
+using namespace Fauna::Output;
+
+namespace {
+/// Records the aggregation units of all datapoints it is given.
+class RecordingWriter : public WriterInterface {
+ public:
+  RecordingWriter(std::vector<std::string>& written) : written(written) {}
+
+  virtual void flush() { flushes++; }
+
+  /// One byte per written datapoint.
+  virtual std::size_t get_buffer_bytes() const { return written.size(); }
+
+  virtual void write_datapoint(const Datapoint& datapoint) {
+    started = true;
+    while (hold) std::this_thread::yield();
+    if (datapoint.aggregation_unit == "bad")
+      throw std::runtime_error("Cannot write bad datapoint.");
+    written.push_back(datapoint.aggregation_unit);
+  }
+
+  /// While true, the writer thread hangs in write_datapoint().
+  std::atomic<bool> hold{false};
+
+  /// Set to true as soon as write_datapoint() is called the first time.
+  std::atomic<bool> started{false};
+
+  /// Number of calls of flush().
+  int flushes = 0;
+
+ private:
+  std::vector<std::string>& written;
+};
+
+Datapoint create_datapoint(const std::string& agg_unit) {
+  Datapoint d;
+  d.aggregation_unit = agg_unit;
+  return d;
+}
+}  // namespace
+
+TEST_CASE("Fauna::Output::AsyncWriter", "") {
+  std::vector<std::string> written;
+
+  CHECK_THROWS(AsyncWriter(NULL, 1));
+  CHECK_THROWS(AsyncWriter(new RecordingWriter(written), 0));
+  CHECK_THROWS(AsyncWriter(new RecordingWriter(written), -1));
+
+  SECTION("Datapoints are written in order") {
+    AsyncWriter writer(new RecordingWriter(written), 2);
+    for (int i = 0; i < 100; i++)
+      writer.write_datapoint(create_datapoint(std::to_string(i)));
+    writer.flush();
+    REQUIRE(written.size() == 100);
+    for (int i = 0; i < 100; i++) CHECK(written[i] == std::to_string(i));
+  }
+
+  SECTION("Flush and buffer size of the wrapped writer") {
+    RecordingWriter* recorder = new RecordingWriter(written);
+    recorder->hold = true;
+    AsyncWriter writer(recorder, 10);
+    CHECK(writer.get_buffer_bytes() == 0);
+
+    // While the wrapped writer is busy, only the queue is counted.
+    writer.write_datapoint(create_datapoint("1"));
+    while (!recorder->started) std::this_thread::yield();
+    writer.write_datapoint(create_datapoint("2"));
+    CHECK(writer.get_buffer_bytes() > 0);
+
+    recorder->hold = false;
+    writer.flush();
+    CHECK(recorder->flushes == 1);
+    CHECK(writer.get_buffer_bytes() == 2);
+  }
+
+  SECTION("Destructor writes remaining datapoints") {
+    {
+      AsyncWriter writer(new RecordingWriter(written), 10);
+      for (int i = 0; i < 10; i++)
+        writer.write_datapoint(create_datapoint("unit"));
+    }
+    CHECK(written.size() == 10);
+  }
+
+  SECTION("Errors are reported once in the calling thread") {
+    AsyncWriter writer(new RecordingWriter(written), 10);
+    writer.write_datapoint(create_datapoint("good"));
+    writer.write_datapoint(create_datapoint("bad"));
+    CHECK_THROWS_AS(writer.flush(), std::runtime_error);
+    CHECK_NOTHROW(writer.check_errors());
+    CHECK_NOTHROW(writer.flush());
+    REQUIRE(written.size() == 1);
+    CHECK(written.front() == "good");
+
+    // After the error has been reported, writing continues.
+    writer.write_datapoint(create_datapoint("good"));
+    writer.flush();
+    CHECK(written.size() == 2);
+  }
+
+  SECTION("Error is reported on next write") {
+    AsyncWriter writer(new RecordingWriter(written), 10);
+    writer.write_datapoint(create_datapoint("bad"));
+    // Wait for the writer thread without calling flush().
+    while (true) {
+      try {
+        writer.check_errors();
+      } catch (const std::runtime_error&) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+    CHECK(written.empty());
+  }
+
+  SECTION("Back-pressure when queue is full") {
+    RecordingWriter* recorder = new RecordingWriter(written);
+    recorder->hold = true;
+    AsyncWriter writer(recorder, 1);
+
+    // The first datapoint is taken by the writer thread, which then hangs.
+    writer.write_datapoint(create_datapoint("1"));
+    while (!recorder->started) std::this_thread::yield();
+    // The second one fills the queue.
+    writer.write_datapoint(create_datapoint("2"));
+
+    // The third one must wait until the writer thread continues.
+    std::atomic<bool> third_done{false};
+    std::thread producer([&] {
+      writer.write_datapoint(create_datapoint("3"));
+      third_done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!third_done);
+
+    recorder->hold = false;
+    producer.join();
+    CHECK(third_done);
+    writer.flush();
+    REQUIRE(written.size() == 3);
+    CHECK(written[2] == "3");
+  }
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Output writer that hands datapoints to the host program in memory.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "memory_writer.h"
+
+#include "heap_bytes.h"
+
+using namespace Fauna;
+using namespace Fauna::Output;
+
+std::size_t MemoryWriter::get_buffer_bytes() const {
+  return get_heap_bytes(datapoints);
+}
+
+std::vector<Datapoint> MemoryWriter::retrieve() {
+  std::vector<Datapoint> result;  // Create empty vector.
+  std::swap(result, datapoints);  // Use efficient move semantics.
+  return result;
+}
+
+void MemoryWriter::set_callback(Callback callback) {
+  this->callback = callback;
+  if (this->callback)
+    for (const auto& datapoint : retrieve()) this->callback(datapoint);
+}
+
+void MemoryWriter::write_datapoint(const Datapoint& datapoint) {
+  if (callback)
+    callback(datapoint);
+  else
+    datapoints.push_back(datapoint);
+}
+
+void MemoryWriter::take_datapoint(Datapoint&& datapoint) {
+  if (callback)
+    callback(datapoint);
+  else
+    datapoints.push_back(std::move(datapoint));
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Output writer that hands datapoints to the host program in memory.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_OUTPUT_MEMORY_WRITER_H
+#define FAUNA_OUTPUT_MEMORY_WRITER_H
+
+#include <functional>
+#include <vector>
+
+#include "datapoint.h"
+#include "writer_interface.h"
+
+namespace Fauna {
+namespace Output {
+
+/// Passes output data directly to the host program, without any file I/O.
+/**
+ * The datapoints are either handed to a callback function
+ * (\ref set_callback()) or collected until they are fetched with
+ * \ref retrieve(). If a callback is set, nothing is collected.
+ * \see \ref OutputFormat::InMemory
+ * \see \ref World::set_output_callback()
+ * \see \ref World::retrieve_output()
+ */
+class MemoryWriter : public WriterInterface {
+ public:
+  /// Function to receive each datapoint as soon as it is complete.
+  typedef std::function<void(const Datapoint&)> Callback;
+
+  /// Get all collected datapoints and clear the internal buffer.
+  /**
+   * \return All datapoints since the last call in the order they were written.
+   * The vector is empty if a callback is set.
+   */
+  std::vector<Datapoint> retrieve();
+
+  /// Estimated memory of the datapoints not yet retrieved [bytes].
+  virtual std::size_t get_buffer_bytes() const;
+
+  /// Register the function to call for each datapoint.
+  /**
+   * Any datapoints collected so far are passed to the callback immediately.
+   * \param callback The function to call. Pass an empty function object to
+   * collect the datapoints again instead.
+   */
+  void set_callback(Callback callback);
+
+  /// Pass a datapoint to the callback or store a copy of it.
+  virtual void write_datapoint(const Datapoint& datapoint);
+
+  /// Pass a datapoint to the callback or store it without copying.
+  virtual void take_datapoint(Datapoint&& datapoint);
+
+ private:
+  /// The registered function, may be empty.
+  Callback callback;
+
+  /// Collected datapoints if no callback is set.
+  std::vector<Datapoint> datapoints;
+};
+
+}  // namespace Output
+}  // namespace Fauna
+
+#endif  // FAUNA_OUTPUT_MEMORY_WRITER_H
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::Output::MemoryWriter.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "memory_writer.h"
+
+#include "catch.hpp"
+using namespace Fauna;
+using namespace Fauna::Output;
+
+TEST_CASE("Fauna::Output::MemoryWriter", "") {
+  MemoryWriter writer;
+  CHECK(writer.retrieve().empty());
+
+  Datapoint d1;
+  d1.aggregation_unit = "1";
+  Datapoint d2;
+  d2.aggregation_unit = "2";
+
+  writer.write_datapoint(d1);
+  writer.take_datapoint(Datapoint(d2));
+
+  SECTION("Pull datapoints") {
+    const auto v = writer.retrieve();
+    REQUIRE(v.size() == 2);
+    CHECK(v[0].aggregation_unit == "1");
+    CHECK(v[1].aggregation_unit == "2");
+    CHECK(writer.retrieve().empty());
+  }
+
+  SECTION("Push datapoints to callback") {
+    std::vector<std::string> received;
+    // Collected datapoints are passed on immediately.
+    writer.set_callback([&received](const Datapoint& d) {
+      received.push_back(d.aggregation_unit);
+    });
+    REQUIRE(received.size() == 2);
+    CHECK(writer.retrieve().empty());
+
+    writer.write_datapoint(d1);
+    writer.take_datapoint(Datapoint(d2));
+    REQUIRE(received.size() == 4);
+    CHECK(received[2] == "1");
+    CHECK(received[3] == "2");
+    CHECK(writer.retrieve().empty());
+
+    // Remove callback and collect again.
+    writer.set_callback(MemoryWriter::Callback());
+    writer.write_datapoint(d1);
+    CHECK(received.size() == 4);
+    CHECK(writer.retrieve().size() == 1);
+  }
+}
@@ -10,6 +10,7 @@
  */
 #include "text_table_writer.h"
 
+#include <cstdint>
 #include <sstream>
 
 #include "datapoint.h"
@@ -20,75 +21,84 @@ using namespace Fauna::Output;
 
 const char* TextTableWriter::NA_VALUE = "NA";
 const char* TextTableWriter::FILE_EXTENSION = ".tsv";
+const char* TextTableWriter::INDEX_EXTENSION = ".idx";
+
+void TextTableWriter::RowIndex::add(const std::string& agg_unit,
+                                    const int year,
+                                    const std::streamoff offset) {
+  if (year != this->year) {
+    write();
+    this->year = year;
+  }
+  rows[agg_unit].push_back(offset);
+}
+
+void TextTableWriter::RowIndex::write() {
+  for (const auto& r : rows) {
+    file << r.first << FIELD_SEPARATOR << year << FIELD_SEPARATOR;
+    for (auto i = r.second.begin(); i != r.second.end(); i++) {
+      if (i != r.second.begin()) file << ',';
+      file << *i;
+    }
+    file << '\n';
+  }
+  rows.clear();
+}
 
 TextTableWriter::TextTableWriter(const OutputInterval interval,
                                  const TextTableWriterOptions& options,
                                  const std::set<std::string> hft_names)
     : interval(interval), options(options), hft_names(hft_names) {
-  const std::string& dir = options.directory;
+  if (options.shards < 1)
+    throw std::invalid_argument(
+        "Fauna::Output::TextTableWriter::TextTableWriter() "
+        "The number of shards must be at least 1.");
 
-  create_directories(dir);
+  for (int i = 0; i < options.shards; i++) {
+    // Without sharding, the files are placed directly in the output
+    // directory as they always were.
+    std::string dir = options.directory;
+    if (options.shards > 1) dir += "/" + get_shard_directory(i);
 
-  // Add all selected output files to list of file streams.
-  // -> Add new output files here in alphabetical order.
-  if (options.available_forage) {
-    const std::string path = dir + "/available_forage" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&available_forage);
-    available_forage.open(path);
-  }
-  if (options.body_fat && !hft_names.empty()) {
-    const std::string path = dir + "/body_fat" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&body_fat);
-    body_fat.open(path);
-  }
-  if (options.digestibility) {
-    const std::string path = dir + "/digestibility" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&digestibility);
-    digestibility.open(path);
-  }
-  if (options.eaten_forage_per_ind && !hft_names.empty()) {
-    const std::string path = dir + "/eaten_forage_per_ind" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&eaten_forage_per_ind);
-    eaten_forage_per_ind.open(path);
-  }
-  if (options.eaten_nitrogen_per_ind && !hft_names.empty()) {
-    const std::string path = dir + "/eaten_nitrogen_per_ind" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&eaten_nitrogen_per_ind);
-    eaten_nitrogen_per_ind.open(path);
-  }
-  if (options.individual_density && !hft_names.empty()) {
-    const std::string path = dir + "/individual_density" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&individual_density);
-    individual_density.open(path);
-  }
-  if (options.mass_density && !hft_names.empty()) {
-    const std::string path = dir + "/mass_density" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&mass_density);
-    mass_density.open(path);
-  }
-  if (options.mass_density_per_hft && !hft_names.empty()) {  // deprecated
-    const std::string path = dir + "/mass_density_per_hft" + FILE_EXTENSION;
-    check_file_exists(path);
-    file_streams.push_back(&mass_density_per_hft);
-    mass_density_per_hft.open(path);
-  }
+    create_directories(dir);
 
-  for (auto& s : file_streams) {
-    // Set precision for all output streams.
-    s->precision(options.precision);
-    // Turn off scientific notation (like 3.14e+03), which might not be
-    // understood by post-processing software.
-    s->flags(std::ios::fixed);
+    shards.emplace_back(new FileSet);
+    FileSet& f = *shards.back();
+
+    // Add all selected output files to list of file streams.
+    // -> Add new output files here in alphabetical order.
+    if (options.available_forage)
+      open_table(f, f.available_forage, dir, "available_forage");
+    if (options.body_fat && !hft_names.empty())
+      open_table(f, f.body_fat, dir, "body_fat");
+    if (options.digestibility)
+      open_table(f, f.digestibility, dir, "digestibility");
+    if (options.eaten_forage_per_ind && !hft_names.empty())
+      open_table(f, f.eaten_forage_per_ind, dir, "eaten_forage_per_ind");
+    if (options.eaten_nitrogen_per_ind && !hft_names.empty())
+      open_table(f, f.eaten_nitrogen_per_ind, dir, "eaten_nitrogen_per_ind");
+    if (options.individual_density && !hft_names.empty())
+      open_table(f, f.individual_density, dir, "individual_density");
+    if (options.mass_density && !hft_names.empty())
+      open_table(f, f.mass_density, dir, "mass_density");
+    if (options.mass_density_per_hft && !hft_names.empty())  // deprecated
+      open_table(f, f.mass_density_per_hft, dir, "mass_density_per_hft");
+
+    for (auto& s : f.file_streams) {
+      // Set precision for all output streams.
+      s->precision(options.precision);
+      // Turn off scientific notation (like 3.14e+03), which might not be
+      // understood by post-processing software.
+      s->flags(std::ios::fixed);
+    }
   }
 }
 
+TextTableWriter::~TextTableWriter() {
+  for (auto& shard : shards)
+    for (auto& i : shard->indices) i.second.write();
+}
+
 void TextTableWriter::check_file_exists(const std::string& path) {
   if (file_exists(path))
     throw std::runtime_error(
@@ -97,18 +107,61 @@ void TextTableWriter::check_file_exists(const std::string& path) {
         path + "'");
 }
 
+void TextTableWriter::flush() {
+  for (auto& shard : shards) {
+    for (auto& s : shard->file_streams) s->flush();
+    for (auto& i : shard->indices) i.second.file.flush();
+  }
+}
+
+int TextTableWriter::get_shard(const std::string& aggregation_unit,
+                               const int shard_count) {
+  // 32-bit FNV-1a hash
+  std::uint32_t hash = 2166136261u;
+  for (const unsigned char c : aggregation_unit) {
+    hash ^= c;
+    hash *= 16777619u;
+  }
+  return hash % shard_count;
+}
+
+std::string TextTableWriter::get_shard_directory(const int shard) {
+  return "shard_" + std::to_string(shard);
+}
+
 const HerbivoreData* TextTableWriter::get_hft_data(
     const Datapoint* datapoint, const std::string& hft_name) const {
   assert(datapoint);
   for (const auto& i : datapoint->data.hft_data)
     if (i.first == hft_name) return &i.second;
-  // Generate empty record if none exists.
-  static const HerbivoreData empty_object;
-  return &empty_object;
+  return &empty_hft_data;
 }
 
-void TextTableWriter::start_row(const Datapoint& datapoint,
+void TextTableWriter::open_table(FileSet& files, std::ofstream& table,
+                                 const std::string& dir,
+                                 const std::string& name) {
+  const std::string path = dir + "/" + name + FILE_EXTENSION;
+  check_file_exists(path);
+  files.file_streams.push_back(&table);
+  table.open(path);
+  if (options.index) {
+    const std::string index_path = dir + "/" + name + INDEX_EXTENSION;
+    check_file_exists(index_path);
+    std::ofstream& index_file = files.indices[&table].file;
+    index_file.open(index_path);
+    index_file << "agg_unit" << FIELD_SEPARATOR << "year" << FIELD_SEPARATOR
+               << "offsets" << std::endl;
+  }
+}
+
+void TextTableWriter::start_row(const Datapoint& datapoint, FileSet& files,
                                 std::ofstream& table) {
+  if (options.index) {
+    assert(files.indices.count(&table));
+    files.indices[&table].add(datapoint.aggregation_unit,
+                              datapoint.interval.get_first().get_year(),
+                              table.tellp());
+  }
   switch (interval) {
     case OutputInterval::Daily:
       table << datapoint.interval.get_first().get_julian_day()
@@ -188,117 +241,89 @@ void TextTableWriter::write_datapoint(const Datapoint& datapoint) {
         found_names.str());
   }
 
+  FileSet& f =
+      *shards[get_shard(datapoint.aggregation_unit, options.shards)];
+
   // Per-ForageType Tables
-  if (available_forage.is_open()) start_row(datapoint, available_forage);
-  if (digestibility.is_open()) start_row(datapoint, digestibility);
+  if (f.available_forage.is_open())
+    start_row(datapoint, f, f.available_forage);
+  if (f.digestibility.is_open()) start_row(datapoint, f, f.digestibility);
   const auto digestibility_data =
       datapoint.data.habitat_data.available_forage.get_digestibility();
   const auto forage_mass_data =
       datapoint.data.habitat_data.available_forage.get_mass();
   for (const auto t : FORAGE_TYPES) {
-    if (available_forage.is_open())
-      available_forage << FIELD_SEPARATOR << forage_mass_data[t];
-    if (digestibility.is_open()) {
+    if (f.available_forage.is_open())
+      f.available_forage << FIELD_SEPARATOR << forage_mass_data[t];
+    if (f.digestibility.is_open()) {
       if (forage_mass_data[t] > 0)
-        digestibility << FIELD_SEPARATOR << digestibility_data[t];
+        f.digestibility << FIELD_SEPARATOR << digestibility_data[t];
       else
-        digestibility << FIELD_SEPARATOR << NA_VALUE;
+        f.digestibility << FIELD_SEPARATOR << NA_VALUE;
     }
     // -> Add more tables here in alphabetical order.
   }
-  if (available_forage.is_open()) available_forage << std::endl;
-  if (digestibility.is_open()) digestibility << std::endl;
+  if (f.available_forage.is_open()) f.available_forage << std::endl;
+  if (f.digestibility.is_open()) f.digestibility << std::endl;
   // -> Add more tables here in alphabetical order.
 
   // Per-HFT Tables
-  if (body_fat.is_open()) start_row(datapoint, body_fat);
-  if (eaten_nitrogen_per_ind.is_open())
-    start_row(datapoint, eaten_nitrogen_per_ind);
-  if (individual_density.is_open()) start_row(datapoint, individual_density);
-  if (mass_density.is_open()) start_row(datapoint, mass_density);
-  if (mass_density_per_hft.is_open())  // deprecated
-    start_row(datapoint, mass_density_per_hft);
+  if (f.body_fat.is_open()) start_row(datapoint, f, f.body_fat);
+  if (f.eaten_nitrogen_per_ind.is_open())
+    start_row(datapoint, f, f.eaten_nitrogen_per_ind);
+  if (f.individual_density.is_open())
+    start_row(datapoint, f, f.individual_density);
+  if (f.mass_density.is_open()) start_row(datapoint, f, f.mass_density);
+  if (f.mass_density_per_hft.is_open())  // deprecated
+    start_row(datapoint, f, f.mass_density_per_hft);
   // Iterate over predefined order of HFTs.
   for (const auto& hft_name : hft_names) {
     const HerbivoreData* d = get_hft_data(&datapoint, hft_name);
     assert(d);
     // Add datum for this HFT.
-    if (body_fat.is_open()) body_fat << FIELD_SEPARATOR << d->bodyfat;
-    if (eaten_nitrogen_per_ind.is_open())
-      eaten_nitrogen_per_ind << FIELD_SEPARATOR << d->eaten_nitrogen_per_ind;
-    if (individual_density.is_open())
-      individual_density << FIELD_SEPARATOR << d->inddens;
-    if (mass_density.is_open()) mass_density << FIELD_SEPARATOR << d->massdens;
-    if (mass_density_per_hft.is_open())  // deprecated
-      mass_density_per_hft << FIELD_SEPARATOR << d->massdens;
+    if (f.body_fat.is_open()) f.body_fat << FIELD_SEPARATOR << d->bodyfat;
+    if (f.eaten_nitrogen_per_ind.is_open())
+      f.eaten_nitrogen_per_ind << FIELD_SEPARATOR
+                               << d->eaten_nitrogen_per_ind;
+    if (f.individual_density.is_open())
+      f.individual_density << FIELD_SEPARATOR << d->inddens;
+    if (f.mass_density.is_open())
+      f.mass_density << FIELD_SEPARATOR << d->massdens;
+    if (f.mass_density_per_hft.is_open())  // deprecated
+      f.mass_density_per_hft << FIELD_SEPARATOR << d->massdens;
     // -> Add more per-HFT tables here in alphabetical order.
   }
-  if (body_fat.is_open()) body_fat << std::endl;
-  if (eaten_nitrogen_per_ind.is_open()) eaten_nitrogen_per_ind << std::endl;
-  if (individual_density.is_open()) individual_density << std::endl;
-  if (mass_density.is_open()) mass_density << std::endl;
-  if (mass_density_per_hft.is_open()) mass_density_per_hft << std::endl;
+  if (f.body_fat.is_open()) f.body_fat << std::endl;
+  if (f.eaten_nitrogen_per_ind.is_open())
+    f.eaten_nitrogen_per_ind << std::endl;
+  if (f.individual_density.is_open()) f.individual_density << std::endl;
+  if (f.mass_density.is_open()) f.mass_density << std::endl;
+  if (f.mass_density_per_hft.is_open()) f.mass_density_per_hft << std::endl;
   // -> Add more tables here in alphabetical order.
 
   // Per-HFT/Per-Forage Tables
   // There is one new row for each forage type.
   for (const auto t : FORAGE_TYPES) {
-    if (eaten_forage_per_ind.is_open()) {
-      start_row(datapoint, eaten_forage_per_ind);
-      eaten_forage_per_ind << FIELD_SEPARATOR << get_forage_type_name(t);
+    if (f.eaten_forage_per_ind.is_open()) {
+      start_row(datapoint, f, f.eaten_forage_per_ind);
+      f.eaten_forage_per_ind << FIELD_SEPARATOR << get_forage_type_name(t);
     }
     for (const auto& hft_name : hft_names) {
       const HerbivoreData* d = get_hft_data(&datapoint, hft_name);
       assert(d);
       // Write the datum for this HFT and forage type.
-      if (eaten_forage_per_ind.is_open())
-        eaten_forage_per_ind << FIELD_SEPARATOR << d->eaten_forage_per_ind[t];
+      if (f.eaten_forage_per_ind.is_open())
+        f.eaten_forage_per_ind << FIELD_SEPARATOR
+                               << d->eaten_forage_per_ind[t];
     }
     // Add more per-HFT/per-forage tables here.
   }
-  if (eaten_forage_per_ind.is_open()) eaten_forage_per_ind << std::endl;
+  if (f.eaten_forage_per_ind.is_open()) f.eaten_forage_per_ind << std::endl;
   // Add more tables here.
 }
 
 void TextTableWriter::write_captions(const Datapoint& datapoint) {
-  // Write common column captions for all output tables.
-  for (auto& f : file_streams) {
-    switch (interval) {
-      case OutputInterval::Daily:
-        *f << "day" << FIELD_SEPARATOR << "year" << FIELD_SEPARATOR;
-        break;
-      case OutputInterval::Monthly:
-        *f << "month" << FIELD_SEPARATOR << "year" << FIELD_SEPARATOR;
-        break;
-      case OutputInterval::Annual:
-        *f << "year" << FIELD_SEPARATOR;
-        break;
-      case OutputInterval::Decadal:
-        *f << "year" << FIELD_SEPARATOR;
-        break;
-      default:
-        std::logic_error(
-            "Fauna::TextTableWriter::write_captions() Output time interval "
-            "is "
-            "not implemented.");
-    }
-    *f << "agg_unit";
-  }
-
-  // Per-ForageType Tables
-  for (const auto t : FORAGE_TYPES) {
-    if (available_forage.is_open())
-      available_forage << FIELD_SEPARATOR << get_forage_type_name(t);
-    if (digestibility.is_open())
-      digestibility << FIELD_SEPARATOR << get_forage_type_name(t);
-  }
-
-  // Add Forage Type column to per-hft/per-forage tables.
-  if (eaten_forage_per_ind.is_open())
-    eaten_forage_per_ind << FIELD_SEPARATOR << "forage_type";
-
-  // Per-HFT Tables
-  // Write the HFT names in the distinct and never-changing order.
+  // Check the HFT names once before writing anything.
   for (const auto& hft_name : hft_names) {
     if (hft_name.find(' ') != std::string::npos)
       throw std::invalid_argument(
@@ -312,20 +337,66 @@ void TextTableWriter::write_captions(const Datapoint& datapoint) {
           "The HFT name '" +
           hft_name + "' contains the field delimiter '" + FIELD_SEPARATOR +
           "'");
-
-    // -> Add new output files here in alphabetical order.
-    if (body_fat.is_open()) body_fat << FIELD_SEPARATOR << hft_name;
-    if (eaten_forage_per_ind.is_open())
-      eaten_forage_per_ind << FIELD_SEPARATOR << hft_name;
-    if (eaten_nitrogen_per_ind.is_open())
-      eaten_nitrogen_per_ind << FIELD_SEPARATOR << hft_name;
-    if (individual_density.is_open())
-      individual_density << FIELD_SEPARATOR << hft_name;
-    if (mass_density.is_open()) mass_density << FIELD_SEPARATOR << hft_name;
-    if (mass_density_per_hft.is_open())  // deprecated
-      mass_density_per_hft << FIELD_SEPARATOR << hft_name;
   }
   assert(hft_names.size() >= datapoint.data.hft_data.size());
 
-  for (auto& f : file_streams) *f << std::endl;
+  // All shards get the same captions.
+  for (auto& shard : shards) {
+    FileSet& f = *shard;
+
+    // Write common column captions for all output tables.
+    for (auto& s : f.file_streams) {
+      switch (interval) {
+        case OutputInterval::Daily:
+          *s << "day" << FIELD_SEPARATOR << "year" << FIELD_SEPARATOR;
+          break;
+        case OutputInterval::Monthly:
+          *s << "month" << FIELD_SEPARATOR << "year" << FIELD_SEPARATOR;
+          break;
+        case OutputInterval::Annual:
+          *s << "year" << FIELD_SEPARATOR;
+          break;
+        case OutputInterval::Decadal:
+          *s << "year" << FIELD_SEPARATOR;
+          break;
+        default:
+          std::logic_error(
+              "Fauna::TextTableWriter::write_captions() Output time interval "
+              "is "
+              "not implemented.");
+      }
+      *s << "agg_unit";
+    }
+
+    // Per-ForageType Tables
+    for (const auto t : FORAGE_TYPES) {
+      if (f.available_forage.is_open())
+        f.available_forage << FIELD_SEPARATOR << get_forage_type_name(t);
+      if (f.digestibility.is_open())
+        f.digestibility << FIELD_SEPARATOR << get_forage_type_name(t);
+    }
+
+    // Add Forage Type column to per-hft/per-forage tables.
+    if (f.eaten_forage_per_ind.is_open())
+      f.eaten_forage_per_ind << FIELD_SEPARATOR << "forage_type";
+
+    // Per-HFT Tables
+    // Write the HFT names in the distinct and never-changing order.
+    for (const auto& hft_name : hft_names) {
+      // -> Add new output files here in alphabetical order.
+      if (f.body_fat.is_open()) f.body_fat << FIELD_SEPARATOR << hft_name;
+      if (f.eaten_forage_per_ind.is_open())
+        f.eaten_forage_per_ind << FIELD_SEPARATOR << hft_name;
+      if (f.eaten_nitrogen_per_ind.is_open())
+        f.eaten_nitrogen_per_ind << FIELD_SEPARATOR << hft_name;
+      if (f.individual_density.is_open())
+        f.individual_density << FIELD_SEPARATOR << hft_name;
+      if (f.mass_density.is_open())
+        f.mass_density << FIELD_SEPARATOR << hft_name;
+      if (f.mass_density_per_hft.is_open())  // deprecated
+        f.mass_density_per_hft << FIELD_SEPARATOR << hft_name;
+    }
+
+    for (auto& s : f.file_streams) *s << std::endl;
+  }
 }
@@ -12,15 +12,16 @@
 #define FAUNA_OUTPUT_TEXT_TABLE_WRITER_H
 
 #include <fstream>
+#include <map>
+#include <memory>
 #include <vector>
 
+#include "herbivore_data.h"
 #include "parameters.h"
 #include "writer_interface.h"
 
 namespace Fauna {
 namespace Output {
-// Forward declarations
-class HerbivoreData;
 
 /// Writes output data to tabular plaintext files.
 /**
@@ -30,6 +31,12 @@ class HerbivoreData;
  * boolean variable in \ref TextTableWriterOptions.
  * All files are created in a directory specified by
  * \ref TextTableWriterOptions::directory.
+ *
+ * If \ref TextTableWriterOptions::shards is greater than one, there is one
+ * complete set of files for each shard in a subdirectory. Each aggregation
+ * unit is written only to the files of its shard (\ref get_shard()).
+ * If \ref TextTableWriterOptions::index is enabled, the row offsets of each
+ * aggregation unit and year are written to an index file for each table.
  */
 class TextTableWriter : public WriterInterface {
  public:
@@ -41,11 +48,37 @@ class TextTableWriter : public WriterInterface {
    * \param options Specific user-defined options for this class.
    * \param hft_names All HFTs in the simulation (see \ref Fauna::Hft::name).
    * \throw std::runtime_error If one of the output files already exists.
+   * \throw std::invalid_argument If \ref TextTableWriterOptions::shards is
+   * smaller than 1.
    */
   TextTableWriter(const OutputInterval interval,
                   const TextTableWriterOptions& options,
                   const std::set<std::string> hft_names);
 
+  /// Destructor: Write the index entries of the last year.
+  virtual ~TextTableWriter();
+
+  /// Flush the buffers of all file streams.
+  virtual void flush();
+
+  /// Get the shard number for an aggregation unit.
+  /**
+   * The shard is the 32-bit FNV-1a hash of the aggregation unit name modulo
+   * the shard count. Post-processing scripts can use the same function to
+   * find the files for a particular aggregation unit.
+   * \param aggregation_unit Name of the aggregation unit
+   * (\ref Datapoint::aggregation_unit).
+   * \param shard_count Total number of shards
+   * (\ref TextTableWriterOptions::shards).
+   * \return Zero-based index of the shard, in the interval
+   * [0,`shard_count`).
+   */
+  static int get_shard(const std::string& aggregation_unit,
+                       const int shard_count);
+
+  /// Name of the subdirectory for a shard, relative to the output directory.
+  static std::string get_shard_directory(const int shard);
+
   /// Append spatially & temporally aggregated output data to table files.
   /**
    * \param datapoint The output data to write.
@@ -83,7 +116,56 @@ class TextTableWriter : public WriterInterface {
   /// File extension for tabular plaintext files.
   static const char* FILE_EXTENSION;
 
+  /// File extension for the index file next to each table.
+  /** \see \ref TextTableWriterOptions::index */
+  static const char* INDEX_EXTENSION;
+
  private:
+  /// Index of row offsets for one table file.
+  /**
+   * Since the datapoints come in chronological order, we collect the offsets
+   * for one year and write them when the next year starts.
+   */
+  struct RowIndex {
+    /// Output stream for the index file.
+    std::ofstream file;
+
+    /// The year of the rows in \ref rows.
+    int year = 0;
+
+    /// Byte offsets of all rows in the current year for each agg. unit.
+    std::map<std::string, std::vector<std::streamoff> > rows;
+
+    /// Remember the offset of a new row.
+    void add(const std::string& agg_unit, const int year,
+             const std::streamoff offset);
+
+    /// Write all collected rows to \ref file.
+    void write();
+  };
+
+  /// All output files for one shard.
+  struct FileSet {
+    /// List of pointers to the user-selected and active file streams.
+    std::vector<std::ofstream*> file_streams;
+
+    /// Row index for each file stream in \ref file_streams.
+    /** Only filled if \ref TextTableWriterOptions::index is enabled. */
+    std::map<const std::ofstream*, RowIndex> indices;
+
+    /** @{ \name File Streams */
+    std::ofstream available_forage;
+    std::ofstream body_fat;
+    std::ofstream digestibility;
+    std::ofstream eaten_forage_per_ind;
+    std::ofstream eaten_nitrogen_per_ind;
+    std::ofstream individual_density;
+    std::ofstream mass_density;
+    std::ofstream mass_density_per_hft;  // deprecated
+    // Add new output variables here (alphabetical order).
+    /** @} */  // File Streams
+  };
+
   /// Throw an exception if output file already exists.
   static void check_file_exists(const std::string& path);
 
@@ -101,14 +183,27 @@ class TextTableWriter : public WriterInterface {
   const HerbivoreData* get_hft_data(const Datapoint* datapoint,
                                     const std::string& hft_name) const;
 
+  /// Open a table file and add it to the file set.
+  /**
+   * \param files The file set that `table` belongs to.
+   * \param table The file stream member variable in `files`.
+   * \param dir The directory of the file set.
+   * \param name The file name without extension.
+   * \throw std::runtime_error If the file or its index file already exists.
+   */
+  void open_table(FileSet& files, std::ofstream& table, const std::string& dir,
+                  const std::string& name);
+
   /// Create a new row by writing year/month/day and aggregation unit.
   /**
    * There is no \ref FIELD_SEPARATOR at the end of the row.
    * \param datapoint Contains the date and aggregation unit.
-   * \param table Output stream to write to. This is a member variable of this
-   * class.
+   * \param files The file set that `table` belongs to.
+   * \param table Output stream to write to. This is a member variable of
+   * `files`.
    */
-  void start_row(const Datapoint& datapoint, std::ofstream& table);
+  void start_row(const Datapoint& datapoint, FileSet& files,
+                 std::ofstream& table);
 
   /// Write the first line in the output files: column headers
   /**
@@ -124,9 +219,6 @@ class TextTableWriter : public WriterInterface {
   /// Whether column captions have already been written to file.
   bool captions_written = false;
 
-  /// List of pointers to the user-selected and active file streams.
-  std::vector<std::ofstream*> file_streams;
-
   /// List of Hft names (\ref Fauna::Hft::name) in constant order.
   const std::set<std::string> hft_names;
 
@@ -136,17 +228,11 @@ class TextTableWriter : public WriterInterface {
   /// User options from the instruction file.
   const TextTableWriterOptions options;
 
-  /** @{ \name File Streams */
-  std::ofstream available_forage;
-  std::ofstream body_fat;
-  std::ofstream digestibility;
-  std::ofstream eaten_forage_per_ind;
-  std::ofstream eaten_nitrogen_per_ind;
-  std::ofstream individual_density;
-  std::ofstream mass_density;
-  std::ofstream mass_density_per_hft;  // deprecated
-  // Add new output variables here (alphabetical order).
-  /** @} */  // File Streams
+  /// One set of output files for each shard.
+  std::vector<std::unique_ptr<FileSet> > shards;
+
+  /// Returned by \ref get_hft_data() if a datapoint has no data for an HFT.
+  const HerbivoreData empty_hft_data;
 };
 }  // namespace Output
 }  // namespace Fauna
@@ -256,3 +256,84 @@ TEST_CASE("Fauna::Output::TextTableWriter ANNUAL", "") {
   // Delete directory recursively.
   if (directory_exists(opt.directory)) remove_directory(opt.directory);
 }
+
+TEST_CASE("Fauna::Output::TextTableWriter shards and index", "") {
+  CHECK(TextTableWriter::get_shard("any", 1) == 0);
+  for (int n = 1; n < 10; n++) {
+    CHECK(TextTableWriter::get_shard("unit", n) >= 0);
+    CHECK(TextTableWriter::get_shard("unit", n) < n);
+  }
+
+  TextTableWriterOptions opt;
+  opt.mass_density = true;
+  opt.shards = 3;
+  opt.index = true;
+  opt.directory = generate_output_dir() + "_shards";
+  REQUIRE(!directory_exists(opt.directory));
+  INFO((std::string) "Random output directory: " + opt.directory);
+
+  static const HftList HFTS = *create_hfts(1, Parameters());
+  const std::set<std::string> hft_names = {HFTS[0]->name};
+
+  opt.shards = 0;
+  CHECK_THROWS(TextTableWriter(OutputInterval::Annual, opt, hft_names));
+  opt.shards = 3;
+
+  static const std::vector<std::string> UNITS = {"a", "b", "c", "d", "e"};
+  static const int FIRST_YEAR = 10;
+  static const int YEARS = 3;
+  {
+    TextTableWriter writer(OutputInterval::Annual, opt, hft_names);
+    for (int i = 0; i < opt.shards; i++)
+      CHECK(directory_exists(opt.directory + "/" +
+                             TextTableWriter::get_shard_directory(i)));
+    for (int year = FIRST_YEAR; year < FIRST_YEAR + YEARS; year++)
+      for (const auto &unit : UNITS) {
+        Datapoint datapoint;
+        datapoint.aggregation_unit = unit;
+        datapoint.interval = DateInterval(Date(0, year), Date(364, year));
+        datapoint.data.datapoint_count = 1;
+        datapoint.data.hft_data[HFTS[0]->name].massdens = year;
+        writer.write_datapoint(datapoint);
+      }
+  }  // Destructor writes index of last year.
+
+  for (const auto &unit : UNITS) {
+    const std::string dir =
+        opt.directory + "/" +
+        TextTableWriter::get_shard_directory(
+            TextTableWriter::get_shard(unit, opt.shards));
+    std::ifstream table(dir + "/mass_density" +
+                        TextTableWriter::FILE_EXTENSION);
+    std::ifstream index(dir + "/mass_density" +
+                        TextTableWriter::INDEX_EXTENSION);
+    REQUIRE(table.good());
+    REQUIRE(index.good());
+
+    std::string line;
+    REQUIRE(std::getline(index, line));
+    CHECK(line == "agg_unit\tyear\toffsets");
+
+    // Find the index entries for this aggregation unit and follow them into
+    // the table.
+    int years_found = 0;
+    while (std::getline(index, line)) {
+      const auto fields = split(line, TextTableWriter::FIELD_SEPARATOR);
+      REQUIRE(fields.size() == 3);
+      if (fields[0] != unit) continue;
+      years_found++;
+      const auto offsets = split(fields[2], ',');
+      REQUIRE(offsets.size() == 1);
+      table.seekg(std::stol(offsets[0]));
+      std::string row;
+      REQUIRE(std::getline(table, row));
+      const auto row_fields = split(row, TextTableWriter::FIELD_SEPARATOR);
+      REQUIRE(row_fields.size() == 3);
+      CHECK(row_fields[0] == fields[1]);  // year
+      CHECK(row_fields[1] == unit);
+    }
+    CHECK(years_found == YEARS);
+  }
+
+  if (directory_exists(opt.directory)) remove_directory(opt.directory);
+}
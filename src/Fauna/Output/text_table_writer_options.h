@@ -33,6 +33,27 @@ struct TextTableWriterOptions {
   /// Number of figures after the decimal point.
   unsigned int precision = 3;
 
+  /// Number of file sets to distribute the aggregation units over.
+  /**
+   * With only one shard, all tables are written directly into
+   * \ref directory. Otherwise each aggregation unit is assigned to one
+   * subdirectory `shard_<i>` by a hash of its name
+   * (\ref TextTableWriter::get_shard()). The tables for different shards
+   * can be processed independently.
+   */
+  int shards = 1;
+
+  /// Whether to write an index file of row offsets for each table.
+  /**
+   * Next to each table file there will be a file with extension
+   * \ref TextTableWriter::INDEX_EXTENSION. It has the columns `agg_unit`,
+   * `year`, and `offsets`. The latter is a comma-separated list of the byte
+   * offsets of all rows of that aggregation unit and year in the table file.
+   * With that the time series of one aggregation unit can be read without
+   * scanning the whole table.
+   */
+  bool index = false;
+
   /** @{ \name Per-ForageType tables: one column per forage type. */
 
   /// Dry matter weight of available forage in the habitat [kgDM/km²].
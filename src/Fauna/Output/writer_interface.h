@@ -11,10 +11,11 @@
 #ifndef FAUNA_OUTPUT_WRITER_INTERFACE_H
 #define FAUNA_OUTPUT_WRITER_INTERFACE_H
 
+#include <cstddef>
 namespace Fauna {
 namespace Output {
 // Forward declarations:
-class Datapoint;
+struct Datapoint;
 
 /// Interface class for all classes that implement writing output.
 struct WriterInterface {
@@ -22,6 +23,28 @@ struct WriterInterface {
   /** Destructor must be virtual in an interface. */
   virtual ~WriterInterface() {}
 
+  /// Throw any error that occurred outside of the calling thread.
+  /**
+   * Writers that do their work in the background cannot throw an exception
+   * directly from \ref write_datapoint(). Instead they report it here.
+   * The default implementation does nothing.
+   */
+  virtual void check_errors() {}
+
+  /// Make sure that all datapoints passed so far have been written.
+  /**
+   * The default implementation does nothing.
+   * \throw Any exception from writing the pending datapoints.
+   */
+  virtual void flush() {}
+
+  /// Estimated memory of datapoints that are kept in this writer [bytes].
+  /**
+   * The default implementation returns zero for writers that don’t keep
+   * datapoints.
+   */
+  virtual std::size_t get_buffer_bytes() const { return 0; }
+
   /// Write spatially & temporally aggregated output data.
   /**
    * \param datapoint The data to write.
@@ -29,6 +52,16 @@ struct WriterInterface {
    * is zero.
    */
   virtual void write_datapoint(const Datapoint& datapoint) = 0;
+
+  /// Write output data that the caller doesn’t need anymore.
+  /**
+   * Writers that keep the datapoint can override this to avoid a copy. The
+   * default implementation calls \ref write_datapoint().
+   * \param datapoint The data to write. It may be left in a moved-from state.
+   */
+  virtual void take_datapoint(Datapoint&& datapoint) {
+    write_datapoint(datapoint);
+  }
 };
 }  // namespace Output
 }  // namespace Fauna
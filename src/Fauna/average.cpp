@@ -15,6 +15,8 @@
 #include <numeric>
 #include <stdexcept>
 
+#include "checkpoint.h"
+
 using namespace Fauna;
 
 namespace Fauna {
@@ -55,11 +57,13 @@ PeriodAverage::PeriodAverage(const int count) : count(count) {
     throw std::invalid_argument(
         "Fauna:: PeriodAverage::PeriodAverage() "
         "Parameter `count` is zero or negative.");
-  values.reserve(count);
 }
 
 void PeriodAverage::add_value(const double v) {
   assert(current_index < count);
+  // Memory is only reserved when needed because many objects (e.g. in male
+  // herbivores) never get any values.
+  if (values.empty()) values.reserve(count);
   if (current_index < values.size())
     values[current_index] = v;  // Overwrite existing value.
   else
@@ -96,3 +100,19 @@ double PeriodAverage::get_first() const {
   else
     return values[0];
 }
+
+void PeriodAverage::load_state(CheckpointReader& in) {
+  in.read(count);
+  in.read(current_index);
+  in.read(values);
+  if (count == 0 || current_index >= count || values.size() > count)
+    throw std::runtime_error(
+        "Fauna::PeriodAverage::load_state() "
+        "Invalid checkpoint data.");
+}
+
+void PeriodAverage::save_state(CheckpointWriter& out) const {
+  out.write(count);
+  out.write(current_index);
+  out.write(values);
+}
@@ -37,11 +37,12 @@ TEST_CASE("Fauna::PeriodAverage") {
   CHECK_THROWS(pa.get_average());
   CHECK_THROWS(pa.get_first());
 
-  const double A = .1;
-  const double B = .2;
-  const double C = .4;
-  const double D = .5;
-  const double E = .6;
+  // The values as they are stored, also with MEGAFAUNA_FLOAT_STORAGE.
+  const double A = StorageReal(.1);
+  const double B = StorageReal(.2);
+  const double C = StorageReal(.4);
+  const double D = StorageReal(.5);
+  const double E = StorageReal(.6);
 
   pa.add_value(A);
   CHECK(pa.get_average() == A);
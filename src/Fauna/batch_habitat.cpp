@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief A habitat that reads its forcing from arrays of the host program.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "batch_habitat.h"
+
+#include <stdexcept>
+
+using namespace Fauna;
+
+BatchHabitat::BatchHabitat(const std::string& aggregation_unit,
+                           const int index)
+    : aggregation_unit(aggregation_unit), index(index) {
+  if (index < 0)
+    throw std::invalid_argument(
+        "Fauna::BatchHabitat::BatchHabitat() "
+        "Parameter `index` is negative.");
+}
+
+const BatchForcing& BatchHabitat::get_forcing(
+    const std::string& caller) const {
+  if (!forcing)
+    throw std::logic_error("Fauna::BatchHabitat::" + caller +
+                           "() "
+                           "No forcing has been set for today.");
+  return *forcing;
+}
+
+void BatchHabitat::init_day(const int today) {
+  const BatchForcing& f = get_forcing("init_day");
+  // Set nitrogen last because it must not exceed dry matter.
+  forage = HabitatForage();
+  forage.grass.set_mass(f.grass_mass[index]);
+  forage.grass.set_digestibility(f.grass_digestibility[index]);
+  forage.grass.set_fpc(f.grass_fpc[index]);
+  forage.grass.set_nitrogen_mass(f.grass_nitrogen_mass[index]);
+  environment.air_temperature = f.air_temperature[index];
+
+  // The parent class copies forage and environment into today’s output.
+  Habitat::init_day(today);
+}
+
+void BatchHabitat::remove_eaten_forage(const ForageMass& eaten_forage) {
+  const BatchForcing& f = get_forcing("remove_eaten_forage");
+
+  const double eaten = eaten_forage[ForageType::Grass];
+  const double mass = forage.grass.get_mass();
+  if (mass - eaten < 0.0)
+    throw std::logic_error(
+        "Fauna::BatchHabitat::remove_eaten_forage() "
+        "Eaten grass exceeds available grass.\n"
+        "Available: " +
+        std::to_string(mass) +
+        " kg/km²\n"
+        "Eaten: " +
+        std::to_string(eaten) + " kg/km²");
+  Habitat::remove_eaten_forage(eaten_forage);
+  if (eaten == 0.0) return;
+
+  // Nitrogen is eaten in proportion to dry matter. It is reduced first so
+  // that it never exceeds dry matter.
+  const double remaining = mass - eaten;
+  forage.grass.set_nitrogen_mass(forage.grass.get_nitrogen_mass() *
+                                 remaining / mass);
+  forage.grass.set_mass(remaining);
+  if (remaining == 0.0) forage.grass.set_fpc(0.0);
+
+  f.eaten_grass[index] += eaten;
+}
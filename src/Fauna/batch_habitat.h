@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief A habitat that reads its forcing from arrays of the host program.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_BATCH_HABITAT_H
+#define FAUNA_BATCH_HABITAT_H
+
+#include <string>
+
+#include "batch_forcing.h"
+#include "environment.h"
+#include "habitat.h"
+#include "habitat_forage.h"
+
+namespace Fauna {
+
+/// A habitat whose forage and environment come from a \ref BatchForcing.
+/**
+ * The forcing is read only once per day in \ref init_day(). Eaten forage is
+ * subtracted from the available forage and added to
+ * \ref BatchForcing::eaten_grass.
+ * \see \ref World::create_batch_simulation_unit()
+ */
+class BatchHabitat : public Habitat {
+ public:
+  /// Constructor
+  /**
+   * \param aggregation_unit \copybrief Habitat::get_aggregation_unit()
+   * \param index Position of this habitat in the arrays of
+   * \ref BatchForcing.
+   * \throw std::invalid_argument If `index` is negative.
+   */
+  BatchHabitat(const std::string& aggregation_unit, const int index);
+
+  virtual const char* get_aggregation_unit() const {
+    return aggregation_unit.c_str();
+  }
+
+  /// Today’s forage minus what has been eaten so far.
+  virtual HabitatForage get_available_forage() const { return forage; }
+
+  /// Today’s environment as read in \ref init_day().
+  virtual HabitatEnvironment get_environment() const { return environment; }
+
+  /// Read today’s forage and environment from the forcing arrays.
+  /**
+   * \throw std::logic_error If no forcing has been set.
+   * \throw std::exception If forcing values are out of range or don’t fit
+   * together (see setter functions of \ref GrassForage).
+   */
+  virtual void init_day(const int today);
+
+  /// Subtract eaten forage and report it in \ref BatchForcing::eaten_grass.
+  /**
+   * \throw std::logic_error If no forcing has been set or if eaten grass
+   * exceeds available grass.
+   */
+  virtual void remove_eaten_forage(const ForageMass& eaten_forage);
+
+  /// Position of this habitat in the arrays of \ref BatchForcing.
+  int get_index() const { return index; }
+
+  /// Set the arrays to read from and write to.
+  /**
+   * \param forcing Non-owning pointer, or NULL after the simulation day.
+   */
+  void set_forcing(const BatchForcing* forcing) { this->forcing = forcing; }
+
+ private:
+  /// Get the current forcing.
+  /** \throw std::logic_error If \ref forcing is NULL. */
+  const BatchForcing& get_forcing(const std::string& caller) const;
+
+  const std::string aggregation_unit;
+  const int index;
+  const BatchForcing* forcing = NULL;
+  HabitatForage forage;
+  HabitatEnvironment environment;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_BATCH_HABITAT_H
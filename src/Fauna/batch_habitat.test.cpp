@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the array-based habitat.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "batch_habitat.h"
+
+#include "catch.hpp"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::BatchHabitat", "") {
+  CHECK_THROWS_AS(BatchHabitat("a", -1), std::invalid_argument);
+
+  const double mass[] = {0.0, 100.0};
+  const double digestibility[] = {0.5, 0.6};
+  const double nitrogen[] = {0.0, 10.0};
+  const double fpc[] = {0.0, 0.5};
+  const double temperature[] = {-5.0, 15.0};
+  double eaten[] = {42.0, 42.0};
+
+  BatchForcing forcing;
+  forcing.grass_mass = mass;
+  forcing.grass_digestibility = digestibility;
+  forcing.grass_nitrogen_mass = nitrogen;
+  forcing.grass_fpc = fpc;
+  forcing.air_temperature = temperature;
+  forcing.eaten_grass = eaten;
+
+  BatchHabitat habitat("a", 1);
+  // The public getter for the output is const.
+  const Output::HabitatData& output =
+      ((const BatchHabitat&)habitat).get_todays_output();
+  CHECK(std::string(habitat.get_aggregation_unit()) == "a");
+  CHECK(habitat.get_index() == 1);
+  CHECK_THROWS_AS(habitat.init_day(0), std::logic_error);
+
+  habitat.set_forcing(&forcing);
+  habitat.init_day(3);
+  CHECK(habitat.get_day() == 3);
+  CHECK(habitat.get_available_forage().grass.get_mass() == 100.0);
+  CHECK(habitat.get_available_forage().grass.get_digestibility() == 0.6);
+  CHECK(habitat.get_available_forage().grass.get_nitrogen_mass() == 10.0);
+  CHECK(habitat.get_available_forage().grass.get_fpc() == 0.5);
+  CHECK(habitat.get_environment().air_temperature == 15.0);
+  CHECK(output.available_forage.grass.get_mass() == 100.0);
+
+  SECTION("Remove eaten forage") {
+    eaten[1] = 0.0;
+    ForageMass eaten_forage;
+    eaten_forage[ForageType::Grass] = 40.0;
+    habitat.remove_eaten_forage(eaten_forage);
+    habitat.remove_eaten_forage(eaten_forage);
+    CHECK(eaten[0] == 42.0);  // Other habitats are untouched.
+    CHECK(eaten[1] == Approx(80.0));
+    CHECK(habitat.get_available_forage().grass.get_mass() == Approx(20.0));
+    CHECK(habitat.get_available_forage().grass.get_nitrogen_mass() ==
+          Approx(2.0));
+    CHECK(output.eaten_forage[ForageType::Grass] == Approx(80.0));
+    CHECK_THROWS_AS(habitat.remove_eaten_forage(eaten_forage),
+                    std::logic_error);
+
+    eaten_forage[ForageType::Grass] = 20.0;
+    habitat.remove_eaten_forage(eaten_forage);
+    CHECK(habitat.get_available_forage().grass.get_mass() == Approx(0.0));
+    CHECK(habitat.get_available_forage().grass.get_fpc() == 0.0);
+  }
+
+  SECTION("Invalid forcing") {
+    const double bad_digestibility[] = {0.5, 1.5};
+    forcing.grass_digestibility = bad_digestibility;
+    CHECK_THROWS(habitat.init_day(4));
+  }
+
+  SECTION("Forcing unset") {
+    habitat.set_forcing(NULL);
+    CHECK_THROWS_AS(habitat.remove_eaten_forage(ForageMass(1.0)),
+                    std::logic_error);
+    // Today’s values remain available.
+    CHECK(habitat.get_available_forage().grass.get_mass() == 100.0);
+  }
+}
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Binary streams to save and restore the simulation state.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "checkpoint.h"
+
+#include <cstdint>
+#include <fstream>
+
+#include "datapoint.h"
+
+using namespace Fauna;
+
+//============================================================
+// CheckpointWriter
+//============================================================
+
+void CheckpointWriter::write(const std::string& value) {
+  write((std::uint64_t)value.size());
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void CheckpointWriter::write(const Output::HerbivoreData& value) {
+  // -> Add new output variables here.
+  write(value.age_years);
+  write(value.bodyfat);
+  write(value.eaten_forage_per_ind);
+  write(value.eaten_forage_per_mass);
+  write(value.eaten_nitrogen_per_ind);
+  write(value.energy_content);
+  write(value.energy_intake_per_ind);
+  write(value.energy_intake_per_mass);
+  write(value.expenditure);
+  write(value.inddens);
+  write(value.massdens);
+  write(value.offspring);
+  write((std::uint64_t)value.mortality.size());
+  for (const auto& i : value.mortality) {
+    write(i.first);
+    write(i.second);
+  }
+}
+
+void CheckpointWriter::write(const Output::CombinedData& value) {
+  write(value.datapoint_count);
+  write(value.habitat_data);
+  write((std::uint64_t)value.hft_data.size());
+  for (const auto& i : value.hft_data) {
+    write(i.first);
+    write(i.second);
+  }
+}
+
+void CheckpointWriter::write(const Output::Datapoint& value) {
+  write(value.aggregation_unit);
+  write(value.data);
+  write(value.interval);
+}
+
+void CheckpointWriter::write_to_file(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  file.write(buffer.data(), buffer.size());
+  if (!file.good())
+    throw std::runtime_error(
+        "Fauna::CheckpointWriter::write_to_file() "
+        "Could not write checkpoint file \"" +
+        filename + "\".");
+}
+
+//============================================================
+// CheckpointReader
+//============================================================
+
+CheckpointReader::CheckpointReader(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file.good())
+    throw std::runtime_error(
+        "Fauna::CheckpointReader::CheckpointReader() "
+        "Could not open checkpoint file \"" +
+        filename + "\".");
+  // Read the whole file at once.
+  buffer.resize(file.tellg());
+  file.seekg(0);
+  file.read(buffer.data(), buffer.size());
+  if (!file.good())
+    throw std::runtime_error(
+        "Fauna::CheckpointReader::CheckpointReader() "
+        "Could not read checkpoint file \"" +
+        filename + "\".");
+}
+
+void CheckpointReader::check_remaining(const std::uint64_t count,
+                                       const std::size_t element_size) const {
+  if (count > (buffer.size() - position) / element_size)
+    throw std::runtime_error(
+        "Fauna::CheckpointReader "
+        "Unexpected end of checkpoint data.");
+}
+
+void CheckpointReader::read(std::string& value) {
+  std::uint64_t size;
+  read(size);
+  check_remaining(size);
+  value.assign(buffer.data() + position, size);
+  position += size;
+}
+
+void CheckpointReader::read(Output::HerbivoreData& value) {
+  // -> Add new output variables here.
+  read(value.age_years);
+  read(value.bodyfat);
+  read(value.eaten_forage_per_ind);
+  read(value.eaten_forage_per_mass);
+  read(value.eaten_nitrogen_per_ind);
+  read(value.energy_content);
+  read(value.energy_intake_per_ind);
+  read(value.energy_intake_per_mass);
+  read(value.expenditure);
+  read(value.inddens);
+  read(value.massdens);
+  read(value.offspring);
+  std::uint64_t size;
+  read(size);
+  value.mortality.clear();
+  for (std::uint64_t i = 0; i < size; i++) {
+    MortalityFactor factor;
+    double rate;
+    read(factor);
+    read(rate);
+    value.mortality[factor] = rate;
+  }
+}
+
+void CheckpointReader::read(Output::CombinedData& value) {
+  read(value.datapoint_count);
+  read(value.habitat_data);
+  std::uint64_t size;
+  read(size);
+  value.hft_data.clear();
+  for (std::uint64_t i = 0; i < size; i++) {
+    std::string name;
+    read(name);
+    read(value.hft_data[name]);
+  }
+}
+
+void CheckpointReader::read(Output::Datapoint& value) {
+  read(value.aggregation_unit);
+  read(value.data);
+  read(value.interval);
+}
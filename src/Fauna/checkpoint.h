@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Binary streams to save and restore the simulation state.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_CHECKPOINT_H
+#define FAUNA_CHECKPOINT_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Fauna {
+// Forward declarations
+namespace Output {
+struct CombinedData;
+struct Datapoint;
+struct HerbivoreData;
+}  // namespace Output
+
+/// Collects the binary state of the simulation in memory.
+/**
+ * Classes with a dynamic state implement a function `save_state()`, which
+ * appends all member variables to this object. The counterpart
+ * `load_state()` reads them in exactly the same order from a
+ * \ref CheckpointReader.
+ *
+ * Values of trivially copyable types (numbers, enums, and simple classes
+ * like \ref Date or \ref HabitatForage) are copied byte by byte. The data is
+ * therefore not portable between platforms with different byte order or
+ * floating point representation. \ref World::save_checkpoint() writes a
+ * header to detect that.
+ */
+class CheckpointWriter {
+ public:
+  /// Append a value of a trivially copyable type.
+  template <class T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be copied bytewise.");
+    static_assert(!std::is_pointer<T>::value,
+                  "The address of a pointer is meaningless in a checkpoint.");
+    const char* p = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), p, p + sizeof(T));
+  }
+
+  /// Append a string with its length.
+  void write(const std::string& value);
+
+  /// Append a vector of numbers with its length.
+  template <class T>
+  void write(const std::vector<T>& value) {
+    static_assert(std::is_arithmetic<T>::value,
+                  "Only vectors of numbers can be copied bytewise.");
+    write((std::uint64_t)value.size());
+    const char* p = reinterpret_cast<const char*>(value.data());
+    buffer.insert(buffer.end(), p, p + value.size() * sizeof(T));
+  }
+
+  /// Append all member variables of an output container.
+  void write(const Output::HerbivoreData& value);
+
+  /** \copydoc write(const Output::HerbivoreData&) */
+  void write(const Output::CombinedData& value);
+
+  /** \copydoc write(const Output::HerbivoreData&) */
+  void write(const Output::Datapoint& value);
+
+  /// The binary data collected so far.
+  const std::vector<char>& get_buffer() const { return buffer; }
+
+  /// Write the complete buffer to a file.
+  /**
+   * An existing file will be overwritten.
+   * \throw std::runtime_error If the file cannot be written.
+   */
+  void write_to_file(const std::string& filename) const;
+
+ private:
+  std::vector<char> buffer;
+};
+
+/// Reads binary simulation state written by \ref CheckpointWriter.
+/**
+ * The whole checkpoint is read into memory at once. All `read()` functions
+ * then only copy from that buffer.
+ */
+class CheckpointReader {
+ public:
+  /// Constructor: Take a buffer, for instance from a \ref CheckpointWriter.
+  CheckpointReader(const std::vector<char>& buffer) : buffer(buffer) {}
+
+  /// Constructor: Read the complete file into memory.
+  /**
+   * \throw std::runtime_error If the file cannot be read.
+   */
+  CheckpointReader(const std::string& filename);
+
+  /// Whether all data has been read.
+  bool at_end() const { return position == buffer.size(); }
+
+  /// Read a value of a trivially copyable type.
+  /**
+   * \throw std::runtime_error If the end of the data has been reached.
+   */
+  template <class T>
+  void read(T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be copied bytewise.");
+    check_remaining(sizeof(T));
+    std::memcpy(&value, buffer.data() + position, sizeof(T));
+    position += sizeof(T);
+  }
+
+  /** \copydoc read(T&) */
+  void read(std::string& value);
+
+  /** \copydoc read(T&) */
+  template <class T>
+  void read(std::vector<T>& value) {
+    static_assert(std::is_arithmetic<T>::value,
+                  "Only vectors of numbers can be copied bytewise.");
+    std::uint64_t size;
+    read(size);
+    check_remaining(size, sizeof(T));
+    value.resize(size);
+    std::memcpy(value.data(), buffer.data() + position, size * sizeof(T));
+    position += size * sizeof(T);
+  }
+
+  /** \copydoc read(T&) */
+  void read(Output::HerbivoreData& value);
+
+  /** \copydoc read(T&) */
+  void read(Output::CombinedData& value);
+
+  /** \copydoc read(T&) */
+  void read(Output::Datapoint& value);
+
+ private:
+  /// Throw an exception if fewer than `count` elements are left to read.
+  /**
+   * The count is compared without multiplication, so that a corrupt size
+   * cannot overflow.
+   * \param count Number of elements, read from the checkpoint.
+   * \param element_size Size of one element [bytes].
+   */
+  void check_remaining(const std::uint64_t count,
+                       const std::size_t element_size = 1) const;
+
+  std::vector<char> buffer;
+  std::size_t position = 0;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_CHECKPOINT_H
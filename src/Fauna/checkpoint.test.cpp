@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for checkpoint binary streams.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "checkpoint.h"
+
+#include "average.h"
+#include "catch.hpp"
+#include "datapoint.h"
+#include "date.h"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::CheckpointWriter, Fauna::CheckpointReader", "") {
+  CheckpointWriter out;
+
+  SECTION("Simple values") {
+    out.write(42);
+    out.write(3.14);
+    out.write(true);
+    out.write(Date(12, 2000));
+    out.write(std::string("hello"));
+    out.write(std::vector<double>{1.0, 2.0, 3.0});
+    out.write(std::vector<float>{4.0f, 5.0f});
+
+    CheckpointReader in(out.get_buffer());
+    int i;
+    double d;
+    bool b;
+    Date date(0, 0);
+    std::string s;
+    std::vector<double> v;
+    std::vector<float> f;
+    in.read(i);
+    in.read(d);
+    in.read(b);
+    in.read(date);
+    in.read(s);
+    in.read(v);
+    in.read(f);
+    CHECK(i == 42);
+    CHECK(d == 3.14);
+    CHECK(b);
+    CHECK(date == Date(12, 2000));
+    CHECK(s == "hello");
+    CHECK(v == std::vector<double>({1.0, 2.0, 3.0}));
+    CHECK(f == std::vector<float>({4.0f, 5.0f}));
+    CHECK(in.at_end());
+    CHECK_THROWS_AS(in.read(i), std::runtime_error);
+  }
+
+  SECTION("Truncated data") {
+    out.write(std::string("hello"));
+    std::vector<char> buffer = out.get_buffer();
+    buffer.pop_back();
+    CheckpointReader in(buffer);
+    std::string s;
+    CHECK_THROWS_AS(in.read(s), std::runtime_error);
+  }
+
+  SECTION("Corrupt vector size") {
+    // The size times 8 bytes overflows to 8 bytes, which are available.
+    out.write((std::uint64_t)((1ULL << 61) + 1));
+    out.write(1.0);
+    CheckpointReader in(out.get_buffer());
+    std::vector<double> v;
+    CHECK_THROWS_AS(in.read(v), std::runtime_error);
+  }
+
+  SECTION("Output data") {
+    Output::Datapoint datapoint;
+    datapoint.aggregation_unit = "unit";
+    datapoint.interval = DateInterval(Date(0, 1), Date(10, 1));
+    datapoint.data.datapoint_count = 3;
+    datapoint.data.habitat_data.environment.air_temperature = -5.0;
+    Output::HerbivoreData& herbi = datapoint.data.hft_data["hft"];
+    herbi.inddens = 7.0;
+    herbi.mortality[MortalityFactor::Background] = 0.1;
+    herbi.eaten_forage_per_ind[ForageType::Grass] = 2.0;
+    out.write(datapoint);
+
+    CheckpointReader in(out.get_buffer());
+    Output::Datapoint result;
+    in.read(result);
+    CHECK(in.at_end());
+    CHECK(result.aggregation_unit == "unit");
+    CHECK(result.interval.get_first() == Date(0, 1));
+    CHECK(result.interval.get_last() == Date(10, 1));
+    CHECK(result.data.datapoint_count == 3);
+    CHECK(result.data.habitat_data.environment.air_temperature == -5.0);
+    REQUIRE(result.data.hft_data.count("hft"));
+    const Output::HerbivoreData& result_herbi = result.data.hft_data["hft"];
+    CHECK(result_herbi.inddens == 7.0);
+    CHECK(result_herbi.mortality.at(MortalityFactor::Background) == 0.1);
+    CHECK(result_herbi.eaten_forage_per_ind[ForageType::Grass] == 2.0);
+  }
+
+  SECTION("PeriodAverage") {
+    PeriodAverage pa(3);
+    pa.add_value(1.0);
+    pa.add_value(2.0);
+    pa.save_state(out);
+
+    PeriodAverage restored(10);
+    CheckpointReader in(out.get_buffer());
+    restored.load_state(in);
+    CHECK(restored.get_average() == pa.get_average());
+    CHECK(restored.get_first() == pa.get_first());
+    // The buffer continues cycling like the original.
+    pa.add_value(3.0);
+    pa.add_value(4.0);
+    restored.add_value(3.0);
+    restored.add_value(4.0);
+    CHECK(restored.get_average() == pa.get_average());
+    CHECK(restored.get_first() == pa.get_first());
+  }
+}
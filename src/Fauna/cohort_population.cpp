@@ -10,13 +10,21 @@
  */
 #include "cohort_population.h"
 
+#include "checkpoint.h"
 #include "herbivore_cohort.h"
 #include "hft.h"
 
 using namespace Fauna;
 
 CohortPopulation::CohortPopulation(const CreateHerbivoreCohort create_cohort)
-    : create_cohort(create_cohort) {}
+    : create_cohort(create_cohort), list(List::allocator_type(&pool)) {}
+
+void CohortPopulation::add_memory_usage(MemoryUsage& usage) const {
+  PopulationInterface::add_memory_usage(usage);
+  usage.populations += sizeof(*this);
+  usage.cohorts += pool.get_statistics().bytes;
+  for (const auto& cohort : list) usage.cohorts += cohort.get_heap_bytes();
+}
 
 void CohortPopulation::create_offspring_by_sex(const Sex sex,
                                                double ind_per_km2) {
@@ -46,7 +54,7 @@ void CohortPopulation::create_offspring(const double ind_per_km2) {
 }
 
 void CohortPopulation::establish() {
-  if (!get_list().empty())
+  if (!empty())
     throw std::logic_error(
         "Fauna::CohortPopulation::establish() "
         "Trying to establish into a non-empty population.");
@@ -88,6 +96,16 @@ CohortPopulation::List::iterator CohortPopulation::find_cohort(
   return list.end();  // not found
 }
 
+void CohortPopulation::for_each(
+    const std::function<void(const HerbivoreInterface&)>& function) const {
+  for (const auto& cohort : list) function(cohort);
+}
+
+void CohortPopulation::for_each(
+    const std::function<void(HerbivoreInterface&)>& function) {
+  for (auto& cohort : list) function(cohort);
+}
+
 ConstHerbivoreVector CohortPopulation::get_list() const {
   // We just copy the pointers from the cohort list to the HerbivoreInterface
   // list.
@@ -118,6 +136,21 @@ void CohortPopulation::kill_nonviable() {
   if (get_ind_per_km2() < min_ind_per_km2) kill_all();
 }
 
+void CohortPopulation::load_state(CheckpointReader& in) {
+  std::uint64_t size;
+  in.read(size);
+  list.clear();
+  pool.release();
+  for (std::uint64_t i = 0; i < size; i++) {
+    Sex sex;
+    in.read(sex);
+    // The birth constructor sets all constant members. The variable state is
+    // then overwritten from the checkpoint.
+    list.push_back(create_cohort(1.0, 0, sex));
+    list.back().load_state(in);
+  }
+}
+
 void CohortPopulation::purge_of_dead() {
   List::iterator itr = list.begin();
   while (itr != list.end()) {
@@ -126,4 +159,14 @@ void CohortPopulation::purge_of_dead() {
     else
       itr++;
   }
+  // Release memory in bulk when the population has died out.
+  if (list.empty()) pool.release();
+}
+
+void CohortPopulation::save_state(CheckpointWriter& out) const {
+  out.write((std::uint64_t)list.size());
+  for (const auto& cohort : list) {
+    out.write(cohort.get_sex());
+    cohort.save_state(out);
+  }
 }
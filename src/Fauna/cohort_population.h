@@ -14,6 +14,7 @@
 #include <list>
 
 #include "create_herbivore_cohort.h"
+#include "node_pool.h"
 #include "population_interface.h"
 
 namespace Fauna {
@@ -22,7 +23,18 @@ namespace Fauna {
 enum class Sex;
 
 /// A population of \ref HerbivoreCohort objects.
-class CohortPopulation : public PopulationInterface {
+/**
+ * The cohorts are list nodes taken from a \ref NodePool owned by the
+ * population. Purged cohorts leave their memory in the pool for the next
+ * offspring, and all memory is released when the population dies out or is
+ * destroyed with its simulation unit.
+ * \see \ref sec_design_node_pools
+ *
+ * \ref StaticSimulateDay uses \ref Herbivore and \ref for_each_herbivore()
+ * to simulate the cohorts without virtual function calls.
+ * \see \ref sec_design_static_dispatch
+ */
+class CohortPopulation final : public PopulationInterface {
  public:  // ------ PopulationInterface -------
   /** \copydoc PopulationInterface::create_offspring() */
   virtual void create_offspring(const double ind_per_km2);
@@ -35,11 +47,42 @@ class CohortPopulation : public PopulationInterface {
    */
   virtual void establish();
 
+  /** \copydoc PopulationInterface::add_memory_usage()
+   * The cohorts are counted with the reserved memory of the \ref NodePool.
+   */
+  virtual void add_memory_usage(MemoryUsage& usage) const;
+
+  virtual void for_each(
+      const std::function<void(const HerbivoreInterface&)>& function) const;
+  virtual void for_each(
+      const std::function<void(HerbivoreInterface&)>& function);
   virtual const Hft& get_hft() const { return create_cohort.get_hft(); }
   virtual ConstHerbivoreVector get_list() const;
   virtual HerbivoreVector get_list();
+  virtual PoolStatistics get_pool_statistics() const {
+    return pool.get_statistics();
+  }
   virtual void kill_nonviable();
+  virtual void load_state(CheckpointReader& in);
   virtual void purge_of_dead();
+  virtual void save_state(CheckpointWriter& out) const;
+  virtual std::size_t size() const { return list.size(); }
+
+ public:  // ------ Static dispatch -------
+  /// The class of the herbivores in this population.
+  typedef HerbivoreCohort Herbivore;
+
+  /// Call a function for each cohort (including dead ones).
+  /**
+   * Unlike \ref for_each(), this is resolved at compile time and can be
+   * inlined.
+   * \param function Called with a `HerbivoreCohort&`. It must not change
+   * the population.
+   */
+  template <class Function>
+  void for_each_herbivore(Function function) {
+    for (auto& cohort : list) function(cohort);
+  }
 
  public:
   /// Constructor
@@ -50,8 +93,11 @@ class CohortPopulation : public PopulationInterface {
    */
   CohortPopulation(const CreateHerbivoreCohort create_cohort);
 
+  CohortPopulation(const CohortPopulation&) = delete;
+  CohortPopulation& operator=(const CohortPopulation&) = delete;
+
  private:
-  typedef std::list<HerbivoreCohort> List;
+  typedef std::list<HerbivoreCohort, PoolAllocator<HerbivoreCohort> > List;
 
   /// Add newborn animals to the population either males or females.
   /**
@@ -75,6 +121,8 @@ class CohortPopulation : public PopulationInterface {
   List::iterator find_cohort(const int age_years, const Sex sex);
 
   const CreateHerbivoreCohort create_cohort;
+  /// Memory for the list nodes; declared before \ref list to outlive it.
+  NodePool pool;
   /// Offspring accumulated until above minimum threshold [ind/km²].
   List list;
 };
@@ -73,6 +73,28 @@ TEST_CASE("Fauna::CohortPopulation", "") {
       REQUIRE(pop.get_ind_per_km2() == Approx(hft->establishment_density));
     }
 
+    SECTION("Pool memory") {
+      hft->establishment_age_range.first = 3;
+      hft->establishment_age_range.second = 6;
+      pop.establish();
+      CHECK(pop.get_pool_statistics().in_use == pop.size());
+      CHECK(pop.get_pool_statistics().chunks > 0);
+      CHECK(pop.get_pool_statistics().reuses == 0);
+
+      // The memory of purged cohorts is reused for offspring.
+      pop.get_list().front()->kill();
+      pop.purge_of_dead();
+      pop.create_offspring(1.0);
+      CHECK(pop.get_pool_statistics().reuses > 0);
+
+      // The memory of the extinct population is released in bulk.
+      pop.kill_all();
+      pop.purge_of_dead();
+      CHECK(pop.get_pool_statistics().in_use == 0);
+      CHECK(pop.get_pool_statistics().chunks == 0);
+      CHECK(pop.get_pool_statistics().bytes == 0);
+    }
+
     SECTION("Removal of dead cohorts with mortality") {
       // we will kill all herbivores in the list with a copy
       // assignment trick
@@ -29,10 +29,10 @@ HerbivoreCohort CreateHerbivoreCohort::operator()(const double ind_per_km2,
   const int age_days = age_years * 365;
   if (age_days == 0)
     // Call birth constructor
-    return HerbivoreCohort(hft, sex, ind_per_km2,
+    return HerbivoreCohort(*hft, sex, ind_per_km2,
                            get_params().forage_gross_energy);
   else
     // Call establishment constructor
-    return HerbivoreCohort(age_days, get_body_condition(age_days), hft, sex,
+    return HerbivoreCohort(age_days, get_body_condition(age_days), *hft, sex,
                            ind_per_km2, get_params().forage_gross_energy);
 }
@@ -126,6 +126,11 @@ unsigned int Date::get_month(const bool leap_year) const {
     return 11;
 }
 
+Date Date::get_next() const {
+  if (get_julian_day() >= 364) return Date(0, get_year() + 1);
+  return Date(get_julian_day() + 1, get_year());
+}
+
 bool Date::is_successive(const Date& other_date) const {
   // One day follows within one year.
   if ((other_date.get_year() == this->get_year()) &&
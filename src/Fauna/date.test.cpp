@@ -54,6 +54,16 @@ TEST_CASE("Fauna::Date", "") {
       }
   }
 
+  SECTION("get_next()") {
+    for (int day = 0; day < 366; day++) {
+      const Date date(day, 5);
+      CHECK(date.is_successive(date.get_next()));
+    }
+    CHECK(Date(364, 5).get_next() == Date(0, 6));
+    CHECK(Date(365, 5).get_next() == Date(0, 6));
+    CHECK(Date(3, -1).get_next() == Date(4, -1));
+  }
+
   SECTION("equal dates") {
     CHECK(Date(0, 0) == Date(0, 0));
     CHECK(Date(1, 0) == Date(1, 0));
@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Detect when herbivore populations have reached an equilibrium.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "equilibrium_monitor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "checkpoint.h"
+#include "combined_data.h"
+#include "date.h"
+
+using namespace Fauna;
+
+namespace {
+/// Last day of the year as simulated by \ref SimulateDay.
+const unsigned int LAST_DAY_OF_YEAR = 364;
+
+/// Relative change between two non-negative values.
+double get_relative_change(const double a, const double b) {
+  const double max = std::max(std::abs(a), std::abs(b));
+  if (max == 0.0) return 0.0;
+  return std::abs(a - b) / max;
+}
+}  // namespace
+
+void EquilibriumMonitor::add_day(const Date& today,
+                                 const Output::CombinedData& output) {
+  // A gap in the dates or a new year before the last one was complete.
+  if (day_count > 0 && today.get_year() != current_year) {
+    current_sums.clear();
+    day_count = 0;
+  }
+  // Only start summing up on the first day of a year.
+  if (day_count == 0) {
+    if (today.get_julian_day() != 0) return;
+    current_year = today.get_year();
+  }
+
+  for (const auto& itr : output.hft_data) {
+    Densities& sums = current_sums[itr.first];
+    sums.inddens += itr.second.inddens;
+    sums.massdens += itr.second.massdens;
+  }
+  day_count++;
+
+  if (today.get_julian_day() == LAST_DAY_OF_YEAR) complete_year();
+}
+
+void EquilibriumMonitor::complete_year() {
+  assert(day_count > 0);
+  DensityMap means = current_sums;
+  for (auto& itr : means) {
+    itr.second.inddens /= day_count;
+    itr.second.massdens /= day_count;
+  }
+
+  if (has_last_means) {
+    // HFTs that are missing in one of the years have zero density there.
+    DensityMap all_hfts = means;
+    all_hfts.insert(last_means.begin(), last_means.end());
+    double change = 0.0;
+    for (const auto& itr : all_hfts) {
+      const Densities& now = means[itr.first];
+      const Densities& before = last_means[itr.first];
+      change =
+          std::max(change, get_relative_change(now.inddens, before.inddens));
+      change =
+          std::max(change, get_relative_change(now.massdens, before.massdens));
+    }
+    changes.push_back(change);
+  }
+
+  last_means = means;
+  has_last_means = true;
+  current_sums.clear();
+  day_count = 0;
+}
+
+int EquilibriumMonitor::get_converged_years(const double tolerance) const {
+  int years = 0;
+  for (auto itr = changes.rbegin(); itr != changes.rend(); itr++) {
+    if (*itr > tolerance) break;
+    years++;
+  }
+  return years;
+}
+
+double EquilibriumMonitor::get_last_change() const {
+  if (changes.empty())
+    throw std::logic_error(
+        "Fauna::EquilibriumMonitor::get_last_change() "
+        "Fewer than two complete years have been added.");
+  return changes.back();
+}
+
+void EquilibriumMonitor::load_state(CheckpointReader& in) {
+  in.read(changes);
+  in.read(current_year);
+  in.read(day_count);
+  read(in, current_sums);
+  in.read(has_last_means);
+  read(in, last_means);
+}
+
+void EquilibriumMonitor::read(CheckpointReader& in, DensityMap& map) {
+  std::uint64_t size;
+  in.read(size);
+  map.clear();
+  for (std::uint64_t i = 0; i < size; i++) {
+    std::string name;
+    in.read(name);
+    in.read(map[name]);
+  }
+}
+
+void EquilibriumMonitor::reset() {
+  changes.clear();
+  current_year = 0;
+  day_count = 0;
+  current_sums.clear();
+  has_last_means = false;
+  last_means.clear();
+}
+
+void EquilibriumMonitor::save_state(CheckpointWriter& out) const {
+  out.write(changes);
+  out.write(current_year);
+  out.write(day_count);
+  write(out, current_sums);
+  out.write(has_last_means);
+  write(out, last_means);
+}
+
+void EquilibriumMonitor::write(CheckpointWriter& out, const DensityMap& map) {
+  out.write((std::uint64_t)map.size());
+  for (const auto& itr : map) {
+    out.write(itr.first);
+    out.write(itr.second);
+  }
+}
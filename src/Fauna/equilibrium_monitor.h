@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Detect when herbivore populations have reached an equilibrium.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_EQUILIBRIUM_MONITOR_H
+#define FAUNA_EQUILIBRIUM_MONITOR_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Fauna {
+// Forward declarations
+class CheckpointReader;
+class CheckpointWriter;
+class Date;
+
+namespace Output {
+struct CombinedData;
+}
+
+/// Tracks the year-to-year change of herbivore densities in one habitat.
+/**
+ * The daily output of a \ref SimulationUnit is averaged over each calendar
+ * year. Once a year is completed, its annual means of individual density and
+ * mass density for each HFT are compared with those of the previous year.
+ * The largest relative change across all HFTs and both variables is recorded
+ * as the change of that year.
+ *
+ * The relative change of two values \f$a\f$ and \f$b\f$ is
+ * \f$|a-b| / max(|a|, |b|)\f$, or zero if both are zero.
+ *
+ * Only years that have been simulated on every day count as complete. So a
+ * simulation that starts in the middle of a year doesn’t produce a spurious
+ * change in the first year.
+ *
+ * \see \ref World::enable_equilibrium_monitor()
+ */
+class EquilibriumMonitor {
+ public:
+  /// Add the output of one simulation day.
+  /**
+   * \param today The simulation day. The days must be added in consecutive
+   * order.
+   * \param output The output of the simulation unit on that day.
+   */
+  void add_day(const Date& today, const Output::CombinedData& output);
+
+  /// Number of the latest consecutive years with change below the tolerance.
+  /**
+   * \param tolerance Maximum relative change between two years.
+   * \return Zero if fewer than two complete years have been added.
+   */
+  int get_converged_years(const double tolerance) const;
+
+  /// The relative change of the last complete year to the previous year.
+  /**
+   * \throw std::logic_error If fewer than two complete years have been
+   * added.
+   */
+  double get_last_change() const;
+
+  /// Whether the populations have been stable for long enough.
+  /**
+   * \param tolerance Maximum relative change between two years.
+   * \param years Number of consecutive years that must be below the
+   * tolerance.
+   */
+  bool is_converged(const double tolerance, const int years) const {
+    return get_converged_years(tolerance) >= years;
+  }
+
+  /// Restore the state from a checkpoint.
+  /** \throw std::runtime_error If the checkpoint data is corrupt. */
+  void load_state(CheckpointReader& in);
+
+  /// Forget all data added so far.
+  void reset();
+
+  /// Append the state to a checkpoint.
+  void save_state(CheckpointWriter& out) const;
+
+ private:
+  /// Sums or means of the monitored variables for one HFT.
+  struct Densities {
+    /// Individual density [ind/km²].
+    double inddens = 0.0;
+    /// Mass density [kg/km²].
+    double massdens = 0.0;
+  };
+
+  /// Densities per HFT name.
+  typedef std::map<std::string, Densities> DensityMap;
+
+  /// Read a \ref DensityMap from a checkpoint.
+  static void read(CheckpointReader& in, DensityMap& map);
+
+  /// Append a \ref DensityMap to a checkpoint.
+  static void write(CheckpointWriter& out, const DensityMap& map);
+
+  /// Calculate annual means of the current year and compare with last year.
+  void complete_year();
+
+  /// Relative changes of each complete year to its previous year.
+  std::vector<double> changes;
+
+  /// Calendar year of the days being summed up in \ref current_sums.
+  int current_year = 0;
+
+  /// Number of days added to \ref current_sums.
+  int day_count = 0;
+
+  /// Daily values summed up over the current year.
+  DensityMap current_sums;
+
+  /// Whether \ref last_means contains data of a complete year.
+  bool has_last_means = false;
+
+  /// Annual means of the last complete year.
+  DensityMap last_means;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_EQUILIBRIUM_MONITOR_H
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::EquilibriumMonitor.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "equilibrium_monitor.h"
+
+#include "catch.hpp"
+#include "checkpoint.h"
+#include "combined_data.h"
+#include "date.h"
+
+using namespace Fauna;
+
+namespace {
+/// Add one complete year with constant densities of one HFT.
+void add_year(EquilibriumMonitor& monitor, const int year,
+              const double inddens, const double massdens = 1.0) {
+  Output::CombinedData output;
+  output.hft_data["hft"].inddens = inddens;
+  output.hft_data["hft"].massdens = massdens;
+  for (int day = 0; day < 365; day++)
+    monitor.add_day(Date(day, year), output);
+}
+}  // namespace
+
+TEST_CASE("Fauna::EquilibriumMonitor", "") {
+  EquilibriumMonitor monitor;
+  CHECK(monitor.get_converged_years(0.0) == 0);
+  CHECK_THROWS(monitor.get_last_change());
+
+  SECTION("Incomplete years are ignored") {
+    Output::CombinedData output;
+    output.hft_data["hft"].inddens = 100.0;
+    for (int day = 100; day < 365; day++)
+      monitor.add_day(Date(day, 0), output);
+    add_year(monitor, 1, 1.0);
+    CHECK_THROWS(monitor.get_last_change());
+    add_year(monitor, 2, 1.0);
+    CHECK(monitor.get_last_change() == 0.0);
+  }
+
+  SECTION("Relative change") {
+    add_year(monitor, 0, 10.0);
+    add_year(monitor, 1, 8.0);
+    CHECK(monitor.get_last_change() == Approx(0.2));
+    CHECK(monitor.get_converged_years(0.1) == 0);
+    CHECK(monitor.get_converged_years(0.2) == 1);
+
+    // Mass density changes more than individual density.
+    add_year(monitor, 2, 8.0, 0.5);
+    CHECK(monitor.get_last_change() == Approx(0.5));
+
+    add_year(monitor, 3, 8.0, 0.5);
+    add_year(monitor, 4, 8.0, 0.5);
+    CHECK(monitor.get_converged_years(0.1) == 2);
+    CHECK(monitor.is_converged(0.1, 2));
+    CHECK(!monitor.is_converged(0.1, 3));
+    CHECK(monitor.get_converged_years(1.0) == 4);
+  }
+
+  SECTION("Extinct HFT") {
+    add_year(monitor, 0, 10.0);
+    Output::CombinedData empty;
+    for (int day = 0; day < 365; day++) monitor.add_day(Date(day, 1), empty);
+    CHECK(monitor.get_last_change() == 1.0);
+    for (int day = 0; day < 365; day++) monitor.add_day(Date(day, 2), empty);
+    CHECK(monitor.get_last_change() == 0.0);
+  }
+
+  SECTION("Reset") {
+    add_year(monitor, 0, 10.0);
+    add_year(monitor, 1, 10.0);
+    monitor.reset();
+    CHECK_THROWS(monitor.get_last_change());
+  }
+
+  SECTION("Checkpoint") {
+    add_year(monitor, 0, 10.0);
+    add_year(monitor, 1, 10.0);
+    CheckpointWriter out;
+    monitor.save_state(out);
+    EquilibriumMonitor restored;
+    CheckpointReader in(out.get_buffer());
+    restored.load_state(in);
+    CHECK(in.at_end());
+    add_year(monitor, 2, 5.0);
+    add_year(restored, 2, 5.0);
+    CHECK(restored.get_last_change() == monitor.get_last_change());
+    CHECK(restored.get_converged_years(1.0) == 2);
+  }
+}
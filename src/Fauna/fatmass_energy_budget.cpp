@@ -63,7 +63,7 @@ void FatmassEnergyBudget::catabolize_fat() {
   const double burned_fatmass = energy_needs / catabolism_coefficient;
 
   /// Fat mass never drops below zero.
-  fatmass = std::max(0.0, fatmass - burned_fatmass);
+  fatmass = std::max<double>(0.0, fatmass - burned_fatmass);
   assert(fatmass >= 0.0);
 
   energy_needs = 0.0;
@@ -85,7 +85,7 @@ double FatmassEnergyBudget::get_max_anabolism_per_day() const {
 
   // If there is a limit set, decrease `increment`.
   if (max_fatmass_gain != 0.0)
-    increment = std::min(max_fatmass_gain, increment);
+    increment = std::min<double>(max_fatmass_gain, increment);
 
   return increment * anabolism_coefficient;
 }
@@ -130,13 +130,15 @@ void FatmassEnergyBudget::metabolize_energy(double energy) {
     // increase fat reserves
     // If fat mass gain exceeds maximum fat mass (rounding errors), only
     // increase up to the maximum.
-    fatmass = std::min(fatmass + fatmass_gain, max_fatmass);
+    fatmass = std::min<double>(fatmass + fatmass_gain, max_fatmass);
   }
 }
 
 void FatmassEnergyBudget::set_max_fatmass(const double _max_fatmass,
                                           const double max_gain) {
-  if (_max_fatmass < fatmass)
+  // Compare in storage precision so that rounding of the stored fat mass
+  // does not make it exceed an equal maximum.
+  if ((StorageReal)_max_fatmass < fatmass)
     throw std::logic_error(
         "Fauna::FatmassEnergyBudget::set_max_fatmass() "
         "Maximum fat mass is lower than current fat mass.");
@@ -11,6 +11,8 @@
 #ifndef FAUNA_FATMASS_ENERGY_BUDGET_H
 #define FAUNA_FATMASS_ENERGY_BUDGET_H
 
+#include "Fauna/storage_real.h"
+
 namespace Fauna {
 
 /// A herbivore’s energy budget with fat reserves
@@ -103,10 +105,10 @@ class FatmassEnergyBudget {
  private:
   double anabolism_coefficient;   // MJ/kg
   double catabolism_coefficient;  // MJ/kg
-  double energy_needs = 0.0;      // MJ/ind
-  double fatmass;                 // kg/ind
-  double max_fatmass;             // kg/ind
-  double max_fatmass_gain = 0.0;  // kg/ind/day
+  StorageReal energy_needs = 0.0;      // MJ/ind
+  StorageReal fatmass;                 // kg/ind
+  StorageReal max_fatmass;             // kg/ind
+  StorageReal max_fatmass_gain = 0.0;  // kg/ind/day
 };
 }  // namespace Fauna
 #endif  // FAUNA_FATMASS_ENERGY_BUDGET_H
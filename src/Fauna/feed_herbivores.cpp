@@ -12,12 +12,15 @@
 
 #include "forage_distribution_algorithms.h"
 #include "habitat_forage.h"
+#include "herbivore_cohort.h"
 #include "herbivore_interface.h"
+#include "scoped_timer.h"
 
 using namespace Fauna;
 
-FeedHerbivores::FeedHerbivores(DistributeForage* _distribute_forage)
-    : distribute_forage(_distribute_forage) {
+FeedHerbivores::FeedHerbivores(DistributeForage* _distribute_forage,
+                               Profile* profile)
+    : distribute_forage(_distribute_forage), profile(profile) {
   if (distribute_forage.get() == NULL)
     throw std::invalid_argument(
         "Fauna::FeedHerbivores::FeedHerbivores() "
@@ -28,6 +31,12 @@ FeedHerbivores::~FeedHerbivores(){};
 
 void FeedHerbivores::operator()(HabitatForage& available,
                                 const HerbivoreVector& herbivores) const {
+  feed(available, herbivores);
+}
+
+template <class Herbivore>
+void FeedHerbivores::feed(HabitatForage& available,
+                          const std::vector<Herbivore*>& herbivores) const {
   // loop as many times as there are forage types
   // to allow prey switching:
   // If one forage type gets “empty” in the first loop, the
@@ -38,20 +47,29 @@ void FeedHerbivores::operator()(HabitatForage& available,
     // If there is no forage available (anymore), abort!
     if (available.get_mass() <= 0.00001) break;
 
+    if (profile) profile->feeding_iterations++;
+
     //------------------------------------------------------------
     // GET FORAGE DEMANDS
     ForageDistribution forage_demand;
     forage_demand.reserve(herbivores.size());
-    for (const auto& herbivore : herbivores) {
-      // Skip dead herbivores.
-      if (herbivore->is_dead()) continue;
-
-      // calculate forage demand for this herbivore
-      const ForageMass ind_demand = herbivore->get_forage_demands(available);
-
-      // only add those herbivores that do want to eat
-      if (!(ind_demand == 0.0)) {
-        forage_demand.emplace_back(herbivore, ind_demand);
+    // The same herbivores as in `forage_demand`, but with their own class.
+    std::vector<Herbivore*> eaters;
+    eaters.reserve(herbivores.size());
+    {
+      ScopedTimer timer(profile, ProfilePhase::FeedingDemand);
+      for (const auto& herbivore : herbivores) {
+        // Skip dead herbivores.
+        if (herbivore->is_dead()) continue;
+
+        // calculate forage demand for this herbivore
+        const ForageMass ind_demand = herbivore->get_forage_demands(available);
+
+        // only add those herbivores that do want to eat
+        if (!(ind_demand == 0.0)) {
+          forage_demand.emplace_back(herbivore, ind_demand);
+          eaters.push_back(herbivore);
+        }
       }
     }
 
@@ -60,7 +78,10 @@ void FeedHerbivores::operator()(HabitatForage& available,
 
     // get the forage distribution
     assert(distribute_forage.get() != NULL);
-    (*distribute_forage)(available, forage_demand);
+    {
+      ScopedTimer timer(profile, ProfilePhase::FeedingDistribute);
+      (*distribute_forage)(available, forage_demand);
+    }
 
     // rename variable to make clear it’s not the demands anymore
     // but the portions to feed the herbivores
@@ -68,16 +89,16 @@ void FeedHerbivores::operator()(HabitatForage& available,
 
     //------------------------------------------------------------
     // LET THE HERBIVORES EAT
+    ScopedTimer timer(profile, ProfilePhase::FeedingEat);
 
     const Digestibility digestibility = available.get_digestibility();
     const ForageFraction nitrogen_content = available.get_nitrogen_content();
 
     // Loop through all portions and feed it to the respective
     // herbivore
-    for (ForageDistribution::iterator iter = forage_portions.begin();
-         iter != forage_portions.end(); iter++) {
-      const ForageMass& portion = iter->second;  // [kgDM/km²]
-      HerbivoreInterface& herbivore = *(iter->first);
+    for (std::size_t i = 0; i < forage_portions.size(); i++) {
+      const ForageMass& portion = forage_portions[i].second;  // [kgDM/km²]
+      Herbivore& herbivore = *eaters[i];
 
       const ForageMass& nitrogen = portion * nitrogen_content;
 
@@ -96,3 +117,9 @@ void FeedHerbivores::operator()(HabitatForage& available,
     }
   }
 }
+
+// The virtual path and the static path for herbivore cohorts.
+template void FeedHerbivores::feed<HerbivoreInterface>(
+    HabitatForage&, const std::vector<HerbivoreInterface*>&) const;
+template void FeedHerbivores::feed<HerbivoreCohort>(
+    HabitatForage&, const std::vector<HerbivoreCohort*>&) const;
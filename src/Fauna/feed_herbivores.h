@@ -12,6 +12,7 @@
 #define FAUNA_FEED_HERBIVORES_H
 
 #include <memory>
+#include <vector>
 
 #include "herbivore_vector.h"
 
@@ -19,6 +20,7 @@ namespace Fauna {
 // Forward Declarations
 class DistributeForage;
 class HabitatForage;
+struct Profile;
 
 /// Function object to feed herbivores.
 class FeedHerbivores {
@@ -28,8 +30,10 @@ class FeedHerbivores {
    * \param distribute_forage Strategy object for calculating the forage
    * portions. This must be a newly created object. It will be owned by the
    * FeedHerbivores object.
+   * \param profile Run-time measurements to add to. Can be NULL if profiling
+   * is disabled.
    * \throw std::invalid_argument If `distribute_forage==NULL`. */
-  FeedHerbivores(DistributeForage* distribute_forage);
+  FeedHerbivores(DistributeForage* distribute_forage, Profile* profile = NULL);
 
   /// Delete copy constructor because of pointer ownership.
   FeedHerbivores(FeedHerbivores const&) = delete;
@@ -51,8 +55,22 @@ class FeedHerbivores {
   void operator()(HabitatForage& available,
                   const HerbivoreVector& herbivores) const;
 
+  /// Feed herbivores of one class without virtual function calls.
+  /**
+   * This does the same as \ref operator()(), which calls it with
+   * \ref HerbivoreInterface. The template is only instantiated in
+   * feed_herbivores.cpp, for \ref HerbivoreInterface and
+   * \ref HerbivoreCohort.
+   * \tparam Herbivore A class derived from \ref HerbivoreInterface.
+   * \see \ref sec_design_static_dispatch
+   */
+  template <class Herbivore>
+  void feed(HabitatForage& available,
+            const std::vector<Herbivore*>& herbivores) const;
+
  private:
   std::unique_ptr<DistributeForage> distribute_forage;
+  Profile* const profile;
 };
 
 }  // namespace Fauna
@@ -13,11 +13,15 @@
 #include <errno.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
 #if defined(_WIN32)
 #include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
 #endif
 
 void Fauna::create_directories(const std::string path, const mode_t mode) {
@@ -119,6 +123,49 @@ bool Fauna::file_exists(const std::string& path) {
   return f.good();
 }
 
+std::vector<std::string> Fauna::list_files(const std::string& path,
+                                           const std::string& extension) {
+  std::vector<std::string> names;
+#if defined(_WIN32)
+  static const char PATH_SEPARATOR = '\\';
+  struct _finddata_t entry;
+  const intptr_t handle = _findfirst((path + "\\*").c_str(), &entry);
+  if (handle == -1)
+    throw std::runtime_error(
+        "Fauna::list_files() Cannot read directory: '" + path + "'");
+  do {
+    if (!(entry.attrib & _A_SUBDIR)) names.push_back(entry.name);
+  } while (_findnext(handle, &entry) == 0);
+  _findclose(handle);
+#else
+  static const char PATH_SEPARATOR = '/';
+  DIR* dir = opendir(path.c_str());
+  if (dir == NULL)
+    throw std::runtime_error(
+        "Fauna::list_files() Cannot read directory: '" + path + "'");
+  while (const struct dirent* entry = readdir(dir)) {
+    const std::string name = entry->d_name;
+    struct stat info;
+    const std::string full_path = path + PATH_SEPARATOR + name;
+    if (stat(full_path.c_str(), &info) == 0 && S_ISREG(info.st_mode))
+      names.push_back(name);
+  }
+  closedir(dir);
+#endif
+  std::vector<std::string> result;
+  std::sort(names.begin(), names.end());
+  for (const auto& name : names)
+    if (name.size() >= extension.size() &&
+        name.compare(name.size() - extension.size(), extension.size(),
+                     extension) == 0) {
+      if (!path.empty() && path.back() == PATH_SEPARATOR)
+        result.push_back(path + name);
+      else
+        result.push_back(path + PATH_SEPARATOR + name);
+    }
+  return result;
+}
+
 void Fauna::remove_directory(const std::string& path) {
   if (!system(NULL))
     throw std::runtime_error(
@@ -12,6 +12,7 @@
 #define FAUNA_FILESYSTEM_H
 
 #include <string>
+#include <vector>
 
 namespace Fauna {
 
@@ -41,6 +42,20 @@ bool directory_exists(const std::string path);
  */
 bool file_exists(const std::string& path);
 
+/// List the files in a directory.
+/**
+ * This function works for Windows und Unix systems. Subdirectories are not
+ * searched.
+ * \param path The absolute or relative path to the directory.
+ * \param extension If not empty, only files whose name ends with this
+ * string are listed, e.g. ".toml".
+ * \return The paths of the files (`path` joined with the file name) in
+ * alphabetical order.
+ * \throw std::runtime_error If the directory cannot be read.
+ */
+std::vector<std::string> list_files(const std::string& path,
+                                    const std::string& extension = "");
+
 /// Delete a directory recursively.
 /**
  * \warning Don’t use this function (in its current implementation) for the
@@ -95,4 +95,26 @@ TEST_CASE("Fauna::remove_directory()", "") {
   }
 }
 
+TEST_CASE("Fauna::list_files()", "") {
+  CHECK_THROWS(list_files("/this_is_a_random_string"));
+
+  static const std::string FOLDER = "list_files";
+  create_directories(FOLDER + "/subdir.toml");
+  std::ofstream(FOLDER + "/b.toml") << "content";
+  std::ofstream(FOLDER + "/a.toml") << "content";
+  std::ofstream(FOLDER + "/c.txt") << "content";
+
+  const std::vector<std::string> all = list_files(FOLDER);
+  REQUIRE(all.size() == 3);
+  CHECK(all[0] == FOLDER + "/a.toml");
+  CHECK(all[2] == FOLDER + "/c.txt");
+
+  const std::vector<std::string> toml = list_files(FOLDER + "/", ".toml");
+  REQUIRE(toml.size() == 2);
+  CHECK(toml[0] == FOLDER + "/a.toml");
+  CHECK(toml[1] == FOLDER + "/b.toml");
+
+  remove_directory(FOLDER);
+}
+
 #endif  // __gnu_linux__
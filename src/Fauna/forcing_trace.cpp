@@ -0,0 +1,396 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Record and replay the habitat forcing of the host program.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "forcing_trace.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace Fauna;
+
+namespace {
+/// Identifies the file type.
+const char TRACE_MAGIC[8] = {'M', 'M', 'M', 'F', 'O', 'R', 'C', 'E'};
+
+/// Increment this if the file format changes.
+const std::uint32_t TRACE_VERSION = 1;
+
+/// Detects files written on a platform with different byte order.
+const std::uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+/// Marks a record with the header information of one habitat.
+const char HABITAT_RECORD = 'H';
+
+/// Marks a record with the forcing of one habitat on one day.
+const char DAY_RECORD = 'D';
+
+/// Size of a day record after the record type and the habitat ID.
+const std::streamoff DAY_RECORD_SIZE =
+    sizeof(std::int32_t) + sizeof(HabitatForage) + sizeof(HabitatEnvironment) +
+    sizeof(Output::HabitatData);
+
+/// Write a trivially copyable value bytewise.
+template <class T>
+void write_value(std::ostream& out, const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only trivially copyable types can be copied bytewise.");
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Read a trivially copyable value bytewise.
+/** \return false if the end of the file was reached. */
+template <class T>
+bool read_value(std::istream& in, T& value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only trivially copyable types can be copied bytewise.");
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return in.gcount() == sizeof(T);
+}
+
+/// Get the object of a shared pointer or throw std::invalid_argument.
+template <class T>
+T& get_checked(const std::shared_ptr<T>& pointer, const std::string& caller) {
+  if (!pointer)
+    throw std::invalid_argument("Fauna::" + caller + "() Pointer is NULL.");
+  return *pointer;
+}
+}  // namespace
+
+//============================================================
+// ForcingRecorder
+//============================================================
+
+ForcingRecorder::ForcingRecorder(const std::string& filename)
+    : file(filename, std::ios::binary | std::ios::trunc), filename(filename) {
+  if (!file.is_open())
+    throw std::runtime_error(
+        "Fauna::ForcingRecorder::ForcingRecorder() "
+        "Could not open file \"" +
+        filename + "\" for writing.");
+  file.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  write_value(file, TRACE_VERSION);
+  write_value(file, TRACE_BYTE_ORDER);
+  // The record sizes guard against changes of the memory layout.
+  write_value(file, (std::uint32_t)sizeof(HabitatForage));
+  write_value(file, (std::uint32_t)sizeof(HabitatEnvironment));
+  write_value(file, (std::uint32_t)sizeof(Output::HabitatData));
+  check_file("ForcingRecorder");
+}
+
+int ForcingRecorder::add_habitat(const std::string& aggregation_unit,
+                                 const HabitatEnvironment& environment) {
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::int32_t id = habitat_count++;
+  file.put(HABITAT_RECORD);
+  write_value(file, id);
+  write_value(file, (std::uint32_t)aggregation_unit.size());
+  file.write(aggregation_unit.data(), aggregation_unit.size());
+  write_value(file, environment);
+  check_file("add_habitat");
+  return id;
+}
+
+void ForcingRecorder::add_day(const int id, const int day,
+                              const HabitatForage& forage,
+                              const HabitatEnvironment& environment,
+                              const Output::HabitatData& output) {
+  std::lock_guard<std::mutex> lock(mutex);
+  file.put(DAY_RECORD);
+  write_value(file, (std::int32_t)id);
+  write_value(file, (std::int32_t)day);
+  write_value(file, forage);
+  write_value(file, environment);
+  write_value(file, output);
+  check_file("add_day");
+}
+
+void ForcingRecorder::check_file(const std::string& caller) const {
+  if (!file.good())
+    throw std::runtime_error("Fauna::ForcingRecorder::" + caller +
+                             "() "
+                             "Could not write to file \"" +
+                             filename + "\".");
+}
+
+void ForcingRecorder::flush() {
+  std::lock_guard<std::mutex> lock(mutex);
+  file.flush();
+  check_file("flush");
+}
+
+int ForcingRecorder::get_habitat_count() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return habitat_count;
+}
+
+//============================================================
+// RecordingHabitat
+//============================================================
+
+RecordingHabitat::RecordingHabitat(std::shared_ptr<Habitat> habitat,
+                                   std::shared_ptr<ForcingRecorder> recorder)
+    : habitat(habitat),
+      recorder(recorder),
+      id(register_habitat(habitat, recorder)) {}
+
+int RecordingHabitat::register_habitat(
+    const std::shared_ptr<Habitat>& habitat,
+    const std::shared_ptr<ForcingRecorder>& recorder) {
+  const Habitat& h = get_checked(habitat, "RecordingHabitat::RecordingHabitat");
+  ForcingRecorder& r =
+      get_checked(recorder, "RecordingHabitat::RecordingHabitat");
+  return r.add_habitat(h.get_aggregation_unit(), h.get_environment());
+}
+
+void RecordingHabitat::init_day(const int today) {
+  habitat->init_day(today);
+  Habitat::init_day(today);
+  // The wrapped habitat might compose its output differently.
+  const Habitat& wrapped = *habitat;
+  get_todays_output() = wrapped.get_todays_output();
+  recorder->add_day(id, today, wrapped.get_available_forage(),
+                    wrapped.get_environment(), get_todays_output());
+}
+
+void RecordingHabitat::remove_eaten_forage(const ForageMass& eaten_forage) {
+  habitat->remove_eaten_forage(eaten_forage);
+  const Habitat& wrapped = *habitat;
+  get_todays_output() = wrapped.get_todays_output();
+}
+
+//============================================================
+// ForcingPlayer
+//============================================================
+
+ForcingPlayer::ForcingPlayer(const std::string& filename)
+    : file(filename, std::ios::binary), filename(filename) {
+  if (!file.is_open())
+    throw std::runtime_error(
+        "Fauna::ForcingPlayer::ForcingPlayer() "
+        "Could not open file \"" +
+        filename + "\" for reading.");
+  const std::string error_prefix =
+      "Fauna::ForcingPlayer::ForcingPlayer() "
+      "File \"" +
+      filename + "\" ";
+
+  char magic[sizeof(TRACE_MAGIC)];
+  file.read(magic, sizeof(magic));
+  if (file.gcount() != sizeof(magic) ||
+      std::memcmp(magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+    throw std::runtime_error(error_prefix + "is not a forcing trace.");
+  std::uint32_t version = 0, byte_order = 0;
+  std::uint32_t forage_size = 0, environment_size = 0, output_size = 0;
+  if (!read_value(file, version) || !read_value(file, byte_order) ||
+      !read_value(file, forage_size) || !read_value(file, environment_size) ||
+      !read_value(file, output_size))
+    throw std::runtime_error(error_prefix + "has an incomplete header.");
+  if (version != TRACE_VERSION)
+    throw std::runtime_error(error_prefix + "has version " +
+                             std::to_string(version) + ", but version " +
+                             std::to_string(TRACE_VERSION) + " is expected.");
+  if (byte_order != TRACE_BYTE_ORDER || forage_size != sizeof(HabitatForage) ||
+      environment_size != sizeof(HabitatEnvironment) ||
+      output_size != sizeof(Output::HabitatData))
+    throw std::runtime_error(error_prefix +
+                             "was written on an incompatible platform or by "
+                             "an incompatible version of the library.");
+  const std::streampos data_begin = file.tellg();
+
+  // First pass: Collect habitat records and count days.
+  char type;
+  while (file.get(type)) {
+    std::int32_t id;
+    if (!read_value(file, id))
+      throw std::runtime_error(error_prefix + "is truncated.");
+    if (type == HABITAT_RECORD) {
+      if (id != (std::int32_t)habitats.size())
+        throw std::runtime_error(error_prefix +
+                                 "has habitat records out of order.");
+      HabitatRecord record;
+      std::uint32_t length;
+      if (!read_value(file, length))
+        throw std::runtime_error(error_prefix + "is truncated.");
+      record.aggregation_unit.resize(length);
+      file.read(&record.aggregation_unit[0], length);
+      if (file.gcount() != length || !read_value(file, record.environment))
+        throw std::runtime_error(error_prefix + "is truncated.");
+      habitats.push_back(record);
+    } else if (type == DAY_RECORD) {
+      if (id < 0 || id >= (std::int32_t)habitats.size())
+        throw std::runtime_error(error_prefix +
+                                 "has a day record of an unknown habitat.");
+      habitats[id].day_count++;
+      file.seekg(DAY_RECORD_SIZE, std::ios::cur);
+    } else
+      throw std::runtime_error(error_prefix + "is corrupt.");
+  }
+
+  // Second pass: Stream the day records on demand.
+  file.clear();
+  file.seekg(data_begin);
+}
+
+const ForcingPlayer::HabitatRecord& ForcingPlayer::get_record(
+    const int id) const {
+  if (id < 0 || id >= (int)habitats.size())
+    throw std::out_of_range(
+        "Fauna::ForcingPlayer::get_record() "
+        "There is no habitat with ID " +
+        std::to_string(id) + " in the forcing trace.");
+  return habitats[id];
+}
+
+const std::string& ForcingPlayer::get_aggregation_unit(const int id) const {
+  return get_record(id).aggregation_unit;
+}
+
+int ForcingPlayer::get_day_count(const int id) const {
+  return get_record(id).day_count;
+}
+
+const HabitatEnvironment& ForcingPlayer::get_initial_environment(
+    const int id) const {
+  return get_record(id).environment;
+}
+
+ForcingPlayer::Day ForcingPlayer::read_day(const int id) {
+  std::lock_guard<std::mutex> lock(mutex);
+  HabitatRecord& record = const_cast<HabitatRecord&>(get_record(id));
+  if (!record.pending.empty()) {
+    const Day day = record.pending.front();
+    record.pending.pop_front();
+    return day;
+  }
+  char type;
+  while (file.get(type)) {
+    std::int32_t record_id;
+    read_value(file, record_id);
+    if (type == HABITAT_RECORD) {
+      // Skip the habitat record; it has been read in the first pass.
+      std::uint32_t length;
+      read_value(file, length);
+      file.seekg(length + sizeof(HabitatEnvironment), std::ios::cur);
+      continue;
+    }
+    Day day;
+    std::int32_t day_of_year;
+    if (!read_value(file, day_of_year) || !read_value(file, day.forage) ||
+        !read_value(file, day.environment) || !read_value(file, day.output))
+      break;
+    day.day = day_of_year;
+    if (record_id == id) return day;
+    habitats[record_id].pending.push_back(day);
+  }
+  throw std::runtime_error(
+      "Fauna::ForcingPlayer::read_day() "
+      "There are no more days for habitat " +
+      std::to_string(id) + " in file \"" + filename + "\".");
+}
+
+//============================================================
+// ForcingTrace
+//============================================================
+
+ForcingTrace::ForcingTrace(ForcingPlayer& player)
+    : habitats(player.get_habitat_count()) {
+  for (int id = 0; id < get_habitat_count(); id++) {
+    HabitatRecord& record = habitats[id];
+    record.aggregation_unit = player.get_aggregation_unit(id);
+    record.environment = player.get_initial_environment(id);
+    const int day_count = player.get_day_count(id);
+    record.days.reserve(day_count);
+    for (int i = 0; i < day_count; i++)
+      record.days.push_back(player.read_day(id));
+  }
+}
+
+const ForcingTrace::HabitatRecord& ForcingTrace::get_record(
+    const int id) const {
+  if (id < 0 || id >= (int)habitats.size())
+    throw std::out_of_range(
+        "Fauna::ForcingTrace::get_record() "
+        "There is no habitat with ID " +
+        std::to_string(id) + " in the forcing trace.");
+  return habitats[id];
+}
+
+const std::string& ForcingTrace::get_aggregation_unit(const int id) const {
+  return get_record(id).aggregation_unit;
+}
+
+int ForcingTrace::get_day_count(const int id) const {
+  return get_record(id).days.size();
+}
+
+const HabitatEnvironment& ForcingTrace::get_initial_environment(
+    const int id) const {
+  return get_record(id).environment;
+}
+
+const ForcingPlayer::Day& ForcingTrace::get_day(const int id,
+                                                const int index) const {
+  const HabitatRecord& record = get_record(id);
+  if (index < 0 || index >= (int)record.days.size())
+    throw std::out_of_range(
+        "Fauna::ForcingTrace::get_day() "
+        "There is no day with index " +
+        std::to_string(index) + " for habitat " + std::to_string(id) + ".");
+  return record.days[index];
+}
+
+//============================================================
+// ReplayHabitat
+//============================================================
+
+ReplayHabitat::ReplayHabitat(std::shared_ptr<ForcingPlayer> player,
+                             const int id)
+    : player(player),
+      id(id),
+      aggregation_unit(get_checked(player, "ReplayHabitat::ReplayHabitat")
+                           .get_aggregation_unit(id)),
+      environment(player->get_initial_environment(id)),
+      day_count(player->get_day_count(id)),
+      remaining_days(day_count) {}
+
+ReplayHabitat::ReplayHabitat(std::shared_ptr<const ForcingTrace> trace,
+                             const int id)
+    : trace(trace),
+      id(id),
+      aggregation_unit(get_checked(trace, "ReplayHabitat::ReplayHabitat")
+                           .get_aggregation_unit(id)),
+      environment(trace->get_initial_environment(id)),
+      day_count(trace->get_day_count(id)),
+      remaining_days(day_count) {}
+
+void ReplayHabitat::init_day(const int today) {
+  if (is_exhausted())
+    throw std::runtime_error(
+        "Fauna::ReplayHabitat::init_day() "
+        "All recorded days of habitat " +
+        std::to_string(id) + " have been replayed.");
+  Habitat::init_day(today);
+  const ForcingPlayer::Day recorded =
+      trace ? trace->get_day(id, day_count - remaining_days)
+            : player->read_day(id);
+  remaining_days--;
+  if (recorded.day != today)
+    throw std::runtime_error(
+        "Fauna::ReplayHabitat::init_day() "
+        "The simulated day (" +
+        std::to_string(today) + ") doesn’t match the recorded day (" +
+        std::to_string(recorded.day) + ") of habitat " + std::to_string(id) +
+        ".");
+  forage = recorded.forage;
+  environment = recorded.environment;
+  get_todays_output() = recorded.output;
+}
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for recording and replaying habitat forcing.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "forcing_trace.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "catch.hpp"
+#include "datapoint.h"
+#include "date.h"
+#include "dummy_habitat.h"
+#include "dummy_hft.h"
+#include "parameters.h"
+#include "world.h"
+
+using namespace Fauna;
+
+namespace {
+/// Habitat whose grass grows every day and is reduced by grazing.
+class GrazedHabitat : public DummyHabitat {
+ public:
+  GrazedHabitat(const std::string agg_unit = "global")
+      : DummyHabitat(agg_unit) {}
+  virtual HabitatForage get_available_forage() const {
+    HabitatForage forage;
+    forage.grass.set_mass(mass);
+    forage.grass.set_digestibility(0.6);
+    forage.grass.set_fpc(0.5);
+    return forage;
+  }
+  virtual HabitatEnvironment get_environment() const {
+    HabitatEnvironment env;
+    env.air_temperature = temperature;
+    return env;
+  }
+  virtual void init_day(const int today) {
+    Habitat::init_day(today);
+    mass += 1e4;
+    temperature = today % 30;
+  }
+  virtual void remove_eaten_forage(const ForageMass& eaten_forage) {
+    Habitat::remove_eaten_forage(eaten_forage);
+    mass -= eaten_forage[ForageType::Grass];
+  }
+
+ private:
+  double mass = 1e6;
+  double temperature = -5.0;
+};
+
+/// Read-only access to the habitat output.
+const Output::HabitatData& get_output(const Habitat& habitat) {
+  return habitat.get_todays_output();
+}
+}  // namespace
+
+TEST_CASE("Fauna::ForcingRecorder and Fauna::ForcingPlayer", "") {
+  const std::string FILENAME = "forcing_trace_test.bin";
+
+  CHECK_THROWS_AS(ForcingPlayer("this/file/does/not/exist"),
+                  std::runtime_error);
+  CHECK_THROWS_AS(ReplayHabitat(std::shared_ptr<ForcingPlayer>(), 0),
+                  std::invalid_argument);
+  CHECK_THROWS_AS(ReplayHabitat(std::shared_ptr<const ForcingTrace>(), 0),
+                  std::invalid_argument);
+
+  std::shared_ptr<ForcingRecorder> recorder(new ForcingRecorder(FILENAME));
+  CHECK_THROWS_AS(RecordingHabitat(NULL, recorder), std::invalid_argument);
+  CHECK(recorder->get_habitat_count() == 0);
+
+  std::shared_ptr<GrazedHabitat> original1(new GrazedHabitat("a"));
+  std::shared_ptr<GrazedHabitat> original2(new GrazedHabitat("b"));
+  RecordingHabitat recording1(original1, recorder);
+  RecordingHabitat recording2(original2, recorder);
+  CHECK(recorder->get_habitat_count() == 2);
+  CHECK(std::string(recording1.get_aggregation_unit()) == "a");
+  CHECK(&recording1.get_habitat() == original1.get());
+
+  const int DAYS = 5;
+  std::vector<double> masses;
+  for (int d = 0; d < DAYS; d++) {
+    recording1.init_day(d);
+    recording2.init_day(d);
+    masses.push_back(recording1.get_available_forage().grass.get_mass());
+    recording1.remove_eaten_forage(ForageMass(100.0 * d));
+    // The output is that of the wrapped habitat.
+    CHECK(get_output(recording1).eaten_forage ==
+          get_output(*original1).eaten_forage);
+  }
+  recorder->flush();
+
+  SECTION("Replay") {
+    std::shared_ptr<ForcingPlayer> player(new ForcingPlayer(FILENAME));
+    REQUIRE(player->get_habitat_count() == 2);
+    CHECK(player->get_aggregation_unit(1) == "b");
+    CHECK(player->get_day_count(0) == DAYS);
+    CHECK(player->get_initial_environment(0).air_temperature == -5.0);
+    CHECK_THROWS_AS(player->get_day_count(2), std::out_of_range);
+
+    ReplayHabitat replay1(player, 0);
+    ReplayHabitat replay2(player, 1);
+    CHECK(std::string(replay2.get_aggregation_unit()) == "b");
+    CHECK(replay1.get_environment().air_temperature == -5.0);
+    for (int d = 0; d < DAYS; d++) {
+      CHECK(!replay1.is_exhausted());
+      // Replay in different order than recorded.
+      replay2.init_day(d);
+      replay1.init_day(d);
+      CHECK(replay1.get_available_forage().grass.get_mass() == masses[d]);
+      CHECK(replay1.get_environment().air_temperature == d % 30);
+      CHECK(get_output(replay1).available_forage.grass.get_mass() ==
+            Approx(masses[d] - 1e4));
+    }
+    CHECK(replay1.is_exhausted());
+    CHECK_THROWS_AS(replay1.init_day(0), std::runtime_error);
+  }
+
+  SECTION("Shared trace in memory") {
+    ForcingPlayer player(FILENAME);
+    const std::shared_ptr<const ForcingTrace> trace(new ForcingTrace(player));
+    REQUIRE(trace->get_habitat_count() == 2);
+    CHECK(trace->get_aggregation_unit(1) == "b");
+    CHECK(trace->get_day_count(0) == DAYS);
+    CHECK(trace->get_initial_environment(0).air_temperature == -5.0);
+    CHECK_THROWS_AS(trace->get_day(0, DAYS), std::out_of_range);
+    CHECK_THROWS_AS(trace->get_day_count(2), std::out_of_range);
+
+    // Two habitats replay the same recorded habitat independently.
+    ReplayHabitat replay1(trace, 0);
+    ReplayHabitat replay2(trace, 0);
+    for (int d = 0; d < DAYS; d++) {
+      replay1.init_day(d);
+      CHECK(replay1.get_available_forage().grass.get_mass() == masses[d]);
+    }
+    CHECK(replay1.is_exhausted());
+    CHECK(!replay2.is_exhausted());
+    replay2.init_day(0);
+    CHECK(replay2.get_available_forage().grass.get_mass() == masses[0]);
+  }
+
+  SECTION("Day mismatch") {
+    std::shared_ptr<ForcingPlayer> player(new ForcingPlayer(FILENAME));
+    ReplayHabitat replay(player, 0);
+    CHECK_THROWS_AS(replay.init_day(1), std::runtime_error);
+  }
+
+  SECTION("Not a trace file") {
+    const std::string OTHER = "forcing_trace_test.txt";
+    std::ofstream(OTHER) << "Hello world!";
+    CHECK_THROWS_AS(ForcingPlayer(OTHER), std::runtime_error);
+    std::remove(OTHER.c_str());
+  }
+
+  std::remove(FILENAME.c_str());
+}
+
+TEST_CASE("Fauna::ReplayHabitat reproduces a simulation", "") {
+  const std::string FILENAME = "forcing_trace_world_test.bin";
+  std::shared_ptr<Parameters> params(new Parameters);
+  params->output_format = OutputFormat::InMemory;
+  params->output_interval = OutputInterval::Daily;
+  const std::shared_ptr<const HftList> hfts(create_hfts(2, *params));
+  const int DAYS = 100;
+  const int HABITATS = 3;
+
+  // Record.
+  std::vector<Output::Datapoint> recorded;
+  {
+    std::shared_ptr<ForcingRecorder> recorder(new ForcingRecorder(FILENAME));
+    World world(params, hfts);
+    for (int i = 0; i < HABITATS; i++)
+      world.create_simulation_unit(std::shared_ptr<Habitat>(
+          new RecordingHabitat(std::shared_ptr<Habitat>(new GrazedHabitat()),
+                               recorder)));
+    for (int d = 0; d < DAYS; d++) world.simulate_day(Date(d, 0));
+    recorded = world.retrieve_output();
+    recorder->flush();
+  }
+
+  // Replay.
+  std::vector<Output::Datapoint> replayed;
+  {
+    std::shared_ptr<ForcingPlayer> player(new ForcingPlayer(FILENAME));
+    REQUIRE(player->get_habitat_count() == HABITATS);
+    World world(params, hfts);
+    for (int i = 0; i < HABITATS; i++)
+      world.create_simulation_unit(
+          std::shared_ptr<Habitat>(new ReplayHabitat(player, i)));
+    for (int d = 0; d < DAYS; d++) world.simulate_day(Date(d, 0));
+    replayed = world.retrieve_output();
+  }
+
+  REQUIRE(recorded.size() == DAYS);
+  REQUIRE(replayed.size() == recorded.size());
+  for (int i = 0; i < DAYS; i++) {
+    const auto& a = recorded[i].data;
+    const auto& b = replayed[i].data;
+    CHECK(a.habitat_data.available_forage.get_mass() ==
+          b.habitat_data.available_forage.get_mass());
+    CHECK(a.habitat_data.eaten_forage == b.habitat_data.eaten_forage);
+    REQUIRE(a.hft_data.size() == b.hft_data.size());
+    for (const auto& itr : a.hft_data) {
+      CHECK(itr.second.massdens == b.hft_data.at(itr.first).massdens);
+      CHECK(itr.second.bodyfat == b.hft_data.at(itr.first).bodyfat);
+    }
+  }
+  // Herbivores must have eaten for the comparison to be meaningful.
+  CHECK(recorded.back().data.habitat_data.eaten_forage.sum() > 0.0);
+
+  std::remove(FILENAME.c_str());
+}
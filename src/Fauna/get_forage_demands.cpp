@@ -10,13 +10,13 @@
  */
 #include "get_forage_demands.h"
 
+#include "checkpoint.h"
 #include "foraging_limits.h"
 #include "herbivore_base.h"
 #include "hft.h"
 using namespace Fauna;
 
-GetForageDemands::GetForageDemands(std::shared_ptr<const Hft> hft,
-                                   const Sex sex)
+GetForageDemands::GetForageDemands(const Hft* hft, const Sex sex)
     : hft(hft),
       sex(sex),
       today(-1)  // indicate that day has not been initialized.
@@ -123,7 +123,8 @@ ForageMass GetForageDemands::get_max_digestion() const {
   }
 }
 
-ForageMass GetForageDemands::get_max_foraging() const {
+ForageMass GetForageDemands::get_max_foraging(
+    const HabitatForage& available_forage) const {
   assert(today > -1);  // check that init_today() has been called
 
   // set the maximum, and then let the foraging limit algorithms
@@ -245,7 +246,7 @@ void GetForageDemands::init_today(const int day,
         "Parameter \"day\" is greater than 364.");
 
   // init today’s variables
-  available_forage = _available_forage;
+  available_mass = _available_forage.get_mass();
   bodymass = _bodymass;
   digestibility = _available_forage.get_digestibility();
   energy_content = _energy_content;
@@ -259,7 +260,7 @@ void GetForageDemands::init_today(const int day,
   max_intake = ForageMass(10000);
 
   // Reduce maximum intake by foraging limits.
-  max_intake.min(get_max_foraging());
+  max_intake.min(get_max_foraging(_available_forage));
 
   // Reduce maximum intake by digestive limits.
   max_intake.min(get_max_digestion());
@@ -278,10 +279,32 @@ void GetForageDemands::init_today(const int day,
     // Apply the result to the grass component.
     max_intake.set(ForageType::Grass,
                    half_max.get_intake_rate(
-                       available_forage.grass.get_mass()));  // [kgDM/ind/day]
+                       _available_forage.grass.get_mass()));  // [kgDM/ind/day]
   }
 }
 
+void GetForageDemands::load_state(CheckpointReader& in) {
+  in.read(available_mass);
+  in.read(bodymass);
+  in.read(diet_composition);
+  in.read(digestibility);
+  in.read(energy_content);
+  in.read(energy_needs);
+  in.read(max_intake);
+  in.read(today);
+}
+
+void GetForageDemands::save_state(CheckpointWriter& out) const {
+  out.write(available_mass);
+  out.write(bodymass);
+  out.write(diet_composition);
+  out.write(digestibility);
+  out.write(energy_content);
+  out.write(energy_needs);
+  out.write(max_intake);
+  out.write(today);
+}
+
 bool GetForageDemands::is_day_initialized(const int day) const {
   if (day < 0)
     throw std::invalid_argument(
@@ -376,6 +399,6 @@ ForageMass GetForageDemands::operator()(const double _energy_needs) {
   ForageMass result = actual_energy_intake.divide_safely(energy_content, 0.0);
 
   // Make sure that we don’t exceed the total available forage.
-  result.min(available_forage.get_mass());
+  result.min(available_mass);
   return result;
 }
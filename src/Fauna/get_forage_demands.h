@@ -11,12 +11,12 @@
 #ifndef FAUNA_GET_FORAGE_DEMANDS_H
 #define FAUNA_GET_FORAGE_DEMANDS_H
 
-#include <memory>
-
 #include "forage_values.h"
 #include "habitat_forage.h"
 
 namespace Fauna {
+class CheckpointReader;
+class CheckpointWriter;
 class Hft;
 enum class Sex;
 
@@ -28,11 +28,12 @@ class GetForageDemands {
  public:
   /// Constructor.
   /**
-   * \param hft Herbivore functional type.
+   * \param hft Herbivore functional type. This is a non-owning pointer; the
+   * HFT must outlive this object.
    * \param sex The sex of the herbivore cohort.
    * \throw std::invalid_argument If `hft==NULL`.
    */
-  GetForageDemands(std::shared_ptr<const Hft> hft, const Sex sex);
+  GetForageDemands(const Hft* hft, const Sex sex);
 
   /// Register ingested forage so that less forage will be demanded.
   /**
@@ -90,6 +91,13 @@ class GetForageDemands {
    */
   ForageMass operator()(const double energy_needs);
 
+  /// Restore the state of the current day from a checkpoint.
+  /** \throw std::runtime_error If the checkpoint data is corrupt. */
+  void load_state(CheckpointReader& in);
+
+  /// Append the state of the current day to a checkpoint.
+  void save_state(CheckpointWriter& out) const;
+
  private:
   /// Adult herbivore body mass [kg/ind].
   double get_bodymass_adult() const;
@@ -160,22 +168,23 @@ class GetForageDemands {
    *
    * Each forage type is  calculated separately and independently.
    *
+   * \param available_forage The forage in the habitat.
    * \return Maximum potentially harvested dry matter mass of
    * each forage type [kgDM/day/ind].
    * \throw std::logic_error If one of \ref Hft::foraging_limits is
    * not implemented.
    */
-  ForageMass get_max_foraging() const;
+  ForageMass get_max_foraging(const HabitatForage& available_forage) const;
 
   /// Current day of the year, as set in \ref init_today().
   /** \throw std::logic_error If current day not yet set by an
    * initial call to \ref init_today(). */
   int get_today() const;
 
-  const std::shared_ptr<const Hft> hft;
+  const Hft* const hft;
   const Sex sex;
 
-  HabitatForage available_forage;
+  ForageMass available_mass;           /// [kgDM/km²]
   double bodymass;                     /// [kg/ind]
   ForageFraction diet_composition;     /// [frac.] sum = 1.0
   Digestibility digestibility;         /// [frac.]
@@ -34,7 +34,7 @@ TEST_CASE("Fauna::GetForageDemands") {
 
   SECTION("Check some exceptions.") {
     // Create the object.
-    GetForageDemands gfd(hft, Sex::Female);
+    GetForageDemands gfd(hft.get(), Sex::Female);
 
     // Exception because not initialized.
     CHECK_THROWS(gfd(1.0));
@@ -63,7 +63,7 @@ TEST_CASE("Fauna::GetForageDemands") {
   SECTION("Grazer with Fixed Fraction") {
     hft->foraging_diet_composer = DietComposer::PureGrazer;
     hft->digestion_limit = DigestiveLimit::FixedFraction;
-    GetForageDemands gfd(hft, Sex::Female);  // create object
+    GetForageDemands gfd(hft.get(), Sex::Female);  // create object
     const double DIG_FRAC = 0.03;  // max. intake as fraction of body mass
     hft->digestion_fixed_fraction = DIG_FRAC;
     avail.grass.set_mass(999999);  // Lots of live grass (but nothing else).
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Estimates of the heap memory held by containers and output data.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "heap_bytes.h"
+
+#include "datapoint.h"
+
+using namespace Fauna;
+
+std::size_t Fauna::get_heap_bytes(const Output::HerbivoreData& data) {
+  return get_heap_bytes(data.mortality);
+}
+
+std::size_t Fauna::get_heap_bytes(const Output::CombinedData& data) {
+  std::size_t result = get_heap_bytes(data.hft_data);
+  for (const auto& itr : data.hft_data)
+    result += get_heap_bytes(itr.first) + get_heap_bytes(itr.second);
+  return result;
+}
+
+std::size_t Fauna::get_heap_bytes(const Output::Datapoint& datapoint) {
+  return get_heap_bytes(datapoint.aggregation_unit) +
+         get_heap_bytes(datapoint.data);
+}
+
+std::size_t Fauna::get_heap_bytes(
+    const std::vector<Output::Datapoint>& datapoints) {
+  std::size_t result = datapoints.capacity() * sizeof(Output::Datapoint);
+  for (const auto& datapoint : datapoints) result += get_heap_bytes(datapoint);
+  return result;
+}
+
+std::size_t Fauna::get_heap_bytes(
+    const std::deque<Output::Datapoint>& datapoints) {
+  std::size_t result = datapoints.size() * sizeof(Output::Datapoint);
+  for (const auto& datapoint : datapoints) result += get_heap_bytes(datapoint);
+  return result;
+}
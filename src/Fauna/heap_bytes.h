@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Estimates of the heap memory held by containers and output data.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_HEAP_BYTES_H
+#define FAUNA_HEAP_BYTES_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Fauna {
+namespace Output {
+struct CombinedData;
+struct Datapoint;
+struct HerbivoreData;
+}  // namespace Output
+
+/// Approximate bookkeeping of one node in a map or list [bytes].
+/** This is the size of a red-black tree node header in common libraries. */
+const std::size_t NODE_OVERHEAD = 4 * sizeof(void*);
+
+/// Heap memory of a string [bytes].
+/**
+ * Short strings are stored inside the object and need no heap memory. This
+ * is the case if the characters lie within the object itself.
+ */
+inline std::size_t get_heap_bytes(const std::string& s) {
+  const char* const begin = reinterpret_cast<const char*>(&s);
+  const char* const data = s.data();
+  const std::less<const char*> less;
+  if (!less(data, begin) && less(data, begin + sizeof(std::string))) return 0;
+  return s.capacity() + 1;
+}
+
+/// Heap memory of a map, not counting heap memory of its elements [bytes].
+template <class K, class V, class C, class A>
+std::size_t get_heap_bytes(const std::map<K, V, C, A>& map) {
+  typedef typename std::map<K, V, C, A>::value_type Value;
+  return map.size() * (sizeof(Value) + NODE_OVERHEAD);
+}
+
+/// Heap memory of a vector, not counting heap memory of its elements [bytes].
+template <class T, class A>
+std::size_t get_heap_bytes(const std::vector<T, A>& vector) {
+  return vector.capacity() * sizeof(T);
+}
+
+/// Heap memory of the output of one herbivore [bytes].
+std::size_t get_heap_bytes(const Output::HerbivoreData&);
+
+/// Heap memory of combined output data [bytes].
+std::size_t get_heap_bytes(const Output::CombinedData&);
+
+/// Heap memory of one datapoint [bytes].
+std::size_t get_heap_bytes(const Output::Datapoint&);
+
+/// Size of a vector of datapoints including all their heap memory [bytes].
+std::size_t get_heap_bytes(const std::vector<Output::Datapoint>&);
+
+/// Size of a deque of datapoints including all their heap memory [bytes].
+std::size_t get_heap_bytes(const std::deque<Output::Datapoint>&);
+
+}  // namespace Fauna
+
+#endif  // FAUNA_HEAP_BYTES_H
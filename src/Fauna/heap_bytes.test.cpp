@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the heap memory estimates.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "heap_bytes.h"
+
+#include "catch.hpp"
+#include "datapoint.h"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::get_heap_bytes()", "") {
+  CHECK(get_heap_bytes(std::string("short")) == 0);
+  CHECK(get_heap_bytes(std::string(100, 'x')) > 100);
+  // Longer than the small-string buffer, but shorter than the object.
+  CHECK(get_heap_bytes(std::string(sizeof(std::string) - 1, 'x')) >=
+        sizeof(std::string));
+
+  std::vector<double> vector;
+  CHECK(get_heap_bytes(vector) == 0);
+  vector.reserve(10);
+  CHECK(get_heap_bytes(vector) == 10 * sizeof(double));
+
+  Output::HerbivoreData herbivore_data;
+  CHECK(get_heap_bytes(herbivore_data) == 0);
+  herbivore_data.mortality[MortalityFactor::Lifespan] = 0.1;
+  const std::size_t one_factor = get_heap_bytes(herbivore_data);
+  CHECK(one_factor > sizeof(double));
+  herbivore_data.mortality[MortalityFactor::StarvationThreshold] = 0.1;
+  CHECK(get_heap_bytes(herbivore_data) == 2 * one_factor);
+
+  Output::Datapoint datapoint;
+  const std::size_t empty = get_heap_bytes(datapoint);
+  datapoint.data.hft_data["hft"] = herbivore_data;
+  CHECK(get_heap_bytes(datapoint) > empty + 2 * one_factor);
+
+  std::vector<Output::Datapoint> datapoints(3, datapoint);
+  CHECK(get_heap_bytes(datapoints) >=
+        3 * (sizeof(Output::Datapoint) + get_heap_bytes(datapoint)));
+  const std::deque<Output::Datapoint> queue(3, datapoint);
+  CHECK(get_heap_bytes(queue) ==
+        3 * (sizeof(Output::Datapoint) + get_heap_bytes(datapoint)));
+}
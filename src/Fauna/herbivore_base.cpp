@@ -10,7 +10,11 @@
  */
 #include "herbivore_base.h"
 
+#include <algorithm>
+
+#include "checkpoint.h"
 #include "expenditure_components.h"
+#include "heap_bytes.h"
 #include "hft.h"
 #include "mortality_factors.h"
 #include "net_energy_models.h"
@@ -19,20 +23,19 @@
 using namespace Fauna;
 
 HerbivoreBase::HerbivoreBase(const int age_days, const double body_condition,
-                             std::shared_ptr<const Hft> hft, const Sex sex,
+                             const Hft& hft, const Sex sex,
                              const ForageEnergyContent& forage_gross_energy)
-    : hft(check_hft_pointer(hft)),  // can be NULL
-      sex(sex),                     // always valid
+    : hft(&hft),
+      sex(sex),
+      forage_gross_energy(&forage_gross_energy),
       age_days(age_days),
-      breeding_season(hft->breeding_season_start, hft->breeding_season_length),
-      forage_gross_energy(forage_gross_energy),
       energy_budget(
           body_condition * get_max_fatmass(),  // initial fat mass
           get_max_fatmass(),                   // maximum fat mass
-          hft->body_fat_gross_energy * hft->digestion_k_maintenance /
-              hft->digestion_k_fat,
-          hft->body_fat_gross_energy * hft->body_fat_catabolism_efficiency),
-      get_forage_demands_per_ind(hft, sex),
+          hft.body_fat_gross_energy * hft.digestion_k_maintenance /
+              hft.digestion_k_fat,
+          hft.body_fat_gross_energy * hft.body_fat_catabolism_efficiency),
+      get_forage_demands_per_ind(&hft, sex),
       today(-1),  // not initialized yet; call simulate_day() first
       body_condition_gestation(get_hft().reproduction_gestation_length * 30) {
   // Check validity of parameters
@@ -60,21 +63,20 @@ HerbivoreBase::HerbivoreBase(const int age_days, const double body_condition,
         "body_condition < 0.0");
 }
 
-HerbivoreBase::HerbivoreBase(std::shared_ptr<const Hft> hft, const Sex sex,
+HerbivoreBase::HerbivoreBase(const Hft& hft, const Sex sex,
                              const ForageEnergyContent& forage_gross_energy)
-    : hft(check_hft_pointer(hft)),
+    : hft(&hft),
       sex(sex),
+      forage_gross_energy(&forage_gross_energy),
       age_days(0),
-      forage_gross_energy(forage_gross_energy),
-      breeding_season(hft->breeding_season_start, hft->breeding_season_length),
       energy_budget(
           get_hft().body_mass_birth * get_hft().body_mass_empty *
               get_hft().body_fat_birth,  // fat mass at birth
           get_max_fatmass(),             // maximum fat mass
-          hft->body_fat_gross_energy * hft->digestion_k_maintenance /
-              hft->digestion_k_fat,
-          hft->body_fat_gross_energy * hft->body_fat_catabolism_efficiency),
-      get_forage_demands_per_ind(hft, sex),
+          hft.body_fat_gross_energy * hft.digestion_k_maintenance /
+              hft.digestion_k_fat,
+          hft.body_fat_gross_energy * hft.body_fat_catabolism_efficiency),
+      get_forage_demands_per_ind(&hft, sex),
       body_condition_gestation(get_hft().reproduction_gestation_length * 30) {}
 
 void HerbivoreBase::apply_mortality_factors_today() {
@@ -105,7 +107,7 @@ void HerbivoreBase::apply_mortality_factors_today() {
 
     if (itr == MortalityFactor::StarvationIlliusOConnor2000) {
       double mortality = 0.0;
-      const double body_condition = get_fatmass() / get_max_fatmass();
+      const double body_condition = get_body_condition();
       double new_body_condition = body_condition;
 
       // Standard deviation of body fat in this cohort.
@@ -135,9 +137,9 @@ void HerbivoreBase::apply_mortality_factors_today() {
     }
 
     if (itr == MortalityFactor::StarvationThreshold) {
-      // This function object can be static because it is in no way
-      // specific to this herbivore instance.
-      static const GetStarvationMortalityThreshold starv_thresh;
+      // The function object is cheap to construct. It is not static so
+      // that the library has no shared state between threads.
+      const GetStarvationMortalityThreshold starv_thresh;
       const double mortality = starv_thresh(get_bodyfat());
       mortality_sum += mortality;
       // output:
@@ -197,17 +199,6 @@ void HerbivoreBase::eat(const ForageMass& kg_per_km2,
       (10e6 * N_kg_per_km2.sum()) / get_ind_per_km2();
 }
 
-std::shared_ptr<const Hft> HerbivoreBase::check_hft_pointer(
-    std::shared_ptr<const Hft> _hft) {
-  // Exception error message is like from a constructor because that’s
-  // where this function gets called.
-  if (_hft.get() == NULL)
-    throw std::invalid_argument(
-        "Fauna::HerbivoreBase::HerbivoreBase() "
-        "Parameter `hft` is NULL.");
-  return _hft;
-}
-
 double HerbivoreBase::get_bodyfat() const {
   return get_fatmass() / (get_structural_mass() + get_fatmass());
 }
@@ -277,6 +268,15 @@ double HerbivoreBase::get_kg_per_km2() const {
   return get_bodymass() * get_ind_per_km2();
 }
 
+std::size_t HerbivoreBase::get_heap_bytes() const {
+  return body_condition_gestation.get_heap_bytes() +
+         Fauna::get_heap_bytes(current_output);
+}
+
+double HerbivoreBase::get_body_condition() const {
+  return std::min(1.0, get_fatmass() / get_max_fatmass());
+}
+
 double HerbivoreBase::get_max_fatmass() const {
   const double bf_max = get_hft().body_fat_maximum;
   return (get_structural_mass() * bf_max) / (1.0 - bf_max);
@@ -290,7 +290,7 @@ ForageEnergyContent HerbivoreBase::get_net_energy_content(
   switch (get_hft().digestion_net_energy_model) {
     case (NetEnergyModel::GrossEnergyFraction):
       return get_net_energy_from_gross_energy(
-          forage_gross_energy, digestibility,
+          *forage_gross_energy, digestibility,
           get_hft().digestion_me_coefficient,
           get_hft().digestion_k_maintenance);
       // ADD NEW NET ENERGY MODELS HERE
@@ -345,7 +345,8 @@ int HerbivoreBase::get_today() const {
   return today;
 }
 
-double HerbivoreBase::get_todays_expenditure() const {
+double HerbivoreBase::get_todays_expenditure(
+    const HabitatEnvironment& environment) const {
   // Sum of all expenditure components [MJ/ind/day]
   double result = 0.0;
 
@@ -374,7 +375,7 @@ double HerbivoreBase::get_todays_expenditure() const {
       }
       case (ExpenditureComponent::Zhu2018): {
         result += get_expenditure_zhu_et_al_2018(
-            get_bodymass(), get_environment().air_temperature);
+            get_bodymass(), environment.air_temperature);
         break;
       }
       case (ExpenditureComponent::Thermoregulation): {
@@ -395,18 +396,24 @@ double HerbivoreBase::get_todays_expenditure() const {
     result += get_thermoregulatory_expenditure(
         result,  // thermoneutral_rate
         get_conductance(), get_hft().thermoregulation_core_temperature,
-        get_environment().air_temperature);
+        environment.air_temperature);
   }
 
   assert(result >= 0.0);
   return result;
 }
 
+BreedingSeason HerbivoreBase::get_breeding_season() const {
+  return BreedingSeason(get_hft().breeding_season_start,
+                        get_hft().breeding_season_length);
+}
+
 double HerbivoreBase::get_todays_offspring_proportion() const {
   if (get_sex() == Sex::Male ||
       get_age_years() < get_hft().life_history_sexual_maturity)
     return 0.0;
 
+  const BreedingSeason breeding_season = get_breeding_season();
   if (!breeding_season.is_in_season(get_today())) return 0.0;
 
   switch (get_hft().reproduction_model) {
@@ -444,7 +451,7 @@ double HerbivoreBase::get_todays_offspring_proportion() const {
 }
 
 void HerbivoreBase::simulate_day(const int day,
-                                 const HabitatEnvironment& _environment,
+                                 const HabitatEnvironment& environment,
                                  double& offspring) {
   if (day < 0 || day >= 365)
     throw std::invalid_argument(
@@ -456,8 +463,6 @@ void HerbivoreBase::simulate_day(const int day,
         "This herbivore is dead. `simulate_day()` must not be called "
         "on a dead herbivore object.");
 
-  environment = _environment;
-
   // In the following, we wrote doxygen comments in the function body.
   /// - Set current day.
   today = day;
@@ -467,7 +472,7 @@ void HerbivoreBase::simulate_day(const int day,
 
   /// - Update records.
   if (get_sex() == Sex::Female)  // (males don’t need this for reproduction)
-    body_condition_gestation.add_value(get_fatmass() / get_max_fatmass());
+    body_condition_gestation.add_value(get_body_condition());
 
   /// - Update maximum fat mass and gain in \ref Fauna::FatmassEnergyBudget.
   get_energy_budget().set_max_fatmass(
@@ -486,7 +491,7 @@ void HerbivoreBase::simulate_day(const int day,
   get_energy_budget().catabolize_fat();
 
   /// - Add energy needs for today.
-  const double todays_expenditure = get_todays_expenditure();
+  const double todays_expenditure = get_todays_expenditure(environment);
   get_energy_budget().add_energy_needs(todays_expenditure);
   get_todays_output().expenditure = todays_expenditure;
 
@@ -497,3 +502,21 @@ void HerbivoreBase::simulate_day(const int day,
   /// - Apply mortality factor.
   apply_mortality_factors_today();
 }
+
+void HerbivoreBase::load_state(CheckpointReader& in) {
+  in.read(age_days);
+  in.read(energy_budget);
+  in.read(today);
+  body_condition_gestation.load_state(in);
+  in.read(current_output);
+  get_forage_demands_per_ind.load_state(in);
+}
+
+void HerbivoreBase::save_state(CheckpointWriter& out) const {
+  out.write(age_days);
+  out.write(energy_budget);
+  out.write(today);
+  body_condition_gestation.save_state(out);
+  out.write(current_output);
+  get_forage_demands_per_ind.save_state(out);
+}
@@ -104,6 +104,10 @@ class HerbivoreBase : public HerbivoreInterface {
    */
   double get_fatmass() const;
 
+  /// Memory that this herbivore has allocated on the heap [bytes].
+  /** Shared data like the HFT are not included. */
+  std::size_t get_heap_bytes() const;
+
   /// The herbivore functional type (HFT).
   const Hft& get_hft() const {
     assert(hft);
@@ -164,6 +168,18 @@ class HerbivoreBase : public HerbivoreInterface {
   /// The sex of the herbivore
   Sex get_sex() const { return sex; }
 
+  /// Restore all variable member data from a checkpoint.
+  /**
+   * Constant members (HFT, sex, etc.) are not part of the checkpoint. They
+   * must be set by the constructor.
+   * \throw std::runtime_error If the checkpoint data is corrupt.
+   */
+  virtual void load_state(CheckpointReader& in);
+
+  /// Append all variable member data to a checkpoint.
+  /** \see \ref load_state() */
+  virtual void save_state(CheckpointWriter& out) const;
+
  protected:
   /// Establishment constructor.
   /**
@@ -174,11 +190,14 @@ class HerbivoreBase : public HerbivoreInterface {
    * \param sex The sex of the herbivore.
    * \param forage_gross_energy The (constant) gross energy content for the
    * forage types [MJ/kgDM]. See: \ref Parameters::forage_gross_energy
-   * \throw std::invalid_argument If `hft==NULL` or
-   * `age_days <= 0` or `body_condition` not in [0,1].
+   * \throw std::invalid_argument If `age_days <= 0` or `body_condition` not
+   * in [0,1].
+   * \warning Only a plain pointer to the HFT and a reference to the gross
+   * energy are kept. Both must outlive the herbivore. The population and
+   * \ref CreateHerbivoreCohort take care of that.
    */
   HerbivoreBase(const int age_days, const double body_condition,
-                std::shared_ptr<const Hft> hft, const Sex sex,
+                const Hft& hft, const Sex sex,
                 const ForageEnergyContent& forage_gross_energy);
 
   /// Birth constructor.
@@ -188,9 +207,11 @@ class HerbivoreBase : public HerbivoreInterface {
    * \param sex The sex of the herbivore.
    * \param forage_gross_energy The (constant) gross energy content
    * for the forage types [MJ/kgDM]. See: \ref Parameters::forage_gross_energy
-   * \throw std::invalid_argument If `hft==NULL`.
+   * \warning Only a plain pointer to the HFT and a reference to the gross
+   * energy are kept. Both must outlive the herbivore. The population and
+   * \ref CreateHerbivoreCohort take care of that.
    */
-  HerbivoreBase(std::shared_ptr<const Hft> hft, const Sex sex,
+  HerbivoreBase(const Hft& hft, const Sex sex,
                 const ForageEnergyContent& forage_gross_energy);
 
   /// Virtual destructor, which will be called by derived classes.
@@ -210,24 +231,23 @@ class HerbivoreBase : public HerbivoreInterface {
   /// The herbivore’s energy budget object.
   const FatmassEnergyBudget& get_energy_budget() const { return energy_budget; }
 
-  /// Current abiotic conditions in the habitat.
-  /**
-   * \throw std::logic_error If \ref simulate_day() hasn’t been called
-   * yet to set the \ref HabitatEnvironment object.
-   */
-  const HabitatEnvironment& get_environment() const { return environment; }
-
   /// Class-internal read/write access to current output.
   Output::HerbivoreData& get_todays_output() { return current_output; }
 
   /// Check whether the constant member variables match those of another object.
   bool constant_members_match(const HerbivoreBase& other) const {
-    return sex == other.sex && hft.get() == other.hft.get() &&
-           forage_gross_energy == other.forage_gross_energy &&
-           breeding_season == other.breeding_season;
+    return sex == other.sex && hft == other.hft &&
+           *forage_gross_energy == *other.forage_gross_energy;
   }
 
  private:  // private member functions
+  /// Current fat mass as fraction of the current maximum fat mass.
+  /**
+   * With \ref sec_design_float_storage the stored fat mass may be rounded
+   * slightly above the maximum. The result is therefore capped at 1.
+   */
+  double get_body_condition() const;
+
   /// Calculate mortality according to user-selected mortality factors
   /**
    * Calls \ref apply_mortality(), which is implemented by
@@ -236,14 +256,8 @@ class HerbivoreBase : public HerbivoreInterface {
    */
   void apply_mortality_factors_today();
 
-  /// Check whether the HFT pointer is NULL and throws an exception.
-  /** This helper function is only neededd because an exception for a
-   * NULL pointer must be thrown from the constructor. But in the
-   * initialization list there are objects that need the HFT for their
-   * own constructor. Therefore, the HFT pointer must be checked in a
-   * function first, before the HerbivoreBase constructor function body.
-   * \throw std::invalid_argument If HFT pointer is NULL. */
-  std::shared_ptr<const Hft> check_hft_pointer(std::shared_ptr<const Hft>);
+  /// The breeding season as defined in the HFT.
+  BreedingSeason get_breeding_season() const;
 
   /// Get forage energy content [MJ/kgDM] using selected net energy model.
   /**
@@ -258,9 +272,10 @@ class HerbivoreBase : public HerbivoreInterface {
   ForageEnergyContent get_net_energy_content(Digestibility digestibility) const;
 
   /// Calculate energy expenditure as sum of given expenditure components.
-  /** \return Today’s energy needs [MJ/ind/day]
+  /** \param environment Current abiotic conditions in the habitat.
+   * \return Today’s energy needs [MJ/ind/day]
    * \see \ref Hft::expenditure_components */
-  double get_todays_expenditure() const;
+  double get_todays_expenditure(const HabitatEnvironment& environment) const;
 
   /// Get the proportional offspring for today using selected model.
   /**
@@ -275,17 +290,16 @@ class HerbivoreBase : public HerbivoreInterface {
 
  private:
   /// @{ \name Constants
+  // Shared data are only referenced to keep the cohorts small.
   // pointer to const Hft; initialized first!
-  const std::shared_ptr<const Hft> hft;
+  const Hft* const hft;
   const Sex sex;
-  const BreedingSeason breeding_season;
-  const ForageEnergyContent forage_gross_energy;
+  const ForageEnergyContent* const forage_gross_energy;
   /** @} */  // constants
 
   /// @{ \name State Variables
   int age_days;
   FatmassEnergyBudget energy_budget;
-  HabitatEnvironment environment;  // set in simulate_day()
   int today;
   /** @} */  // state variables
 
@@ -296,6 +310,9 @@ class HerbivoreBase : public HerbivoreInterface {
    * current day. This object is empty for male herbivores. */
   PeriodAverage body_condition_gestation;
 
+  /// Today’s output, collected by the simulation unit after the day.
+  /** This is not a copy: simulate_day(), eat(), and the mortality add to it
+   * in the course of the day. */
   Output::HerbivoreData current_output;
   GetForageDemands get_forage_demands_per_ind;
   /** @} */  // Helper Classes
@@ -27,19 +27,17 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
   REQUIRE(hft->is_valid(params));
 
   // Let’s throw some exceptions
-  CHECK_THROWS(HerbivoreBaseDummy(-1, 0.5, hft,  // age_days
+  CHECK_THROWS(HerbivoreBaseDummy(-1, 0.5, *hft,  // age_days
                                   Sex::Male));
-  CHECK_THROWS(HerbivoreBaseDummy(100, 0.5, NULL,  // hft== NULL
+  CHECK_THROWS(HerbivoreBaseDummy(100, 1.1, *hft,  // body_conditon
                                   Sex::Male));
-  CHECK_THROWS(HerbivoreBaseDummy(100, 1.1, hft,  // body_conditon
-                                  Sex::Male));
-  CHECK_THROWS(HerbivoreBaseDummy(100, -0.1, hft,  // body_conditon
+  CHECK_THROWS(HerbivoreBaseDummy(100, -0.1, *hft,  // body_conditon
                                   Sex::Male));
 
   SECTION("Body mass") {
     SECTION("Birth") {
       // call the birth constructor
-      const HerbivoreBaseDummy birth(hft, Sex::Male);
+      const HerbivoreBaseDummy birth(*hft, Sex::Male);
 
       REQUIRE(&birth.get_hft() == hft.get());
       REQUIRE(birth.get_age_days() == 0);
@@ -73,7 +71,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
         const int AGE_YEARS = hft->life_history_physical_maturity_male - 1;
         const int AGE_DAYS = AGE_YEARS * 365;
         REQUIRE(AGE_DAYS > 0);
-        const HerbivoreBaseDummy male_young(AGE_DAYS, BODY_COND, hft,
+        const HerbivoreBaseDummy male_young(AGE_DAYS, BODY_COND, *hft,
                                             Sex::Male);
         REQUIRE(male_young.get_age_days() == AGE_DAYS);
         REQUIRE(male_young.get_age_years() == AGE_YEARS);
@@ -87,7 +85,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
         const int AGE_YEARS = hft->life_history_physical_maturity_female - 1;
         const int AGE_DAYS = AGE_YEARS * 365;
         REQUIRE(AGE_DAYS > 0);
-        const HerbivoreBaseDummy female_young(AGE_DAYS, BODY_COND, hft,
+        const HerbivoreBaseDummy female_young(AGE_DAYS, BODY_COND, *hft,
                                               Sex::Female);
         REQUIRE(female_young.get_age_days() == AGE_DAYS);
         REQUIRE(female_young.get_age_years() == AGE_YEARS);
@@ -103,7 +101,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
       SECTION("Adult male with full fat") {
         const int AGE_YEARS = hft->life_history_physical_maturity_male;
         const int AGE_DAYS = AGE_YEARS * 365;
-        const HerbivoreBaseDummy male_adult(AGE_DAYS, BODY_COND, hft,
+        const HerbivoreBaseDummy male_adult(AGE_DAYS, BODY_COND, *hft,
                                             Sex::Male);
         // AGE
         REQUIRE(male_adult.get_age_days() == AGE_DAYS);
@@ -120,7 +118,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
       SECTION("Adult female with full fat") {
         const int AGE_YEARS = hft->life_history_physical_maturity_female;
         const int AGE_DAYS = AGE_YEARS * 365;
-        const HerbivoreBaseDummy female_adult(AGE_DAYS, BODY_COND, hft,
+        const HerbivoreBaseDummy female_adult(AGE_DAYS, BODY_COND, *hft,
                                               Sex::Female);
         // AGE
         REQUIRE(female_adult.get_age_days() == AGE_DAYS);
@@ -139,7 +137,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
 
       SECTION("Male") {
         const HerbivoreBaseDummy male_adult(
-            hft->life_history_physical_maturity_male * 365, BODY_COND, hft,
+            hft->life_history_physical_maturity_male * 365, BODY_COND, *hft,
             Sex::Male);
         // FAT MASS
         CHECK(male_adult.get_fatmass() / male_adult.get_max_fatmass() ==
@@ -148,7 +146,7 @@ TEST_CASE("Fauna::HerbivoreBase", "") {
 
       SECTION("Female") {
         const HerbivoreBaseDummy female_adult(
-            hft->life_history_physical_maturity_male * 365, BODY_COND, hft,
+            hft->life_history_physical_maturity_male * 365, BODY_COND, *hft,
             Sex::Female);
         // FAT MASS
         CHECK(female_adult.get_fatmass() / female_adult.get_max_fatmass() ==
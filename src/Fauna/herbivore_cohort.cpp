@@ -10,6 +10,7 @@
  */
 #include "herbivore_cohort.h"
 
+#include "checkpoint.h"
 #include "fatmass_energy_budget.h"
 #include "hft.h"
 
@@ -17,7 +18,7 @@ using namespace Fauna;
 
 HerbivoreCohort::HerbivoreCohort(const int age_days,
                                  const double body_condition,
-                                 std::shared_ptr<const Hft> hft, const Sex sex,
+                                 const Hft& hft, const Sex sex,
                                  const double ind_per_km2,
                                  const ForageEnergyContent& forage_gross_energy)
     : HerbivoreBase(age_days, body_condition, hft, sex, forage_gross_energy),
@@ -28,7 +29,7 @@ HerbivoreCohort::HerbivoreCohort(const int age_days,
         "ind_per_km2 <0.0");
 }
 
-HerbivoreCohort::HerbivoreCohort(std::shared_ptr<const Hft> hft, const Sex sex,
+HerbivoreCohort::HerbivoreCohort(const Hft& hft, const Sex sex,
                                  const double ind_per_km2,
                                  const ForageEnergyContent& forage_gross_energy)
     : HerbivoreBase(hft, sex, forage_gross_energy), ind_per_km2(ind_per_km2) {
@@ -47,12 +48,10 @@ void HerbivoreCohort::apply_mortality(const double mortality) {
   const double ind_change = -mortality * get_ind_per_km2();
   // apply the change and make sure that the density does not
   // drop below zero because of precision artefacts
-  ind_per_km2 = std::max(0.0, ind_per_km2 + ind_change);
+  ind_per_km2 = std::max<double>(0.0, ind_per_km2 + ind_change);
   assert(ind_per_km2 >= 0.0);
 }
 
-bool HerbivoreCohort::is_dead() const { return get_ind_per_km2() <= 0.0; }
-
 void HerbivoreCohort::merge(HerbivoreCohort& other) {
   if (!is_same_age(other))
     throw std::invalid_argument(
@@ -74,3 +73,13 @@ void HerbivoreCohort::merge(HerbivoreCohort& other) {
   // Change density in other object
   other.ind_per_km2 = 0.0;
 }
+
+void HerbivoreCohort::load_state(CheckpointReader& in) {
+  HerbivoreBase::load_state(in);
+  in.read(ind_per_km2);
+}
+
+void HerbivoreCohort::save_state(CheckpointWriter& out) const {
+  HerbivoreBase::save_state(out);
+  out.write(ind_per_km2);
+}
@@ -21,13 +21,17 @@ namespace Fauna {
  * individuals have the same age.
  * \see \ref sec_design_the_herbivore
  * \see \ref sec_herbivore_cohorts
+ *
+ * The class is `final` so that the compiler can resolve calls through a
+ * `HerbivoreCohort` reference without the virtual table.
+ * \see \ref sec_design_static_dispatch
  */
-class HerbivoreCohort : public HerbivoreBase {
+class HerbivoreCohort final : public HerbivoreBase {
  public:
   // -------- HerbivoreInterface ----------
   virtual double get_ind_per_km2() const { return ind_per_km2; }
   /// A cohort is dead if its density is zero.
-  virtual bool is_dead() const;
+  virtual bool is_dead() const { return ind_per_km2 <= 0.0; }
   virtual void kill() { ind_per_km2 = 0.0; }
 
  public:
@@ -44,9 +48,12 @@ class HerbivoreCohort : public HerbivoreBase {
    *
    * \param ind_per_km2 Initial individual density [ind/km²].
    * Can be 0.0, but must not be negative.
+   * \warning Only a plain pointer to the HFT and a reference to the gross
+   * energy are kept. Both must outlive the herbivore. The population and
+   * \ref CreateHerbivoreCohort take care of that.
    */
   HerbivoreCohort(const int age_days, const double body_condition,
-                  std::shared_ptr<const Hft> hft, const Sex sex,
+                  const Hft& hft, const Sex sex,
                   const double ind_per_km2,
                   const ForageEnergyContent& forage_gross_energy);
 
@@ -60,8 +67,11 @@ class HerbivoreCohort : public HerbivoreBase {
    *
    * \param ind_per_km2 Initial individual density [ind/km²].
    * Can be 0.0, but must not be negative.
+   * \warning Only a plain pointer to the HFT and a reference to the gross
+   * energy are kept. Both must outlive the herbivore. The population and
+   * \ref CreateHerbivoreCohort take care of that.
    */
-  HerbivoreCohort(std::shared_ptr<const Hft> hft, const Sex sex,
+  HerbivoreCohort(const Hft& hft, const Sex sex,
                   const double ind_per_km2,
                   const ForageEnergyContent& forage_gross_energy);
 
@@ -95,12 +105,18 @@ class HerbivoreCohort : public HerbivoreBase {
    */
   void merge(HerbivoreCohort& other);
 
+  /** \copydoc HerbivoreBase::load_state() */
+  virtual void load_state(CheckpointReader& in);
+
+  /** \copydoc HerbivoreBase::save_state() */
+  virtual void save_state(CheckpointWriter& out) const;
+
  protected:
   // -------- HerbivoreBase ---------------
   virtual void apply_mortality(const double mortality);
 
  private:
-  double ind_per_km2;
+  StorageReal ind_per_km2;
 };
 
 }  // namespace Fauna
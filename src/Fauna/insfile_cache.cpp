@@ -0,0 +1,307 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Binary cache of a parsed and validated instruction file.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "insfile_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "checkpoint.h"
+
+using namespace Fauna;
+
+namespace {
+/// Identifies a file as instruction file cache.
+const char CACHE_MAGIC[] = "MMMINSCA";
+
+/// Version of the binary cache format.
+/**
+ * Increment this whenever a member variable is added to \ref Parameters or
+ * \ref Hft, or when the values of an enumeration change.
+ */
+const std::uint32_t CACHE_VERSION = 2;
+
+/// Marker to detect caches written with a different byte order.
+const std::uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+/// Append a set of enum values.
+template <class T>
+void write_set(CheckpointWriter& out, const std::set<T>& value) {
+  out.write((std::uint64_t)value.size());
+  for (const auto& i : value) out.write(i);
+}
+
+/// Read a set of enum values.
+template <class T>
+void read_set(CheckpointReader& in, std::set<T>& value) {
+  std::uint64_t size;
+  in.read(size);
+  value.clear();
+  for (std::uint64_t i = 0; i < size; i++) {
+    T item;
+    in.read(item);
+    value.insert(item);
+  }
+}
+
+/// Append all member variables of the text table options.
+void write_options(CheckpointWriter& out,
+                   const Output::TextTableWriterOptions& value) {
+  out.write(value.directory);
+  out.write(value.precision);
+  out.write(value.shards);
+  out.write(value.index);
+  out.write(value.available_forage);
+  out.write(value.digestibility);
+  out.write(value.body_fat);
+  out.write(value.eaten_nitrogen_per_ind);
+  out.write(value.individual_density);
+  out.write(value.mass_density);
+  out.write(value.mass_density_per_hft);
+  out.write(value.eaten_forage_per_ind);
+}
+
+/// Read all member variables of the text table options.
+void read_options(CheckpointReader& in,
+                  Output::TextTableWriterOptions& value) {
+  in.read(value.directory);
+  in.read(value.precision);
+  in.read(value.shards);
+  in.read(value.index);
+  in.read(value.available_forage);
+  in.read(value.digestibility);
+  in.read(value.body_fat);
+  in.read(value.eaten_nitrogen_per_ind);
+  in.read(value.individual_density);
+  in.read(value.mass_density);
+  in.read(value.mass_density_per_hft);
+  in.read(value.eaten_forage_per_ind);
+}
+
+/// Append all member variables of the global parameters.
+void write_params(CheckpointWriter& out, const Parameters& value) {
+  out.write(value.forage_distribution);
+  out.write(value.forage_gross_energy);
+  out.write(value.herbivore_establish_interval);
+  out.write(value.herbivore_type);
+  out.write(value.one_hft_per_habitat);
+  out.write(value.output_async);
+  out.write(value.output_async_queue_size);
+  out.write(value.output_format);
+  out.write(value.output_interval);
+  write_options(out, value.output_text_tables);
+}
+
+/// Read all member variables of the global parameters.
+void read_params(CheckpointReader& in, Parameters& value) {
+  in.read(value.forage_distribution);
+  in.read(value.forage_gross_energy);
+  in.read(value.herbivore_establish_interval);
+  in.read(value.herbivore_type);
+  in.read(value.one_hft_per_habitat);
+  in.read(value.output_async);
+  in.read(value.output_async_queue_size);
+  in.read(value.output_format);
+  in.read(value.output_interval);
+  read_options(in, value.output_text_tables);
+}
+
+/// Append all member variables of an HFT.
+void write_hft(CheckpointWriter& out, const Hft& value) {
+  out.write(value.name);
+  out.write(value.body_fat_birth);
+  out.write(value.body_fat_catabolism_efficiency);
+  out.write(value.body_fat_deviation);
+  out.write(value.body_fat_gross_energy);
+  out.write(value.body_fat_maximum);
+  out.write(value.body_fat_maximum_daily_gain);
+  out.write(value.body_mass_birth);
+  out.write(value.body_mass_empty);
+  out.write(value.body_mass_female);
+  out.write(value.body_mass_male);
+  out.write(value.breeding_season_length);
+  out.write(value.breeding_season_start);
+  out.write(value.digestion_allometric);
+  out.write(value.digestion_digestibility_multiplier);
+  out.write(value.digestion_i_g_1992_ijk);
+  out.write(value.digestion_fixed_fraction);
+  out.write(value.digestion_limit);
+  out.write(value.digestion_me_coefficient);
+  out.write(value.digestion_k_fat);
+  out.write(value.digestion_k_maintenance);
+  out.write(value.digestion_net_energy_model);
+  out.write(value.establishment_age_range.first);
+  out.write(value.establishment_age_range.second);
+  out.write(value.establishment_density);
+  out.write(value.expenditure_basal_rate);
+  write_set(out, value.expenditure_components);
+  out.write(value.expenditure_fmr_multiplier);
+  out.write(value.foraging_diet_composer);
+  write_set(out, value.foraging_limits);
+  out.write(value.foraging_half_max_intake_density);
+  out.write(value.life_history_lifespan);
+  out.write(value.life_history_physical_maturity_female);
+  out.write(value.life_history_physical_maturity_male);
+  out.write(value.life_history_sexual_maturity);
+  out.write(value.mortality_adult_rate);
+  write_set(out, value.mortality_factors);
+  out.write(value.mortality_juvenile_rate);
+  out.write(value.mortality_minimum_density_threshold);
+  out.write(value.mortality_shift_body_condition_for_starvation);
+  out.write(value.reproduction_annual_maximum);
+  out.write(value.reproduction_gestation_length);
+  out.write(value.reproduction_logistic);
+  out.write(value.reproduction_model);
+  out.write(value.thermoregulation_conductance);
+  out.write(value.thermoregulation_core_temperature);
+}
+
+/// Read all member variables of an HFT.
+void read_hft(CheckpointReader& in, Hft& value) {
+  in.read(value.name);
+  in.read(value.body_fat_birth);
+  in.read(value.body_fat_catabolism_efficiency);
+  in.read(value.body_fat_deviation);
+  in.read(value.body_fat_gross_energy);
+  in.read(value.body_fat_maximum);
+  in.read(value.body_fat_maximum_daily_gain);
+  in.read(value.body_mass_birth);
+  in.read(value.body_mass_empty);
+  in.read(value.body_mass_female);
+  in.read(value.body_mass_male);
+  in.read(value.breeding_season_length);
+  in.read(value.breeding_season_start);
+  in.read(value.digestion_allometric);
+  in.read(value.digestion_digestibility_multiplier);
+  in.read(value.digestion_i_g_1992_ijk);
+  in.read(value.digestion_fixed_fraction);
+  in.read(value.digestion_limit);
+  in.read(value.digestion_me_coefficient);
+  in.read(value.digestion_k_fat);
+  in.read(value.digestion_k_maintenance);
+  in.read(value.digestion_net_energy_model);
+  in.read(value.establishment_age_range.first);
+  in.read(value.establishment_age_range.second);
+  in.read(value.establishment_density);
+  in.read(value.expenditure_basal_rate);
+  read_set(in, value.expenditure_components);
+  in.read(value.expenditure_fmr_multiplier);
+  in.read(value.foraging_diet_composer);
+  read_set(in, value.foraging_limits);
+  in.read(value.foraging_half_max_intake_density);
+  in.read(value.life_history_lifespan);
+  in.read(value.life_history_physical_maturity_female);
+  in.read(value.life_history_physical_maturity_male);
+  in.read(value.life_history_sexual_maturity);
+  in.read(value.mortality_adult_rate);
+  read_set(in, value.mortality_factors);
+  in.read(value.mortality_juvenile_rate);
+  in.read(value.mortality_minimum_density_threshold);
+  in.read(value.mortality_shift_body_condition_for_starvation);
+  in.read(value.reproduction_annual_maximum);
+  in.read(value.reproduction_gestation_length);
+  in.read(value.reproduction_logistic);
+  in.read(value.reproduction_model);
+  in.read(value.thermoregulation_conductance);
+  in.read(value.thermoregulation_core_temperature);
+}
+
+/// A file name next to `filename` that no other thread or process uses.
+std::string get_temporary_filename(const std::string& filename) {
+  const std::size_t id =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+      (std::size_t)std::chrono::steady_clock::now().time_since_epoch().count();
+  return filename + ".tmp" + std::to_string(id);
+}
+}  // namespace
+
+std::uint64_t Fauna::get_hft_hash(const Hft& hft) {
+  CheckpointWriter out;
+  write_hft(out, hft);
+  const std::vector<char>& buffer = out.get_buffer();
+  return get_fnv1a_hash(std::string(buffer.begin(), buffer.end()));
+}
+
+std::uint64_t Fauna::get_fnv1a_hash(const std::string& data) {
+  std::uint64_t hash = 14695981039346656037ULL;  // offset basis
+  for (const char c : data) {
+    hash ^= (unsigned char)c;
+    hash *= 1099511628211ULL;  // FNV prime
+  }
+  return hash;
+}
+
+bool InsfileCache::load(const std::string& filename,
+                        const std::uint64_t key) {
+  try {
+    CheckpointReader in(filename);
+    char magic[sizeof(CACHE_MAGIC)];
+    in.read(magic);
+    std::uint32_t version, byte_order;
+    in.read(version);
+    in.read(byte_order);
+    std::uint64_t file_key;
+    in.read(file_key);
+    if (std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        version != CACHE_VERSION || byte_order != CACHE_BYTE_ORDER ||
+        file_key != key)
+      return false;
+
+    InsfileCache result;
+    result.key = file_key;
+    read_params(in, result.params);
+    std::uint64_t hft_count;
+    in.read(hft_count);
+    for (std::uint64_t i = 0; i < hft_count; i++) {
+      std::shared_ptr<Hft> hft(new Hft);
+      read_hft(in, *hft);
+      result.hfts.push_back(hft);
+    }
+    in.read(result.warnings);
+    if (!in.at_end()) return false;
+    *this = result;
+    return true;
+  } catch (const std::runtime_error&) {
+    // The file doesn’t exist or is truncated.
+    return false;
+  }
+}
+
+void InsfileCache::save(const std::string& filename) const {
+  CheckpointWriter out;
+  out.write(CACHE_MAGIC);
+  out.write(CACHE_VERSION);
+  out.write(CACHE_BYTE_ORDER);
+  out.write(key);
+  write_params(out, params);
+  out.write((std::uint64_t)hfts.size());
+  for (const auto& hft : hfts) write_hft(out, *hft);
+  out.write(warnings);
+
+  const std::string temporary = get_temporary_filename(filename);
+  out.write_to_file(temporary);
+  // On POSIX systems, rename() atomically replaces an existing file.
+  if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+    // On Windows, rename() fails if the destination exists.
+    std::remove(filename.c_str());
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+      std::remove(temporary.c_str());
+      throw std::runtime_error(
+          "Fauna::InsfileCache::save() "
+          "Could not write cache file \"" +
+          filename + "\".");
+    }
+  }
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Binary cache of a parsed and validated instruction file.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_INSFILE_CACHE_H
+#define FAUNA_INSFILE_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include "hft.h"
+#include "parameters.h"
+
+namespace Fauna {
+
+/// 64-bit FNV-1a hash of a byte string.
+/**
+ * This is not a cryptographic hash. It only serves to detect that an
+ * instruction file has changed.
+ */
+std::uint64_t get_fnv1a_hash(const std::string& data);
+
+/// 64-bit FNV-1a hash of all member variables of an HFT.
+/**
+ * Checkpoints store this to detect that the HFT parameters have changed.
+ * \see \ref World::load_checkpoint()
+ */
+std::uint64_t get_hft_hash(const Hft& hft);
+
+/// Parsed content of an instruction file, stored in a binary file.
+/**
+ * Parsing the TOML file and validating all HFTs takes much longer than
+ * reading the binary representation. If many \ref World objects are
+ * created from the same instruction file (e.g. in every MPI rank), the
+ * first one can write the cache and all others only read it.
+ *
+ * The cache is keyed by the hash of the instruction file content. If the
+ * instruction file changes, the cache is stale and will be replaced. Like a
+ * checkpoint, the cache is not portable between platforms.
+ *
+ * \warning Every new member variable of \ref Parameters or \ref Hft must be
+ * added to the functions in `insfile_cache.cpp`, and the cache version must
+ * be incremented.
+ * \see \ref sec_design_insfile_cache
+ */
+struct InsfileCache {
+  /// Hash of the instruction file content.
+  std::uint64_t key = 0;
+  /// Global simulation parameters.
+  Parameters params;
+  /// Herbivore functional types.
+  HftList hfts;
+  /// Warnings from reading the instruction file.
+  std::string warnings;
+
+  /// Read the cache from a file.
+  /**
+   * \param filename Path to the cache file.
+   * \param key Expected hash of the instruction file.
+   * \return true if the file exists, is compatible, and matches `key`.
+   * false if the instruction file needs to be parsed.
+   */
+  bool load(const std::string& filename, const std::uint64_t key);
+
+  /// Write the cache to a file atomically.
+  /**
+   * The data is first written to a temporary file in the same directory,
+   * which is then renamed. So concurrent readers never see a partially
+   * written file, and concurrent writers don’t corrupt it.
+   * \throw std::runtime_error If the file cannot be written.
+   */
+  void save(const std::string& filename) const;
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_INSFILE_CACHE_H
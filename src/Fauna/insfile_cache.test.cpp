@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the binary instruction file cache.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "insfile_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "catch.hpp"
+#include "insfile_reader.h"
+#include "world.h"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::get_fnv1a_hash()", "") {
+  // Reference values of the FNV-1a 64-bit hash.
+  CHECK(get_fnv1a_hash("") == 0xcbf29ce484222325ULL);
+  CHECK(get_fnv1a_hash("a") == 0xaf63dc4c8601ec8cULL);
+  CHECK(get_fnv1a_hash("foobar") == 0x85944171f73967e8ULL);
+}
+
+TEST_CASE("Fauna::InsfileCache", "") {
+  // The example instruction file has been copied to the build directory by
+  // CMake.
+  const std::string INSFILE = "megafauna.toml";
+  const std::string CACHE = "insfile_cache_test.bin";
+  std::remove(CACHE.c_str());
+
+  const InsfileReader reader(INSFILE);
+  InsfileCache cache;
+  cache.key = 42;
+  cache.params = reader.get_params();
+  cache.params.output_text_tables.directory = "some/directory";
+  cache.hfts = reader.get_hfts();
+  cache.warnings = "a warning";
+  REQUIRE(!cache.hfts.empty());
+
+  InsfileCache loaded;
+  CHECK(!loaded.load(CACHE, 42));  // file doesn’t exist
+  cache.save(CACHE);
+
+  SECTION("Round trip") {
+    REQUIRE(loaded.load(CACHE, 42));
+    CHECK(loaded.key == 42);
+    CHECK(loaded.warnings == "a warning");
+    CHECK(loaded.params.output_text_tables.directory == "some/directory");
+    CHECK(loaded.params.output_interval == cache.params.output_interval);
+    CHECK(loaded.params.forage_gross_energy ==
+          cache.params.forage_gross_energy);
+    REQUIRE(loaded.hfts.size() == cache.hfts.size());
+    const Hft& a = *cache.hfts.front();
+    const Hft& b = *loaded.hfts.front();
+    CHECK(a.name == b.name);
+    CHECK(a.body_mass_male == b.body_mass_male);
+    CHECK(a.establishment_age_range == b.establishment_age_range);
+    CHECK(a.expenditure_components == b.expenditure_components);
+    CHECK(a.mortality_factors == b.mortality_factors);
+    CHECK(a.reproduction_logistic == b.reproduction_logistic);
+    CHECK(a.thermoregulation_core_temperature ==
+          b.thermoregulation_core_temperature);
+    CHECK(b.is_valid(loaded.params));
+  }
+
+  SECTION("Stale cache") { CHECK(!loaded.load(CACHE, 43)); }
+
+  SECTION("Corrupt cache") {
+    std::ofstream(CACHE, std::ios::app) << "garbage";
+    CHECK(!loaded.load(CACHE, 42));
+  }
+
+  std::remove(CACHE.c_str());
+}
+
+TEST_CASE("Fauna::World with instruction file cache", "") {
+  const std::string INSFILE = "megafauna.toml";
+  const std::string CACHE = "world_insfile_cache_test.bin";
+  std::remove(CACHE.c_str());
+
+  // The first World parses the instruction file and writes the cache.
+  const World parsed(INSFILE, SimMode::Lint, CACHE);
+  InsfileCache cache;
+  std::string content;
+  {
+    std::ifstream file(INSFILE, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+  }
+  REQUIRE(cache.load(CACHE, get_fnv1a_hash(content)));
+  CHECK(cache.params.herbivore_establish_interval ==
+        parsed.get_params().herbivore_establish_interval);
+
+  // Change the cache to see that the next World reads it.
+  cache.params.herbivore_establish_interval = 1234;
+  cache.save(CACHE);
+  const World cached(INSFILE, SimMode::Lint, CACHE);
+  CHECK(cached.get_params().herbivore_establish_interval == 1234);
+
+  // A changed instruction file makes the cache stale.
+  const std::string CHANGED = "world_insfile_cache_test.toml";
+  std::ofstream(CHANGED) << content << "\n# A comment\n";
+  const World reparsed(CHANGED, SimMode::Lint, CACHE);
+  CHECK(reparsed.get_params().herbivore_establish_interval ==
+        parsed.get_params().herbivore_establish_interval);
+
+  std::remove(CHANGED.c_str());
+  std::remove(CACHE.c_str());
+}
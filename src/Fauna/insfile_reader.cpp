@@ -11,7 +11,6 @@
 #include "insfile_reader.h"
 
 #include <algorithm>
-#include <iostream>
 #include <string>
 
 #include "forage_types.h"
@@ -66,8 +65,7 @@ InsfileReader::InsfileReader(const std::string filename)
     if (!params_valid)
       throw std::runtime_error("Parameters are not valid:\n" + err_msg);
     else if (!err_msg.empty())
-      std::cerr << "Parameters are valid, but there were warnings:\n"
-                << err_msg;
+      warnings += "Parameters are valid, but there were warnings:\n" + err_msg;
   }
 
   if (params.herbivore_type == HerbivoreType::Cohort) {
@@ -81,8 +79,8 @@ InsfileReader::InsfileReader(const std::string filename)
           throw std::runtime_error("HFT \"" + new_hft->name +
                                    "\" is not valid:\n" + err_msg);
         else if (!err_msg.empty())
-          std::cerr << "HFT \"" + new_hft->name +
-                           "\" is valid, but there were warnings:\n" + err_msg;
+          warnings += "HFT \"" + new_hft->name +
+                      "\" is valid, but there were warnings:\n" + err_msg;
         // Add HFT to list, but check if HFT with that name already exists.
         for (const auto& hft : hfts) {
           assert(hft.get());
@@ -838,15 +836,27 @@ void InsfileReader::read_table_forage() {
 }
 
 void InsfileReader::read_table_output() {
+  {
+    const auto key = "output.async";
+    auto value = get_value<bool>(ins, key);
+    if (value) params.output_async = *value;
+  }
+  {
+    const auto key = "output.async_queue_size";
+    auto value = get_value<int>(ins, key);
+    if (value) params.output_async_queue_size = *value;
+  }
   {
     const auto key = "output.format";
     auto value = get_value<std::string>(ins, key);
     if (value) {
       if (lowercase(*value) == lowercase("TextTables"))
         params.output_format = OutputFormat::TextTables;
+      else if (lowercase(*value) == lowercase("InMemory"))
+        params.output_format = OutputFormat::InMemory;
       // -> Add new output formats here.
       else
-        throw invalid_option(key, *value, {"TextTables"});
+        throw invalid_option(key, *value, {"TextTables", "InMemory"});
     } else
       throw missing_parameter(key);
   }
@@ -882,11 +892,21 @@ void InsfileReader::read_table_output_text_tables() {
     else
       throw missing_parameter(key);
   }
+  {
+    const auto key = "output.text_tables.index";
+    auto value = get_value<bool>(ins, key);
+    if (value) params.output_text_tables.index = *value;
+  }
   {
     const auto key = "output.text_tables.precision";
     auto value = get_value<int>(ins, key);
     if (value) params.output_text_tables.precision = *value;
   }
+  {
+    const auto key = "output.text_tables.shards";
+    auto value = get_value<int>(ins, key);
+    if (value) params.output_text_tables.shards = *value;
+  }
   {
     const auto key = "output.text_tables.tables";
     auto value = get_value_array<std::string>(ins, key);
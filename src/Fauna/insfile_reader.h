@@ -206,6 +206,14 @@ class InsfileReader {
   /// Get the global parameters that were read from the instruction file.
   const Parameters& get_params() const { return params; };
 
+  /// Warnings about valid, but questionable parameters.
+  /**
+   * The reader doesn’t print anything itself. It is up to the caller to
+   * show the warnings to the user.
+   * \return Human-readable lines of text, or an empty string.
+   */
+  const std::string& get_warnings() const { return warnings; }
+
  private:
   /// Find table with group.
   /**
@@ -347,6 +355,7 @@ class InsfileReader {
 
   Parameters params;
   HftList hfts;
+  std::string warnings;
 };
 }  // namespace Fauna
 
@@ -10,6 +10,9 @@
  */
 #include "insfile_reader.h"
 
+#include <cstdio>
+#include <fstream>
+
 #include "catch.hpp"
 #include "fileystem.h"
 #include "hft.h"
@@ -47,5 +50,25 @@ TEST_CASE("Fauna::InsfileReader") {
         CHECK(msg.empty());  // There should also be no warnings.
       }
     }
+    CHECK(reader.get_warnings().empty());
+  }
+
+  SECTION("Collect warnings") {
+    // A deprecated output table is valid, but issues a warning.
+    const std::string INSFILE = "insfile_reader_test_warnings.toml";
+    {
+      std::ifstream in("megafauna.toml");
+      std::ofstream out(INSFILE);
+      std::string line;
+      while (std::getline(in, line)) {
+        out << line << '\n';
+        if (line.compare(0, 8, "tables =") == 0)
+          out << "  \"mass_density_per_hft\",\n";
+      }
+    }
+    const InsfileReader reader(INSFILE);
+    CHECK(reader.get_warnings().find("mass_density_per_hft") !=
+          std::string::npos);
+    std::remove(INSFILE.c_str());
   }
 }
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Check instruction files without running a simulation.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "lint.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "world.h"
+
+using namespace Fauna;
+
+LintResult Fauna::lint_instruction_file(const std::string& filename) {
+  LintResult result;
+  result.filename = filename;
+  try {
+    const World world(filename, SimMode::Lint);
+    result.warnings = world.get_warnings();
+    result.valid = true;
+  } catch (const std::exception& e) {
+    result.errors = e.what();
+  }
+  return result;
+}
+
+std::vector<LintResult> Fauna::lint_instruction_files(
+    const std::vector<std::string>& filenames, int threads) {
+  std::vector<LintResult> results(filenames.size());
+  if (threads <= 0)
+    threads = std::max(1, (int)std::thread::hardware_concurrency());
+  threads = std::min<int>(threads, filenames.size());
+
+  // Each worker takes the next file that nobody has started yet. Every
+  // result is written by only one thread.
+  std::atomic<int> next(0);
+  const auto worker = [&]() {
+    for (int i = next++; i < (int)filenames.size(); i = next++)
+      results[i] = lint_instruction_file(filenames[i]);
+  };
+  std::vector<std::thread> pool;
+  for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+  worker();  // The calling thread helps, too.
+  for (auto& t : pool) t.join();
+  return results;
+}
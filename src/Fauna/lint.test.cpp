@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for checking instruction files.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "lint.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "catch.hpp"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::lint_instruction_file()", "") {
+  // The example instruction file has been copied to the build directory by
+  // CMake.
+  const std::string GOOD = "megafauna.toml";
+  const std::string MISSING = "this/file/does/not/exist.toml";
+  const std::string BAD = "lint_test_bad.toml";
+  std::ofstream(BAD) << "[simulation]\n";
+
+  const LintResult good = lint_instruction_file(GOOD);
+  CHECK(good.filename == GOOD);
+  CHECK(good.valid);
+  CHECK(good.errors.empty());
+  CHECK(good.warnings.empty());
+
+  const LintResult missing = lint_instruction_file(MISSING);
+  CHECK(!missing.valid);
+  CHECK(!missing.errors.empty());
+
+  const LintResult bad = lint_instruction_file(BAD);
+  CHECK(!bad.valid);
+  CHECK(bad.errors.find("Missing mandatory parameter") != std::string::npos);
+
+  SECTION("In parallel") {
+    std::vector<std::string> files;
+    for (int i = 0; i < 10; i++) {
+      files.push_back(GOOD);
+      files.push_back(BAD);
+    }
+    const std::vector<LintResult> results = lint_instruction_files(files, 4);
+    REQUIRE(results.size() == files.size());
+    for (std::size_t i = 0; i < files.size(); i++) {
+      CHECK(results[i].filename == files[i]);
+      CHECK(results[i].valid == (files[i] == GOOD));
+      CHECK(results[i].errors == (i % 2 ? bad.errors : good.errors));
+    }
+    CHECK(lint_instruction_files({}).empty());
+  }
+
+  std::remove(BAD.c_str());
+}
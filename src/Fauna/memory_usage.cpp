@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Estimated memory use of a megafauna world.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "memory_usage.h"
+
+using namespace Fauna;
+
+void MemoryUsage::print(std::ostream& stream) const {
+  stream << "simulation_units: " << simulation_units << " bytes ("
+         << simulation_unit_count << ")\n"
+         << "populations: " << populations << " bytes (" << population_count
+         << ")\n"
+         << "cohorts: " << cohorts << " bytes (" << cohort_count << ")\n"
+         << "output_buffers: " << output_buffers << " bytes\n"
+         << "aggregator: " << aggregator << " bytes\n"
+         << "total: " << get_total() << " bytes\n";
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Pool allocation of fixed-size nodes for node-based containers.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "node_pool.h"
+
+#include <cassert>
+#include <stdexcept>
+
+using namespace Fauna;
+
+namespace {
+/// Round a node size up so that every node in a chunk is well aligned.
+std::size_t round_up(const std::size_t size) {
+  const std::size_t align = alignof(std::max_align_t);
+  const std::size_t min_size = size < sizeof(void*) ? sizeof(void*) : size;
+  return (min_size + align - 1) / align * align;
+}
+}  // namespace
+
+NodePool::NodePool(const std::size_t nodes_per_chunk)
+    : nodes_per_chunk(nodes_per_chunk) {
+  if (nodes_per_chunk == 0)
+    throw std::invalid_argument(
+        "Fauna::NodePool::NodePool() "
+        "Parameter `nodes_per_chunk` is zero.");
+}
+
+void NodePool::add_chunk() {
+  char* chunk =
+      static_cast<char*>(::operator new(node_size * nodes_per_chunk));
+  chunks.push_back(chunk);
+  next_fresh = chunk;
+  fresh_count = nodes_per_chunk;
+  statistics.chunks++;
+  statistics.capacity += nodes_per_chunk;
+  statistics.bytes += node_size * nodes_per_chunk;
+}
+
+void* NodePool::allocate(const std::size_t size) {
+  if (node_size == 0) node_size = round_up(size);
+  if (round_up(size) != node_size) return ::operator new(size);
+
+  statistics.allocations++;
+  statistics.in_use++;
+  if (free_list) {
+    statistics.reuses++;
+    FreeNode* node = free_list;
+    free_list = node->next;
+    return node;
+  }
+  if (fresh_count == 0) add_chunk();
+  assert(fresh_count > 0);
+  void* node = next_fresh;
+  next_fresh += node_size;
+  fresh_count--;
+  return node;
+}
+
+void NodePool::deallocate(void* p, const std::size_t size) {
+  if (round_up(size) != node_size) {
+    ::operator delete(p);
+    return;
+  }
+  assert(statistics.in_use > 0);
+  FreeNode* node = static_cast<FreeNode*>(p);
+  node->next = free_list;
+  free_list = node;
+  statistics.in_use--;
+}
+
+void NodePool::free_chunks() {
+  for (auto chunk : chunks) ::operator delete(chunk);
+  chunks.clear();
+  free_list = NULL;
+  next_fresh = NULL;
+  fresh_count = 0;
+  statistics.chunks = 0;
+  statistics.capacity = 0;
+  statistics.bytes = 0;
+}
+
+bool NodePool::release() {
+  if (statistics.in_use > 0) return false;
+  free_chunks();
+  return true;
+}
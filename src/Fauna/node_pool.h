@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Pool allocation of fixed-size nodes for node-based containers.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_NODE_POOL_H
+#define FAUNA_NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "Fauna/pool_statistics.h"
+
+namespace Fauna {
+
+/// Hands out memory for nodes of one size from large chunks.
+/**
+ * The node size is set by the first allocation. Freed nodes go into a free
+ * list and are reused before untouched memory of the last chunk is handed
+ * out. Allocations of any other size are passed through to the global
+ * `operator new`.
+ *
+ * Chunks are only returned to the system when the pool is destroyed or when
+ * \ref release() is called while no node is in use.
+ *
+ * The pool is not thread-safe. Each \ref CohortPopulation owns one pool, and
+ * a population is only changed by one thread at a time.
+ * \see \ref sec_design_node_pools
+ */
+class NodePool {
+ public:
+  /// Constructor
+  /**
+   * \param nodes_per_chunk How many nodes to reserve at once.
+   * \throw std::invalid_argument If `nodes_per_chunk` is zero.
+   */
+  explicit NodePool(const std::size_t nodes_per_chunk = 32);
+
+  /// Destructor: Release all chunks.
+  ~NodePool() { free_chunks(); }
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  /// Get memory for one node.
+  /**
+   * \param size Size of the node in bytes.
+   * \throw std::bad_alloc If the system is out of memory.
+   */
+  void* allocate(const std::size_t size);
+
+  /// Give back memory that \ref allocate() has returned.
+  /**
+   * \param p The pointer returned by \ref allocate().
+   * \param size The same size as passed to \ref allocate().
+   */
+  void deallocate(void* p, const std::size_t size);
+
+  /// Current memory use.
+  const PoolStatistics& get_statistics() const { return statistics; }
+
+  /// Return all chunks to the system if no node is in use.
+  /** \return True if the chunks have been released. */
+  bool release();
+
+ private:
+  /// An unused node is reinterpreted as a link in the free list.
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  /// Append a chunk whose nodes are handed out by \ref next_fresh.
+  void add_chunk();
+
+  void free_chunks();
+
+  const std::size_t nodes_per_chunk;
+  /// Size of one node in bytes, or zero before the first allocation.
+  std::size_t node_size = 0;
+  std::vector<char*> chunks;
+  /// Nodes that have been freed, to be reused first.
+  FreeNode* free_list = NULL;
+  /// Next never-used node in the last chunk.
+  char* next_fresh = NULL;
+  /// Number of never-used nodes in the last chunk.
+  std::size_t fresh_count = 0;
+  PoolStatistics statistics;
+};
+
+/// Standard allocator that takes single elements from a \ref NodePool.
+/**
+ * Node-based containers like `std::list` allocate one node at a time, and
+ * those allocations are served by the pool. Larger allocations fall back to
+ * the global `operator new`. The pool must outlive the container.
+ * \tparam T The value type.
+ */
+template <class T>
+class PoolAllocator {
+ public:
+  typedef T value_type;
+
+  /// Constructor
+  /** \param pool Non-owning pointer to the pool; must not be NULL. */
+  explicit PoolAllocator(NodePool* pool) : pool(pool) {}
+
+  /// Conversion constructor, used by the container to rebind the type.
+  template <class U>
+  PoolAllocator(const PoolAllocator<U>& other) : pool(other.get_pool()) {}
+
+  /// Reserve memory for `n` objects.
+  T* allocate(const std::size_t n) {
+    if (n == 1) return static_cast<T*>(pool->allocate(sizeof(T)));
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  /// Release memory from \ref allocate().
+  void deallocate(T* p, const std::size_t n) {
+    if (n == 1)
+      pool->deallocate(p, sizeof(T));
+    else
+      ::operator delete(p);
+  }
+
+  /// The pool to allocate from.
+  NodePool* get_pool() const { return pool; }
+
+ private:
+  NodePool* pool;
+};
+
+/// Allocators are equal if they share the same pool.
+template <class T, class U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) {
+  return a.get_pool() == b.get_pool();
+}
+
+/// Allocators are equal if they share the same pool.
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) {
+  return !(a == b);
+}
+
+}  // namespace Fauna
+
+#endif  // FAUNA_NODE_POOL_H
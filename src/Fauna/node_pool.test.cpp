@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the node pool allocator.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "node_pool.h"
+
+#include <list>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::NodePool", "") {
+  CHECK_THROWS_AS(NodePool(0), std::invalid_argument);
+
+  NodePool pool(4);
+  CHECK(pool.get_statistics().chunks == 0);
+  CHECK(pool.get_statistics().bytes == 0);
+  CHECK(pool.release());
+
+  typedef std::list<double, PoolAllocator<double> > List;
+  List list{PoolAllocator<double>(&pool)};
+
+  for (int i = 0; i < 5; i++) list.push_back(i);
+  CHECK(pool.get_statistics().in_use == 5);
+  CHECK(pool.get_statistics().chunks == 2);
+  CHECK(pool.get_statistics().capacity == 8);
+  CHECK(pool.get_statistics().bytes > 0);
+  CHECK(pool.get_statistics().allocations == 5);
+  CHECK(pool.get_statistics().reuses == 0);
+  CHECK(!pool.release());
+
+  SECTION("Freed nodes are reused") {
+    list.pop_front();
+    list.pop_front();
+    CHECK(pool.get_statistics().in_use == 3);
+    list.push_back(5);
+    list.push_back(6);
+    CHECK(pool.get_statistics().chunks == 2);
+    CHECK(pool.get_statistics().reuses == 2);
+    CHECK(list.front() == 2.0);
+    CHECK(list.back() == 6.0);
+  }
+
+  SECTION("Release in bulk") {
+    list.clear();
+    CHECK(pool.get_statistics().in_use == 0);
+    CHECK(pool.get_statistics().chunks == 2);
+    CHECK(pool.release());
+    CHECK(pool.get_statistics().chunks == 0);
+    CHECK(pool.get_statistics().capacity == 0);
+    CHECK(pool.get_statistics().bytes == 0);
+    list.push_back(1);
+    CHECK(pool.get_statistics().chunks == 1);
+  }
+
+  SECTION("Other sizes bypass the pool") {
+    PoolAllocator<double> allocator(&pool);
+    double* array = allocator.allocate(3);
+    PoolAllocator<char[1000]>(allocator).deallocate(
+        PoolAllocator<char[1000]>(allocator).allocate(1), 1);
+    allocator.deallocate(array, 3);
+    CHECK(pool.get_statistics().allocations == 5);
+  }
+
+  SECTION("Statistics add up") {
+    PoolStatistics sum;
+    sum += pool.get_statistics();
+    sum += pool.get_statistics();
+    CHECK(sum.in_use == 10);
+    CHECK(sum.chunks == 4);
+    CHECK(sum.allocations == 10);
+  }
+}
@@ -35,6 +35,21 @@ bool Parameters::is_valid(std::string& messages) const {
     is_valid = false;
   }
 
+  if (output_async_queue_size < 1) {
+    stream << "output.async_queue_size must be >=1" << std::endl;
+    is_valid = false;
+  }
+
+  if (output_text_tables.shards < 1) {
+    stream << "output.text_tables.shards must be >=1" << std::endl;
+    is_valid = false;
+  }
+
+  if (output_async && output_format == OutputFormat::InMemory)
+    stream << "'output.async' has no effect with 'output.format = "
+              "\"InMemory\"'."
+           << std::endl;
+
   for (const auto ft : FORAGE_TYPES)
     if (forage_gross_energy[ft] == 0.0)
       stream << "forage.gross_energy." << get_forage_type_name(ft)
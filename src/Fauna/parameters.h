@@ -49,7 +49,13 @@ enum class OutputInterval {
 /// Parameter for selecting the output writer implementation.
 enum class OutputFormat {
   /// Use class \ref Output::TextTableWriter.
-  TextTables
+  TextTables,
+  /// Pass output to the host program with class \ref Output::MemoryWriter.
+  /**
+   * \see \ref World::set_output_callback()
+   * \see \ref World::retrieve_output()
+   */
+  InMemory
 };
 
 /// Parameters for the herbivory module.
@@ -100,6 +106,21 @@ struct Parameters {
   /** @} */
 
   /** @{ \name "output": General output options. */
+  /// Whether to write output in a background thread.
+  /**
+   * If enabled, finished datapoints are queued and written by a separate
+   * thread (\ref Output::AsyncWriter) so that the simulation doesn’t wait for
+   * disk I/O.
+   */
+  bool output_async = false;
+
+  /// Maximum number of datapoints waiting to be written in the background.
+  /**
+   * Only relevant if \ref output_async is enabled. If the queue is full, the
+   * simulation waits until the writer thread has caught up.
+   */
+  int output_async_queue_size = 64;
+
   /// The module that writes megafauna output to disk.
   OutputFormat output_format = OutputFormat::TextTables;
 
@@ -10,31 +10,47 @@
  */
 #include "population_interface.h"
 
+#include <stdexcept>
+
 #include "herbivore_interface.h"
 
 using namespace Fauna;
 
+void PopulationInterface::for_each(
+    const std::function<void(const HerbivoreInterface&)>& function) const {
+  for (const auto& herbivore : get_list()) function(*herbivore);
+}
+
+void PopulationInterface::for_each(
+    const std::function<void(HerbivoreInterface&)>& function) {
+  for (const auto& herbivore : get_list()) function(*herbivore);
+}
+
 const double PopulationInterface::get_kg_per_km2() const {
   double sum = 0.0;
-  const ConstHerbivoreVector vec = get_list();
-  for (ConstHerbivoreVector::const_iterator itr = vec.begin(); itr != vec.end();
-       itr++)
-    sum += (*itr)->get_kg_per_km2();
+  for_each([&sum](const HerbivoreInterface& h) { sum += h.get_kg_per_km2(); });
   return sum;
 }
 
 const double PopulationInterface::get_ind_per_km2() const {
   double sum = 0.0;
-  const ConstHerbivoreVector vec = get_list();
-  for (ConstHerbivoreVector::const_iterator itr = vec.begin(); itr != vec.end();
-       itr++)
-    sum += (*itr)->get_ind_per_km2();
+  for_each(
+      [&sum](const HerbivoreInterface& h) { sum += h.get_ind_per_km2(); });
   return sum;
 }
 
 void PopulationInterface::kill_all() {
-  HerbivoreVector vec = get_list();
-  for (HerbivoreVector::const_iterator itr = vec.begin(); itr != vec.end();
-       itr++)
-    (*itr)->kill();
+  for_each([](HerbivoreInterface& h) { h.kill(); });
+}
+
+void PopulationInterface::load_state(CheckpointReader& /* in */) {
+  throw std::logic_error(
+      "Fauna::PopulationInterface::load_state() "
+      "Checkpoints are not implemented for this population class.");
+}
+
+void PopulationInterface::save_state(CheckpointWriter& /* out */) const {
+  throw std::logic_error(
+      "Fauna::PopulationInterface::save_state() "
+      "Checkpoints are not implemented for this population class.");
 }
@@ -11,9 +11,18 @@
 #ifndef FAUNA_POPULATION_INTERFACE_H
 #define FAUNA_POPULATION_INTERFACE_H
 
+#include <cstddef>
+#include <functional>
+
+#include "Fauna/memory_usage.h"
+#include "Fauna/pool_statistics.h"
 #include "herbivore_vector.h"
 
 namespace Fauna {
+// Forward declarations
+class CheckpointReader;
+class CheckpointWriter;
+
 /// A container of herbivore objects.
 /**
  * Manages a set of \ref HerbivoreInterface instances. What makes a
@@ -43,12 +52,41 @@ struct PopulationInterface {
   /** \throw std::logic_error If this population is not empty. */
   virtual void establish() = 0;
 
+  /// Whether there are no herbivores (neither living nor dead).
+  bool empty() const { return size() == 0; }
+
+  /// Call a function for each herbivore (including dead ones).
+  /**
+   * Unlike \ref get_list(), this doesn’t allocate any memory in derived
+   * classes that override it. The default implementation iterates over
+   * \ref get_list().
+   * \param function Called once for each herbivore. It must not change the
+   * population.
+   */
+  virtual void for_each(
+      const std::function<void(const HerbivoreInterface&)>& function) const;
+
+  /** \copydoc for_each()const */
+  virtual void for_each(
+      const std::function<void(HerbivoreInterface&)>& function);
+
   /// Get individual density of all herbivores together [ind/km²].
   virtual const double get_ind_per_km2() const;
 
   /// Get mass density of all herbivores together [kg/km²].
   virtual const double get_kg_per_km2() const;
 
+  /// Add this population and its herbivores to a memory report.
+  /**
+   * The default implementation only counts the population and its
+   * herbivores in \ref MemoryUsage::population_count and
+   * \ref MemoryUsage::cohort_count because it cannot know their size.
+   */
+  virtual void add_memory_usage(MemoryUsage& usage) const {
+    usage.population_count++;
+    usage.cohort_count += size();
+  }
+
   /// Get pointers to the herbivores (including dead ones).
   /**
    * \warning The pointers are not guaranteed to stay valid
@@ -62,6 +100,15 @@ struct PopulationInterface {
   /** \copydoc get_list()const */
   virtual HerbivoreVector get_list() = 0;
 
+  /// Memory held by the pool that allocates the herbivores.
+  /**
+   * The default implementation returns zeros for populations that don’t use
+   * a \ref NodePool.
+   */
+  virtual PoolStatistics get_pool_statistics() const {
+    return PoolStatistics();
+  }
+
   /// Mark all herbivores as dead (see \ref HerbivoreInterface::kill()).
   virtual void kill_all();
 
@@ -75,9 +122,31 @@ struct PopulationInterface {
    */
   virtual void kill_nonviable() = 0;
 
+  /// Replace all herbivores with those stored in a checkpoint.
+  /**
+   * The default implementation throws an exception. Derived classes that
+   * support checkpoints must override this and \ref save_state().
+   * \throw std::runtime_error If the checkpoint data is corrupt.
+   * \throw std::logic_error If checkpoints are not implemented.
+   */
+  virtual void load_state(CheckpointReader& in);
+
   /// Delete all dead herbivores.
   /** \see \ref HerbivoreInterface::is_dead() */
   virtual void purge_of_dead() = 0;
+
+  /// Append all herbivores to a checkpoint.
+  /**
+   * \throw std::logic_error If checkpoints are not implemented.
+   * \see \ref load_state()
+   */
+  virtual void save_state(CheckpointWriter& out) const;
+
+  /// Number of herbivore objects (including dead ones).
+  /**
+   * The default implementation counts the elements of \ref get_list().
+   */
+  virtual std::size_t size() const { return get_list().size(); }
 };
 
 }  // namespace Fauna
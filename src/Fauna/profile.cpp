@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Run-time measurements of the simulation phases.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "profile.h"
+
+#include <iomanip>
+#include <stdexcept>
+
+using namespace Fauna;
+
+namespace {
+/// Names of the profile phases in the order of \ref ProfilePhase.
+const std::array<std::string, PROFILE_PHASE_COUNT> PHASE_NAMES = {
+    {"kill_nonviable", "establishment", "simulate_herbivores",
+     "feeding_demand", "feeding_distribute", "feeding_eat", "create_offspring",
+     "purge_of_dead", "get_output", "aggregation", "output_writing"}};
+}  // namespace
+
+const std::string& Fauna::get_profile_phase_name(const ProfilePhase phase) {
+  const int i = static_cast<int>(phase);
+  if (i < 0 || i >= PROFILE_PHASE_COUNT)
+    throw std::logic_error(
+        "Fauna::get_profile_phase_name() "
+        "Profile phase is not implemented.");
+  return PHASE_NAMES[i];
+}
+
+Profile& Profile::operator+=(const Profile& other) {
+  for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    timers[i].seconds += other.timers[i].seconds;
+    timers[i].calls += other.timers[i].calls;
+  }
+  days += other.days;
+  unit_days += other.unit_days;
+  empty_unit_days += other.empty_unit_days;
+  herbivore_days += other.herbivore_days;
+  feeding_iterations += other.feeding_iterations;
+  return *this;
+}
+
+double Profile::get_total_seconds() const {
+  double sum = 0.0;
+  for (const auto& timer : timers) sum += timer.seconds;
+  return sum;
+}
+
+void Profile::print(std::ostream& stream) const {
+  const std::ios::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+  const double total = get_total_seconds();
+  stream << std::left << std::setw(20) << "phase" << std::right
+         << std::setw(12) << "seconds" << std::setw(8) << "%" << std::setw(14)
+         << "calls" << '\n';
+  for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    const Timer& timer = timers[i];
+    stream << std::left << std::setw(20) << PHASE_NAMES[i] << std::right
+           << std::fixed << std::setprecision(6) << std::setw(12)
+           << timer.seconds << std::setprecision(1) << std::setw(8)
+           << (total > 0.0 ? 100.0 * timer.seconds / total : 0.0)
+           << std::setw(14) << timer.calls << '\n';
+  }
+  stream << std::left << std::setw(20) << "total" << std::right
+         << std::setprecision(6) << std::setw(12) << total << '\n';
+  stream << "days: " << days << '\n'
+         << "unit_days: " << unit_days << '\n'
+         << "empty_unit_days: " << empty_unit_days << '\n'
+         << "herbivore_days: " << herbivore_days << '\n'
+         << "feeding_iterations: " << feeding_iterations << '\n';
+  stream.flags(flags);
+  stream.precision(precision);
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::Profile and Fauna::ScopedTimer.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "profile.h"
+
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "catch.hpp"
+#include "scoped_timer.h"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::get_profile_phase_name()", "") {
+  std::set<std::string> names;
+  for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    const std::string& name = get_profile_phase_name((ProfilePhase)i);
+    CHECK(!name.empty());
+    names.insert(name);
+  }
+  // All names are unique.
+  CHECK(names.size() == PROFILE_PHASE_COUNT);
+  CHECK(get_profile_phase_name(ProfilePhase::OutputWriting) ==
+        "output_writing");
+}
+
+TEST_CASE("Fauna::Profile", "") {
+  Profile profile;
+  CHECK(profile.get_total_seconds() == 0.0);
+
+  SECTION("ScopedTimer") {
+    {
+      ScopedTimer timer(&profile, ProfilePhase::FeedingEat);
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    {
+      ScopedTimer timer(&profile, ProfilePhase::FeedingEat);
+    }
+    CHECK(profile[ProfilePhase::FeedingEat].calls == 2);
+    CHECK(profile[ProfilePhase::FeedingEat].seconds >= 0.002);
+    CHECK(profile[ProfilePhase::FeedingDemand].calls == 0);
+    CHECK(profile.get_total_seconds() ==
+          profile[ProfilePhase::FeedingEat].seconds);
+
+    // Without a profile, nothing happens.
+    ScopedTimer timer(NULL, ProfilePhase::FeedingEat);
+  }
+
+  SECTION("print()") {
+    profile.herbivore_days = 42;
+    std::ostringstream stream;
+    profile.print(stream);
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++)
+      CHECK(stream.str().find(get_profile_phase_name((ProfilePhase)i)) !=
+            std::string::npos);
+    CHECK(stream.str().find("herbivore_days: 42") != std::string::npos);
+  }
+
+  SECTION("operator+=()") {
+    profile[ProfilePhase::FeedingEat].seconds = 1.0;
+    profile[ProfilePhase::FeedingEat].calls = 2;
+    profile.unit_days = 3;
+    Profile other;
+    other[ProfilePhase::FeedingEat].seconds = 0.5;
+    other[ProfilePhase::FeedingEat].calls = 1;
+    other.unit_days = 4;
+    other.feeding_iterations = 5;
+    profile += other;
+    CHECK(profile[ProfilePhase::FeedingEat].seconds == 1.5);
+    CHECK(profile[ProfilePhase::FeedingEat].calls == 3);
+    CHECK(profile.unit_days == 7);
+    CHECK(profile.feeding_iterations == 5);
+    CHECK(profile.days == 0);
+  }
+
+  SECTION("reset()") {
+    profile[ProfilePhase::GetOutput].seconds = 1.0;
+    profile[ProfilePhase::GetOutput].calls = 1;
+    profile.days = 1;
+    profile.reset();
+    CHECK(profile[ProfilePhase::GetOutput].seconds == 0.0);
+    CHECK(profile[ProfilePhase::GetOutput].calls == 0);
+    CHECK(profile.days == 0);
+  }
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Measure the run time of a code block for the profile.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_SCOPED_TIMER_H
+#define FAUNA_SCOPED_TIMER_H
+
+#include <chrono>
+
+#include "profile.h"
+
+namespace Fauna {
+
+/// Adds the time from construction to destruction to a profile timer.
+/**
+ * If the profile pointer is NULL, the clock is not read at all. So
+ * instrumented code has practically no overhead if profiling is disabled.
+ *
+ * \code
+ * {
+ *   ScopedTimer timer(profile, ProfilePhase::FeedingEat);
+ *   // ... code to measure ...
+ * }  // The time is added to the profile here.
+ * \endcode
+ */
+class ScopedTimer {
+ public:
+  /// Constructor: Start the timer.
+  /**
+   * \param profile The profile to add the time to. Can be NULL.
+   * \param phase The phase that is measured.
+   */
+  ScopedTimer(Profile* profile, const ProfilePhase phase)
+      : timer(profile ? &(*profile)[phase] : NULL) {
+    if (timer) start = std::chrono::steady_clock::now();
+  }
+
+  /// Delete copy constructor because the time must only be added once.
+  ScopedTimer(ScopedTimer const&) = delete;
+
+  /// Delete copy assignment because the time must only be added once.
+  void operator=(ScopedTimer const&) = delete;
+
+  /// Destructor: Stop the timer and add the elapsed time.
+  ~ScopedTimer() {
+    if (!timer) return;
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    timer->seconds += elapsed.count();
+    timer->calls++;
+  }
+
+ private:
+  Profile::Timer* const timer;
+  std::chrono::steady_clock::time_point start;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_SCOPED_TIMER_H
@@ -14,6 +14,8 @@
 #include "habitat.h"
 #include "herbivore_interface.h"
 #include "population_interface.h"
+#include "scoped_timer.h"
+#include "tracer.h"
 #include "simulation_unit.h"
 
 using namespace Fauna;
@@ -23,14 +25,21 @@ using namespace Fauna;
 //============================================================
 
 SimulateDay::SimulateDay(const int day_of_year, SimulationUnit& simulation_unit,
-                         const FeedHerbivores& feed_herbivores)
+                         const FeedHerbivores& feed_herbivores,
+                         Profile* profile, Tracer* tracer,
+                         const int unit_index)
     : day_of_year(day_of_year),
       environment(simulation_unit.get_habitat().get_environment()),
       feed_herbivores(feed_herbivores),
       herbivores(get_herbivores(simulation_unit.get_populations())),
-      simulation_unit(simulation_unit) {}
+      profile(profile),
+      simulation_unit(simulation_unit),
+      tracer(tracer),
+      unit_index(unit_index) {}
 
 void SimulateDay::create_offspring() {
+  ScopedTimer timer(profile, ProfilePhase::CreateOffspring);
+  TraceScope trace(tracer, "create_offspring", unit_index);
   for (const auto& itr : total_offspring) {
     PopulationInterface* pop = itr.first;
     const double offspring = itr.second;
@@ -51,12 +60,13 @@ HabitatForage SimulateDay::get_corrected_forage(const Habitat& habitat) {
   return available_forage;
 }
 
-std::map<PopulationInterface*, HerbivoreVector> SimulateDay::get_herbivores(
+SimulateDay::HerbivoresByPopulation SimulateDay::get_herbivores(
     const PopulationList& pop_list) {
-  std::map<PopulationInterface*, HerbivoreVector> result;
+  HerbivoresByPopulation result;
+  result.reserve(pop_list.size());
   for (auto& pop : pop_list) {
     assert(pop);
-    result[pop.get()] = pop->get_list();
+    result.emplace_back(pop.get(), pop->get_list());
   }
   return result;
 }
@@ -69,18 +79,27 @@ void SimulateDay::operator()(const bool do_herbivores,
         "Argument 'day_of_year' out of range");
 
   // pass the current date into the herbivore module
-  simulation_unit.get_habitat().init_day(day_of_year);
+  {
+    TraceScope trace(tracer, "habitat_init_day", unit_index);
+    simulation_unit.get_habitat().init_day(day_of_year);
+  }
 
   if (do_herbivores) {
     // Kill herbivore populations below the minimum density threshold here
     // so that simulate_herbivores() can (potentially) return nutrients from
     // the dead bodies before the herbivore objects are removed from memory in
     // purge_of_dead() below.
-    for (auto& pop : simulation_unit.get_populations()) pop->kill_nonviable();
+    {
+      ScopedTimer timer(profile, ProfilePhase::KillNonviable);
+      TraceScope trace(tracer, "kill_nonviable", unit_index);
+      for (auto& pop : simulation_unit.get_populations()) pop->kill_nonviable();
+    }
 
     if (establish_as_needed) {
+      ScopedTimer timer(profile, ProfilePhase::Establishment);
+      TraceScope trace(tracer, "establishment", unit_index);
       for (auto& pop : simulation_unit.get_populations())
-        if (pop->get_list().empty()) pop->establish();
+        if (pop->empty()) pop->establish();
       simulation_unit.set_initial_establishment_done();
     }
 
@@ -91,19 +110,27 @@ void SimulateDay::operator()(const bool do_herbivores,
     // the population-separated lists here. This is an unelegant and wasteful
     // solution...
     int total_count = 0;
-    for (auto itr : herbivores) total_count += itr.second.size();
+    for (const auto& itr : herbivores) total_count += itr.second.size();
     HerbivoreVector all_herbivores;
     all_herbivores.reserve(total_count);
-    for (auto itr : herbivores)
+    for (const auto& itr : herbivores)
       all_herbivores.insert(all_herbivores.end(), itr.second.begin(),
                             itr.second.end());
 
     // FEEDING
-    const auto forage_before_feeding =
-        get_corrected_forage(simulation_unit.get_habitat());
+    HabitatForage forage_before_feeding;
+    {
+      TraceScope trace(tracer, "habitat_get_available_forage", unit_index);
+      forage_before_feeding =
+          get_corrected_forage(simulation_unit.get_habitat());
+    }
     auto available_forage = forage_before_feeding;
-    feed_herbivores(available_forage, all_herbivores);
+    {
+      TraceScope trace(tracer, "feeding", unit_index);
+      feed_herbivores(available_forage, all_herbivores);
+    }
     // remove the eaten forage
+    TraceScope trace(tracer, "habitat_remove_eaten_forage", unit_index);
     simulation_unit.get_habitat().remove_eaten_forage(
         forage_before_feeding.get_mass() - available_forage.get_mass());
   }
@@ -115,10 +142,14 @@ void SimulateDay::operator()(const bool do_herbivores,
 
   create_offspring();
 
+  ScopedTimer timer(profile, ProfilePhase::PurgeOfDead);
+  TraceScope trace(tracer, "purge_of_dead", unit_index);
   for (auto& pop : simulation_unit.get_populations()) pop->purge_of_dead();
 }
 
 void SimulateDay::simulate_herbivores() {
+  ScopedTimer timer(profile, ProfilePhase::SimulateHerbivores);
+  TraceScope trace(tracer, "simulate_herbivores", unit_index);
   // loop through all herbivores: simulate
   for (auto& itr : herbivores) {
     PopulationInterface* pop = itr.first;
@@ -138,6 +169,7 @@ void SimulateDay::simulate_herbivores() {
 
       // Let the herbivores do their simulation.
       herbivore->simulate_day(day_of_year, environment, offspring);
+      if (profile) profile->herbivore_days++;
 
       // Gather the offspring.
       total_offspring[pop] += offspring;
@@ -12,6 +12,8 @@
 #define FAUNA_SIMULATE_DAY_H
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "environment.h"
 #include "habitat_forage.h"
@@ -23,13 +25,21 @@ namespace Fauna {
 class FeedHerbivores;
 class Habitat;
 class PopulationInterface;
+struct Profile;
 class SimulationUnit;
+class Tracer;
 
 /// Function object to simulate one day in one habitat.
 /**
  * This class is very high in the framework hierarchy and should
  * therefore be kept as slim as possible. It should only call well
  * encapsulated other functions and classes.
+ *
+ * All calls to populations and herbivores go through
+ * \ref PopulationInterface and \ref HerbivoreInterface, so that it works
+ * with any herbivore class. \ref StaticSimulateDay does the same for one
+ * known population class without virtual calls.
+ * \see \ref sec_design_static_dispatch
  */
 class SimulateDay {
  public:
@@ -40,10 +50,17 @@ class SimulateDay {
    * simulate.
    * \param feed_herbivores Function object used to give forage to the
    * herbivores.
+   * \param profile Run-time measurements to add to. Can be NULL if profiling
+   * is disabled.
+   * \param tracer Timeline to record the phases in. Can be NULL if tracing
+   * is disabled.
+   * \param unit_index Number of the simulation unit to identify it in the
+   * trace.
    * \throw std::invalid_argument If day_of_year not in [0,364].
    */
   SimulateDay(const int day_of_year, SimulationUnit& simulation_unit,
-              const FeedHerbivores& feed_herbivores);
+              const FeedHerbivores& feed_herbivores, Profile* profile = NULL,
+              Tracer* tracer = NULL, const int unit_index = -1);
 
   /// Simulate one day.
   /**
@@ -61,15 +78,6 @@ class SimulateDay {
    */
   void operator()(const bool do_herbivores, const bool establish_as_needed);
 
- private:  // HELPER FUNCTIONS
-  /// Create the offspring counted in \ref total_offspring.
-  /**
-   * For each HFT, let the PopulationInterface object create herbivores.
-   * These new herbivores will be counted in the output next simulation
-   * cycle.
-   */
-  void create_offspring();
-
   /// Read available forage and set it to zero if it is very low.
   /**
    * Set any marginally small values to zero in order to avoid errors
@@ -80,9 +88,25 @@ class SimulateDay {
    */
   static HabitatForage get_corrected_forage(const Habitat&);
 
+ private:  // HELPER FUNCTIONS
+  /// Herbivores of each population in the order of the population list.
+  typedef std::vector<std::pair<PopulationInterface*, HerbivoreVector> >
+      HerbivoresByPopulation;
+
+  /// Create the offspring counted in \ref total_offspring.
+  /**
+   * For each HFT, let the PopulationInterface object create herbivores.
+   * These new herbivores will be counted in the output next simulation
+   * cycle.
+   */
+  void create_offspring();
+
   /// Get references to all herbivores in the list of populations.
-  static std::map<PopulationInterface*, HerbivoreVector> get_herbivores(
-      const PopulationList&);
+  /**
+   * The herbivores keep the order of the population list so that the order
+   * of feeding doesn’t depend on memory addresses.
+   */
+  static HerbivoresByPopulation get_herbivores(const PopulationList&);
 
   /// Iterate over all \ref herbivores and let them do their simulation.
   /**
@@ -102,14 +126,53 @@ class SimulateDay {
   const FeedHerbivores& feed_herbivores;
 
   /// Pointers to all herbivores in the habitat.
-  std::map<PopulationInterface*, HerbivoreVector> herbivores;
+  HerbivoresByPopulation herbivores;
 
   /// All offspring for each population today [ind/km²]
   std::map<PopulationInterface*, double> total_offspring;
 
+  /// Run-time measurements, or NULL if profiling is disabled.
+  Profile* const profile;
+
   /// Reference to the simulation unit.
   SimulationUnit& simulation_unit;
+
+  /// Timeline of the phases, or NULL if tracing is disabled.
+  Tracer* const tracer;
+
+  /// Number of the simulation unit in the trace.
+  const int unit_index;
 };
+
+/// Function to simulate one day in one simulation unit.
+/**
+ * The parameters are those of the constructor and of the call operator of
+ * \ref SimulateDay.
+ * \see \ref WorldConstructor::get_simulate_day()
+ */
+typedef void (*SimulateDayFunction)(const int day_of_year,
+                                    SimulationUnit& simulation_unit,
+                                    const FeedHerbivores& feed_herbivores,
+                                    Profile* profile, Tracer* tracer,
+                                    const int unit_index,
+                                    const bool do_herbivores,
+                                    const bool establish_as_needed);
+
+/// Simulate one day with a new function object of class `T`.
+/**
+ * \tparam T \ref SimulateDay or \ref StaticSimulateDay.
+ * \see \ref SimulateDayFunction
+ */
+template <class T>
+void simulate_day_with(const int day_of_year, SimulationUnit& simulation_unit,
+                       const FeedHerbivores& feed_herbivores, Profile* profile,
+                       Tracer* tracer, const int unit_index,
+                       const bool do_herbivores,
+                       const bool establish_as_needed) {
+  T simulate_day(day_of_year, simulation_unit, feed_herbivores, profile,
+                 tracer, unit_index);
+  simulate_day(do_herbivores, establish_as_needed);
+}
 }  // namespace Fauna
 
 #endif  // FAUNA_SIMULATE_DAY_H
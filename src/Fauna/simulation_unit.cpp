@@ -10,6 +10,9 @@
  */
 #include "simulation_unit.h"
 
+#include <cstdint>
+
+#include "checkpoint.h"
 #include "combined_data.h"
 #include "habitat.h"
 #include "herbivore_interface.h"
@@ -64,10 +67,11 @@ Output::CombinedData SimulationUnit::get_output() const {
   std::map<const std::string, std::vector<Output::HerbivoreData> > hft_output;
 
   for (auto& pop : get_populations())
-    for (auto& herbivore : pop->get_list()) {
-      hft_output[herbivore->get_output_group()].push_back(
-          herbivore->get_todays_output());
-    }
+    ((const PopulationInterface&)*pop)
+        .for_each([&hft_output](const HerbivoreInterface& herbivore) {
+          hft_output[herbivore.get_output_group()].push_back(
+              herbivore.get_todays_output());
+        });
 
   for (auto& itr : hft_output) {
     const std::vector<Output::HerbivoreData>& vector = itr.second;
@@ -85,6 +89,12 @@ Output::CombinedData SimulationUnit::get_output() const {
   return result;
 }
 
+bool SimulationUnit::has_herbivores() const {
+  for (const auto& pop : get_populations())
+    if (!pop->empty()) return true;
+  return false;
+}
+
 PopulationList& SimulationUnit::get_populations() {
   if (populations.get() == NULL)
     throw std::logic_error(
@@ -104,3 +114,22 @@ const PopulationList& SimulationUnit::get_populations() const {
         "of the PopulationList object.");
   return *populations;
 }
+
+void SimulationUnit::load_state(CheckpointReader& in) {
+  in.read(initial_establishment_done);
+  std::uint64_t size;
+  in.read(size);
+  if (size != get_populations().size())
+    throw std::runtime_error(
+        "Fauna::SimulationUnit::load_state() "
+        "The number of populations in the checkpoint doesn’t match.");
+  for (auto& population : get_populations()) population->load_state(in);
+  equilibrium_monitor.load_state(in);
+}
+
+void SimulationUnit::save_state(CheckpointWriter& out) const {
+  out.write(initial_establishment_done);
+  out.write((std::uint64_t)get_populations().size());
+  for (const auto& population : get_populations()) population->save_state(out);
+  equilibrium_monitor.save_state(out);
+}
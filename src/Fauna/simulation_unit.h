@@ -13,10 +13,13 @@
 
 #include <memory>
 
+#include "equilibrium_monitor.h"
 #include "population_list.h"
 
 namespace Fauna {
 // forward declaration
+class CheckpointReader;
+class CheckpointWriter;
 class Habitat;
 
 namespace Output {
@@ -42,6 +45,15 @@ class SimulationUnit {
   /// Default Destructor
   ~SimulationUnit();
 
+  /// Year-to-year changes of the herbivore populations.
+  /** \see \ref World::enable_equilibrium_monitor() */
+  EquilibriumMonitor& get_equilibrium_monitor() { return equilibrium_monitor; }
+
+  /** \copydoc get_equilibrium_monitor() */
+  const EquilibriumMonitor& get_equilibrium_monitor() const {
+    return equilibrium_monitor;
+  }
+
   /// The habitat where the populations live.
   /** \throw std::logic_error If the private pointer is NULL. */
   Habitat& get_habitat();
@@ -50,6 +62,11 @@ class SimulationUnit {
   /** \throw std::logic_error If the private pointer is NULL. */
   const Habitat& get_habitat() const;
 
+  /// Shared ownership of the habitat, e.g. for a new simulation unit.
+  const std::shared_ptr<Habitat>& get_habitat_pointer() const {
+    return habitat;
+  }
+
   /// Get combined output from habitat and herbivores together.
   /**
    * \see \ref HerbivoreInterface::get_todays_output()
@@ -65,11 +82,30 @@ class SimulationUnit {
   /** \throw std::logic_error If the private pointer is NULL. */
   const PopulationList& get_populations() const;
 
+  /// Whether any population has herbivores, dead or alive.
+  /**
+   * Without herbivores, no herbivores can appear until the next
+   * establishment. \see \ref sec_design_empty_units
+   */
+  bool has_herbivores() const;
+
   /// Whether the flag for initial establishment has been set.
   bool is_initial_establishment_done() const {
     return initial_establishment_done;
   }
 
+  /// Restore the herbivore populations and their monitor from a checkpoint.
+  /**
+   * The habitat is not part of the checkpoint.
+   * \throw std::runtime_error If the checkpoint data is corrupt or doesn’t
+   * match the number of populations in this simulation unit.
+   */
+  void load_state(CheckpointReader& in);
+
+  /// Append the herbivore populations and their monitor to a checkpoint.
+  /** \see \ref load_state() */
+  void save_state(CheckpointWriter& out) const;
+
   /// Set the flag that initial establishment has been performed.
   void set_initial_establishment_done() { initial_establishment_done = true; }
 
@@ -77,6 +113,7 @@ class SimulationUnit {
   std::shared_ptr<Habitat> habitat;
   bool initial_establishment_done;
   std::unique_ptr<PopulationList> populations;
+  EquilibriumMonitor equilibrium_monitor;
 };
 
 }  // namespace Fauna
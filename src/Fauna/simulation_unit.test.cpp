@@ -19,4 +19,8 @@ TEST_CASE("Fauna::SimulationUnit") {
   Hft HFT;
   CHECK_THROWS(SimulationUnit(NULL, new PopulationList()));
   CHECK_THROWS(SimulationUnit(new DummyHabitat(), NULL));
+
+  const SimulationUnit empty(std::shared_ptr<Habitat>(new DummyHabitat()),
+                             new PopulationList());
+  CHECK(!empty.has_herbivores());
 }
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Simulation of one day for one known population class.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "static_simulate_day.h"
+
+#include <stdexcept>
+
+#include "cohort_population.h"
+#include "feed_herbivores.h"
+#include "habitat.h"
+#include "scoped_timer.h"
+#include "simulate_day.h"
+#include "simulation_unit.h"
+#include "tracer.h"
+
+using namespace Fauna;
+
+template <class Population>
+StaticSimulateDay<Population>::StaticSimulateDay(
+    const int day_of_year, SimulationUnit& simulation_unit,
+    const FeedHerbivores& feed_herbivores, Profile* profile, Tracer* tracer,
+    const int unit_index)
+    : day_of_year(day_of_year),
+      environment(simulation_unit.get_habitat().get_environment()),
+      feed_herbivores(feed_herbivores),
+      profile(profile),
+      simulation_unit(simulation_unit),
+      tracer(tracer),
+      unit_index(unit_index) {
+  const PopulationList& pop_list = simulation_unit.get_populations();
+  populations.reserve(pop_list.size());
+  populated.reserve(pop_list.size());
+  for (auto& pop : pop_list) {
+    assert(pop);
+    Population* typed = dynamic_cast<Population*>(pop.get());
+    if (!typed)
+      throw std::logic_error(
+          "Fauna::StaticSimulateDay::StaticSimulateDay() "
+          "A population in the simulation unit is not of the expected "
+          "class.");
+    populations.push_back(typed);
+    populated.push_back(!typed->empty());
+  }
+  total_offspring.assign(populations.size(), 0.0);
+}
+
+template <class Population>
+void StaticSimulateDay<Population>::create_offspring() {
+  ScopedTimer timer(profile, ProfilePhase::CreateOffspring);
+  TraceScope trace(tracer, "create_offspring", unit_index);
+  for (std::size_t i = 0; i < populations.size(); i++)
+    if (total_offspring[i] > 0.0)
+      populations[i]->create_offspring(total_offspring[i]);
+}
+
+template <class Population>
+void StaticSimulateDay<Population>::operator()(
+    const bool do_herbivores, const bool establish_as_needed) {
+  if (day_of_year < 0 || day_of_year >= 365)
+    throw std::invalid_argument(
+        "Fauna::StaticSimulateDay::operator()() "
+        "Argument 'day_of_year' out of range");
+
+  {
+    TraceScope trace(tracer, "habitat_init_day", unit_index);
+    simulation_unit.get_habitat().init_day(day_of_year);
+  }
+
+  if (do_herbivores) {
+    // See SimulateDay::operator()() for the order of the phases.
+    {
+      ScopedTimer timer(profile, ProfilePhase::KillNonviable);
+      TraceScope trace(tracer, "kill_nonviable", unit_index);
+      for (auto pop : populations) pop->kill_nonviable();
+    }
+
+    if (establish_as_needed) {
+      ScopedTimer timer(profile, ProfilePhase::Establishment);
+      TraceScope trace(tracer, "establishment", unit_index);
+      for (auto pop : populations)
+        if (pop->empty()) pop->establish();
+      simulation_unit.set_initial_establishment_done();
+    }
+
+    simulate_herbivores();
+
+    // Collect the herbivores of all populations in list order.
+    std::size_t total_count = 0;
+    for (std::size_t i = 0; i < populations.size(); i++)
+      if (populated[i]) total_count += populations[i]->size();
+    std::vector<Herbivore*> all_herbivores;
+    all_herbivores.reserve(total_count);
+    for (std::size_t i = 0; i < populations.size(); i++)
+      if (populated[i])
+        populations[i]->for_each_herbivore([&](Herbivore& herbivore) {
+          all_herbivores.push_back(&herbivore);
+        });
+
+    // FEEDING
+    HabitatForage forage_before_feeding;
+    {
+      TraceScope trace(tracer, "habitat_get_available_forage", unit_index);
+      forage_before_feeding =
+          SimulateDay::get_corrected_forage(simulation_unit.get_habitat());
+    }
+    auto available_forage = forage_before_feeding;
+    {
+      TraceScope trace(tracer, "feeding", unit_index);
+      feed_herbivores.feed(available_forage, all_herbivores);
+    }
+    TraceScope trace(tracer, "habitat_remove_eaten_forage", unit_index);
+    simulation_unit.get_habitat().remove_eaten_forage(
+        forage_before_feeding.get_mass() - available_forage.get_mass());
+  }
+
+  create_offspring();
+
+  ScopedTimer timer(profile, ProfilePhase::PurgeOfDead);
+  TraceScope trace(tracer, "purge_of_dead", unit_index);
+  for (auto pop : populations) pop->purge_of_dead();
+}
+
+template <class Population>
+void StaticSimulateDay<Population>::simulate_herbivores() {
+  ScopedTimer timer(profile, ProfilePhase::SimulateHerbivores);
+  TraceScope trace(tracer, "simulate_herbivores", unit_index);
+  for (std::size_t i = 0; i < populations.size(); i++) {
+    if (!populated[i]) continue;
+    double& offspring_sum = total_offspring[i];
+    populations[i]->for_each_herbivore([&](Herbivore& herbivore) {
+      // The population will release dead herbivores.
+      if (herbivore.is_dead()) return;
+      double offspring = 0.0;  // [ind/km²]
+      herbivore.simulate_day(day_of_year, environment, offspring);
+      if (profile) profile->herbivore_days++;
+      offspring_sum += offspring;
+    });
+  }
+}
+
+template class Fauna::StaticSimulateDay<CohortPopulation>;
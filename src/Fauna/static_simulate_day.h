@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Simulation of one day for one known population class.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_STATIC_SIMULATE_DAY_H
+#define FAUNA_STATIC_SIMULATE_DAY_H
+
+#include <cstddef>
+#include <vector>
+
+#include "environment.h"
+
+namespace Fauna {
+// Forward declarations
+class FeedHerbivores;
+struct Profile;
+class SimulationUnit;
+class Tracer;
+
+/// Function object to simulate one day in one habitat without virtual calls.
+/**
+ * This does exactly the same as \ref SimulateDay, but all populations in the
+ * simulation unit must be of class `Population`. Populations and herbivores
+ * are called through their own classes, which are `final`, so that the
+ * compiler can resolve and inline the calls in the daily loop.
+ *
+ * The template is only instantiated in static_simulate_day.cpp, for
+ * \ref CohortPopulation. \ref WorldConstructor::get_simulate_day() selects it
+ * for \ref HerbivoreType::Cohort.
+ * \tparam Population A class derived from \ref PopulationInterface with a
+ * type `Herbivore` and a member function template `for_each_herbivore()`,
+ * like \ref CohortPopulation.
+ * \see \ref sec_design_static_dispatch
+ */
+template <class Population>
+class StaticSimulateDay {
+ public:
+  /// The class of the herbivores in each population.
+  typedef typename Population::Herbivore Herbivore;
+
+  /// Constructor
+  /**
+   * \copydetails SimulateDay::SimulateDay()
+   * \throw std::logic_error If a population in the simulation unit is not of
+   * class `Population`.
+   */
+  StaticSimulateDay(const int day_of_year, SimulationUnit& simulation_unit,
+                    const FeedHerbivores& feed_herbivores,
+                    Profile* profile = NULL, Tracer* tracer = NULL,
+                    const int unit_index = -1);
+
+  /** \copydoc SimulateDay::operator()() */
+  void operator()(const bool do_herbivores, const bool establish_as_needed);
+
+ private:
+  /// Let the populations create the offspring in \ref total_offspring.
+  void create_offspring();
+
+  /// Let all herbivores do their simulation and collect offspring.
+  void simulate_herbivores();
+
+  /// Julian day of year (0 = Jan 1st).
+  const int day_of_year;
+
+  /// The current abiotic conditions.
+  const HabitatEnvironment environment;
+
+  /// Function object doing the feeding.
+  const FeedHerbivores& feed_herbivores;
+
+  /// The populations in the order of the population list.
+  std::vector<Population*> populations;
+
+  /// Whether each population had herbivores at the beginning of the day.
+  /**
+   * Herbivores that are established today are not simulated until
+   * tomorrow, as in \ref SimulateDay.
+   */
+  std::vector<bool> populated;
+
+  /// All offspring for each population today [ind/km²]
+  std::vector<double> total_offspring;
+
+  /// Run-time measurements, or NULL if profiling is disabled.
+  Profile* const profile;
+
+  /// Reference to the simulation unit.
+  SimulationUnit& simulation_unit;
+
+  /// Timeline of the phases, or NULL if tracing is disabled.
+  Tracer* const tracer;
+
+  /// Number of the simulation unit in the trace.
+  const int unit_index;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_STATIC_SIMULATE_DAY_H
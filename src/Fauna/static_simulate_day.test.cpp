@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the statically dispatched simulation of one day.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "static_simulate_day.h"
+
+#include "batch_habitat.h"
+#include "catch.hpp"
+#include "checkpoint.h"
+#include "cohort_population.h"
+#include "dummy_habitat.h"
+#include "dummy_hft.h"
+#include "dummy_population.h"
+#include "feed_herbivores.h"
+#include "forage_distribution_algorithms.h"
+#include "parameters.h"
+#include "profile.h"
+#include "simulate_day.h"
+#include "simulation_unit.h"
+#include "world_constructor.h"
+
+using namespace Fauna;
+
+namespace {
+/// Serialize the herbivores of a simulation unit for comparison.
+std::vector<char> get_state(const SimulationUnit& sim_unit) {
+  CheckpointWriter out;
+  sim_unit.save_state(out);
+  return out.get_buffer();
+}
+}  // namespace
+
+TEST_CASE("Fauna::StaticSimulateDay", "") {
+  std::shared_ptr<Parameters> params(new Parameters);
+  REQUIRE(params->is_valid());
+  REQUIRE(params->herbivore_type == HerbivoreType::Cohort);
+  static const HftList HFTLIST = *create_hfts(2, *params);
+  const WorldConstructor world_cons(params, HFTLIST);
+  const FeedHerbivores feed_herbivores(new DistributeForageEqually);
+
+  SECTION("Selected for herbivore cohorts") {
+    CHECK(world_cons.get_simulate_day() ==
+          &simulate_day_with<StaticSimulateDay<CohortPopulation> >);
+  }
+
+  SECTION("Wrong population class") {
+    PopulationList* populations = new PopulationList();
+    populations->emplace_back(new DummyPopulation(HFTLIST[0].get()));
+    SimulationUnit sim_unit(std::make_shared<DummyHabitat>(), populations);
+    CHECK_THROWS_AS(StaticSimulateDay<CohortPopulation>(0, sim_unit,
+                                                        feed_herbivores),
+                    std::logic_error);
+  }
+
+  SECTION("Same results as the virtual path") {
+    // Two simulation units with the same forcing: the first one is
+    // simulated with SimulateDay and the second one with StaticSimulateDay.
+    const int COUNT = 2;
+    const double grass_mass[COUNT] = {2e5, 2e5};  // [kgDM/km²]
+    const double digestibility[COUNT] = {0.5, 0.5};
+    const double nitrogen_mass[COUNT] = {2e3, 2e3};  // [kgN/km²]
+    const double fpc[COUNT] = {0.5, 0.5};
+    const double temperature[COUNT] = {10.0, 10.0};  // [°C]
+    double eaten_grass[COUNT];
+    BatchForcing forcing;
+    forcing.grass_mass = grass_mass;
+    forcing.grass_digestibility = digestibility;
+    forcing.grass_nitrogen_mass = nitrogen_mass;
+    forcing.grass_fpc = fpc;
+    forcing.air_temperature = temperature;
+    forcing.eaten_grass = eaten_grass;
+
+    std::vector<std::shared_ptr<BatchHabitat> > habitats;
+    std::vector<std::unique_ptr<SimulationUnit> > sim_units;
+    for (int i = 0; i < COUNT; i++) {
+      habitats.emplace_back(new BatchHabitat("global", i));
+      habitats.back()->set_forcing(&forcing);
+      sim_units.emplace_back(new SimulationUnit(
+          habitats.back(), world_cons.create_populations(0)));
+      REQUIRE(sim_units.back()->get_populations().size() == HFTLIST.size());
+    }
+
+    Profile profile[COUNT];
+    bool eaten_anything = false;
+    for (int year = 0; year < 3; year++)
+      for (int day = 0; day < 365; day++) {
+        eaten_grass[0] = eaten_grass[1] = 0.0;
+        // Establish only at the very beginning.
+        const bool establish = (year == 0 && day == 0);
+        SimulateDay(day, *sim_units[0], feed_herbivores, &profile[0])(
+            true, establish);
+        StaticSimulateDay<CohortPopulation>(day, *sim_units[1], feed_herbivores,
+                                            &profile[1])(true, establish);
+        REQUIRE(eaten_grass[0] == eaten_grass[1]);
+        if (eaten_grass[0] > 0.0) eaten_anything = true;
+      }
+    CHECK(eaten_anything);
+    CHECK(profile[0].herbivore_days > 0);
+    CHECK(profile[0].herbivore_days == profile[1].herbivore_days);
+    CHECK(profile[0].feeding_iterations == profile[1].feeding_iterations);
+    CHECK(get_state(*sim_units[0]) == get_state(*sim_units[1]));
+  }
+}
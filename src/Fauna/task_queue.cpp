@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Runs tasks one after the other in a background thread.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "task_queue.h"
+
+using namespace Fauna;
+
+TaskQueue::TaskQueue() : thread(&TaskQueue::run, this) {}
+
+TaskQueue::~TaskQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  queue_filled.notify_one();
+  if (thread.joinable()) thread.join();
+}
+
+void TaskQueue::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    queue_filled.wait(lock, [this] { return stop || !queue.empty(); });
+    // When asked to stop, finish the queue first.
+    if (queue.empty()) return;
+
+    std::packaged_task<void()> task = std::move(queue.front());
+    queue.pop_front();
+
+    lock.unlock();
+    // The packaged task stores any exception in its future.
+    task();
+    lock.lock();
+  }
+}
+
+std::shared_future<void> TaskQueue::submit(const Task& task) {
+  std::packaged_task<void()> packaged(task);
+  std::shared_future<void> future = packaged.get_future().share();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(packaged));
+  }
+  queue_filled.notify_one();
+  return future;
+}
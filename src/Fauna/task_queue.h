@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Runs tasks one after the other in a background thread.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_TASK_QUEUE_H
+#define FAUNA_TASK_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace Fauna {
+
+/// Runs tasks one after the other in one long-lived background thread.
+/**
+ * The thread is started once in the constructor and waits without using
+ * the CPU while the queue is empty. So submitting a task doesn’t create a
+ * new thread, and the tasks never run at the same time.
+ *
+ * If a task throws an exception, it is stored in the task’s future, and the
+ * next task runs as usual.
+ * \see \ref sec_design_submit_day
+ */
+class TaskQueue {
+ public:
+  /// Function to execute in the background thread.
+  typedef std::function<void()> Task;
+
+  /// Constructor: Start the background thread.
+  TaskQueue();
+
+  /// Destructor: Run all queued tasks and stop the background thread.
+  ~TaskQueue();
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  /// Append a task to the queue.
+  /**
+   * \param task The function to call in the background thread.
+   * \return Handle that becomes ready when the task has finished. It
+   * rethrows an exception from the task.
+   */
+  std::shared_future<void> submit(const Task& task);
+
+ private:
+  /// Main function of the background thread.
+  void run();
+
+  /// Tasks waiting to be run.
+  std::deque<std::packaged_task<void()> > queue;
+
+  /// Guards \ref queue and \ref stop.
+  std::mutex mutex;
+
+  /// Wakes up the background thread for a new task or to stop.
+  std::condition_variable queue_filled;
+
+  /// Signal for the background thread to finish.
+  bool stop = false;
+
+  /// The background thread.
+  /** Declared last so that all other members exist when it starts. */
+  std::thread thread;
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_TASK_QUEUE_H
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::TaskQueue.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "task_queue.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::TaskQueue", "") {
+  SECTION("Tasks run in order in one background thread") {
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+    std::vector<std::shared_future<void> > futures;
+    {
+      TaskQueue queue;
+      for (int i = 0; i < 100; i++)
+        futures.push_back(queue.submit([&, i]() {
+          order.push_back(i);
+          threads.push_back(std::this_thread::get_id());
+        }));
+      futures.back().wait();
+      REQUIRE(order.size() == 100);
+      for (int i = 0; i < 100; i++) CHECK(order[i] == i);
+      for (const auto& id : threads) {
+        CHECK(id == threads.front());
+        CHECK(id != std::this_thread::get_id());
+      }
+    }
+    for (auto& future : futures) CHECK_NOTHROW(future.get());
+  }
+
+  SECTION("Exceptions") {
+    TaskQueue queue;
+    auto failed = queue.submit([]() { throw std::runtime_error("task"); });
+    bool called = false;
+    auto next = queue.submit([&]() { called = true; });
+    CHECK_THROWS_AS(failed.get(), std::runtime_error);
+    CHECK_NOTHROW(next.get());
+    CHECK(called);
+  }
+
+  SECTION("Destructor runs the remaining tasks") {
+    int count = 0;
+    {
+      TaskQueue queue;
+      for (int i = 0; i < 10; i++) queue.submit([&]() { count++; });
+    }
+    CHECK(count == 10);
+  }
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Record a timeline of simulation phases in Chrome trace format.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "tracer.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace Fauna;
+
+namespace {
+/// Source for unique tracer IDs. Zero is never used.
+std::atomic<std::uint64_t> next_tracer_id(1);
+
+/// The buffer last used by this thread, to avoid looking it up again.
+/**
+ * The tracer ID tells whether the cached buffer belongs to the tracer
+ * asking for it. Tracer IDs are never reused, so a buffer of a destroyed
+ * tracer is never returned.
+ */
+struct ThreadCache {
+  std::uint64_t tracer_id = 0;
+  void* buffer = NULL;
+};
+thread_local ThreadCache thread_cache;
+}  // namespace
+
+Tracer::Tracer(const std::string& filename)
+    : id(next_tracer_id++),
+      filename(filename),
+      start(std::chrono::steady_clock::now()) {}
+
+void Tracer::add_event(const char* name, const int unit, const double begin,
+                       const double end) {
+  get_buffer().events.push_back({name, unit, begin, end - begin});
+}
+
+Tracer::Buffer& Tracer::get_buffer() {
+  if (thread_cache.tracer_id == id)
+    return *static_cast<Buffer*>(thread_cache.buffer);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<Buffer>& buffer = buffers[std::this_thread::get_id()];
+  if (!buffer) {
+    buffer.reset(new Buffer());
+    buffer->tid = buffers.size();
+  }
+  thread_cache.tracer_id = id;
+  thread_cache.buffer = buffer.get();
+  return *buffer;
+}
+
+std::size_t Tracer::get_event_count() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::size_t count = 0;
+  for (const auto& itr : buffers) count += itr.second->events.size();
+  return count;
+}
+
+void Tracer::print(std::ostream& stream) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::ios::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+  stream << std::fixed << std::setprecision(3);
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto& itr : buffers) {
+    const Buffer& buffer = *itr.second;
+    // Metadata event to give the thread a readable name.
+    if (!first) stream << ",";
+    first = false;
+    stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << buffer.tid << ",\"args\":{\"name\":\"thread " << buffer.tid
+           << "\"}}";
+    for (const auto& event : buffer.events) {
+      stream << ",\n{\"name\":\"" << event.name
+             << "\",\"cat\":\"megafauna\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+             << buffer.tid << ",\"ts\":" << event.begin
+             << ",\"dur\":" << event.duration;
+      if (event.unit >= 0)
+        stream << ",\"args\":{\"unit\":" << event.unit << "}";
+      stream << "}";
+    }
+  }
+  stream << "\n]}\n";
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+void Tracer::write() const {
+  std::ofstream file(filename, std::ios::trunc);
+  print(file);
+  if (!file.good())
+    throw std::runtime_error(
+        "Fauna::Tracer::write() "
+        "Could not write trace file \"" +
+        filename + "\".");
+}
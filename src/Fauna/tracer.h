@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Record a timeline of simulation phases in Chrome trace format.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_TRACER_H
+#define FAUNA_TRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Fauna {
+
+/// Records when each simulation phase begins and ends, in each thread.
+/**
+ * The events are written as JSON in the Chrome trace event format, which
+ * can be opened in `chrome://tracing` or <https://ui.perfetto.dev>.
+ * Each event is a “complete event” with begin time and duration, the thread
+ * ID, and the index of the simulation unit.
+ *
+ * **Threads:** Each thread records into its own buffer. Only the first event
+ * of a thread locks a mutex to create the buffer; all further events are
+ * appended without any synchronization. \ref write() must not be called
+ * while other threads are still recording.
+ *
+ * **Memory:** All events are kept in memory until \ref write() is called.
+ * Each event takes a few dozen bytes. So tracing is meant for diagnostic
+ * runs over a limited time span.
+ *
+ * Use \ref TraceScope to record an event.
+ * \see \ref World::enable_tracing()
+ */
+class Tracer {
+ public:
+  /// Constructor: Start the clock.
+  /**
+   * \param filename Path of the JSON file that \ref write() creates.
+   */
+  Tracer(const std::string& filename);
+
+  /// Add an event to the buffer of the calling thread.
+  /**
+   * \param name Name of the phase. This must be a string literal or
+   * otherwise stay valid as long as this object lives.
+   * \param unit Index of the simulation unit, or a negative number if the
+   * event doesn’t belong to a simulation unit.
+   * \param begin Start time as returned by \ref now().
+   * \param end End time as returned by \ref now().
+   */
+  void add_event(const char* name, const int unit, const double begin,
+                 const double end);
+
+  /// The path of the output file.
+  const std::string& get_filename() const { return filename; }
+
+  /// Total number of recorded events in all threads.
+  std::size_t get_event_count() const;
+
+  /// Microseconds since this object was created.
+  double now() const {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  /// Write all events as Chrome trace JSON to a stream.
+  void print(std::ostream& stream) const;
+
+  /// Write all events as Chrome trace JSON to \ref get_filename().
+  /**
+   * \throw std::runtime_error If the file cannot be written.
+   */
+  void write() const;
+
+ private:
+  /// One timed phase.
+  struct Event {
+    /// Name of the phase (not owned).
+    const char* name;
+    /// Index of the simulation unit, or negative.
+    int unit;
+    /// Start time [µs].
+    double begin;
+    /// Duration [µs].
+    double duration;
+  };
+
+  /// The events of one thread.
+  struct Buffer {
+    /// Small sequential ID of the thread for the trace file.
+    int tid;
+    /// Events in the order they ended.
+    std::vector<Event> events;
+  };
+
+  /// Get the buffer of the calling thread, creating it if necessary.
+  Buffer& get_buffer();
+
+  /// Unique identifier to tell tracer objects apart in the thread cache.
+  const std::uint64_t id;
+
+  /// Path of the output file.
+  const std::string filename;
+
+  /// Reference point for all time stamps.
+  const std::chrono::steady_clock::time_point start;
+
+  /// One buffer for each thread that has recorded events.
+  std::map<std::thread::id, std::unique_ptr<Buffer>> buffers;
+
+  /// Guards \ref buffers when a new thread registers.
+  mutable std::mutex mutex;
+};
+
+/// Records one event from construction to destruction.
+/**
+ * If the tracer pointer is NULL, nothing is done.
+ *
+ * \code
+ * {
+ *   TraceScope trace(tracer, "feeding", unit_index);
+ *   // ... code to trace ...
+ * }  // The event is recorded here.
+ * \endcode
+ */
+class TraceScope {
+ public:
+  /// Constructor: Note the begin of the event.
+  /**
+   * \param tracer The tracer to record the event. Can be NULL.
+   * \param name Name of the phase. This must be a string literal.
+   * \param unit Index of the simulation unit, or a negative number if the
+   * event doesn’t belong to a simulation unit.
+   */
+  TraceScope(Tracer* tracer, const char* name, const int unit = -1)
+      : tracer(tracer), name(name), unit(unit) {
+    if (tracer) begin = tracer->now();
+  }
+
+  /// Delete copy constructor because the event must only be recorded once.
+  TraceScope(TraceScope const&) = delete;
+
+  /// Delete copy assignment because the event must only be recorded once.
+  void operator=(TraceScope const&) = delete;
+
+  /// Destructor: Record the event.
+  ~TraceScope() {
+    if (tracer) tracer->add_event(name, unit, begin, tracer->now());
+  }
+
+ private:
+  Tracer* const tracer;
+  const char* const name;
+  const int unit;
+  double begin = 0.0;
+};
+}  // namespace Fauna
+
+#endif  // FAUNA_TRACER_H
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::Tracer.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "tracer.h"
+
+#include <sstream>
+#include <thread>
+#include "catch.hpp"
+
+using namespace Fauna;
+
+TEST_CASE("Fauna::Tracer", "") {
+  Tracer tracer("trace.json");
+  CHECK(tracer.get_filename() == "trace.json");
+  CHECK(tracer.get_event_count() == 0);
+
+  SECTION("NULL tracer") {
+    // Nothing should happen.
+    TraceScope trace(NULL, "nothing");
+  }
+
+  SECTION("Events in two threads") {
+    { TraceScope trace(&tracer, "main_phase", 3); }
+    std::thread thread([&tracer]() {
+      TraceScope trace(&tracer, "thread_phase");
+    });
+    thread.join();
+    { TraceScope trace(&tracer, "main_phase", 4); }
+    CHECK(tracer.get_event_count() == 3);
+
+    std::ostringstream stream;
+    tracer.print(stream);
+    const std::string json = stream.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"main_phase\"") != std::string::npos);
+    CHECK(json.find("\"thread_phase\"") != std::string::npos);
+    CHECK(json.find("\"unit\":3") != std::string::npos);
+    CHECK(json.find("\"unit\":4") != std::string::npos);
+    CHECK(json.find("\"tid\":1") != std::string::npos);
+    CHECK(json.find("\"tid\":2") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+  }
+
+  SECTION("Two tracers in one thread") {
+    // The thread cache must not mix up the buffers.
+    Tracer other("other.json");
+    { TraceScope trace(&tracer, "a"); }
+    { TraceScope trace(&other, "b"); }
+    { TraceScope trace(&tracer, "c"); }
+    CHECK(tracer.get_event_count() == 2);
+    CHECK(other.get_event_count() == 1);
+  }
+}
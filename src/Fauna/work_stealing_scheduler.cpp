@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Runs independent tasks of different cost in a pool of threads.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "work_stealing_scheduler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Fauna;
+
+namespace {
+/// Seconds between two time points.
+double seconds(const std::chrono::steady_clock::time_point& begin,
+               const std::chrono::steady_clock::time_point& end) {
+  return std::chrono::duration<double>(end - begin).count();
+}
+}  // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(const int threads,
+                                             const int chunks_per_thread)
+    : chunks_per_thread(chunks_per_thread), failed(false) {
+  if (threads < 1)
+    throw std::invalid_argument(
+        "Fauna::WorkStealingScheduler::WorkStealingScheduler() "
+        "Parameter `threads` is smaller than 1.");
+  if (chunks_per_thread < 1)
+    throw std::invalid_argument(
+        "Fauna::WorkStealingScheduler::WorkStealingScheduler() "
+        "Parameter `chunks_per_thread` is smaller than 1.");
+  statistics.resize(threads);
+  finish_times.resize(threads);
+  for (int t = 0; t < threads; t++) queues.emplace_back(new Queue);
+  this->threads.reserve(threads - 1);
+  for (int t = 1; t < threads; t++)
+    this->threads.emplace_back(&WorkStealingScheduler::serve, this, t);
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  start_signal.notify_all();
+  for (auto& thread : threads) thread.join();
+}
+
+void WorkStealingScheduler::deal_chunks(const std::vector<double>& costs) {
+  const int task_count = costs.size();
+  std::vector<double> clamped(task_count);
+  double total = 0.0;
+  for (int i = 0; i < task_count; i++) {
+    clamped[i] = std::max(0.0, costs[i]);
+    total += clamped[i];
+  }
+  // Without any estimate, all tasks count the same.
+  if (total <= 0.0) {
+    std::fill(clamped.begin(), clamped.end(), 1.0);
+    total = task_count;
+  }
+
+  // Most expensive tasks first. The stable sort keeps tasks of equal cost
+  // in their original order.
+  order.resize(task_count);
+  for (int i = 0; i < task_count; i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return clamped[a] > clamped[b];
+  });
+
+  const double target_cost =
+      total / (get_thread_count() * get_chunks_per_thread());
+  for (auto& queue : queues) queue->chunks.clear();
+  int chunk_count = 0;
+  Chunk chunk = {0, 0};
+  double chunk_cost = 0.0;
+  for (int i = 0; i < task_count; i++) {
+    chunk_cost += clamped[order[i]];
+    chunk.end = i + 1;
+    if (chunk_cost >= target_cost || chunk.end == task_count) {
+      queues[chunk_count % get_thread_count()]->chunks.push_back(chunk);
+      chunk_count++;
+      chunk.begin = chunk.end;
+      chunk_cost = 0.0;
+    }
+  }
+}
+
+void WorkStealingScheduler::execute(const Chunk& chunk, const int thread) {
+  if (failed) return;  // Skip the remaining chunks.
+  ThreadStatistics& stats = statistics[thread];
+  const Clock::time_point begin = Clock::now();
+  for (int i = chunk.begin; i < chunk.end; i++) {
+    const int task = order[i];
+    try {
+      (*function)(task, thread);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error_task < 0 || task < error_task) {
+        error = std::current_exception();
+        error_task = task;
+      }
+      failed = true;
+      break;
+    }
+    stats.tasks++;
+  }
+  stats.chunks++;
+  stats.busy_seconds += seconds(begin, Clock::now());
+}
+
+void WorkStealingScheduler::run(const std::vector<double>& costs,
+                                const TaskFunction& function) {
+  if (costs.empty()) return;
+
+  // The other threads are waiting, so the queues can be filled without
+  // locking them.
+  deal_chunks(costs);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->function = &function;
+    failed = false;
+    error = std::exception_ptr();
+    error_task = -1;
+    active = get_thread_count() - 1;
+    generation++;
+  }
+  start_signal.notify_all();
+
+  work(0);
+
+  std::exception_ptr run_error;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done_signal.wait(lock, [this] { return active == 0; });
+    this->function = NULL;
+    run_error = error;
+    error = std::exception_ptr();
+  }
+
+  const Clock::time_point end = Clock::now();
+  for (int t = 0; t < get_thread_count(); t++) {
+    statistics[t].runs++;
+    statistics[t].idle_seconds += seconds(finish_times[t], end);
+  }
+
+  if (run_error) std::rethrow_exception(run_error);
+}
+
+void WorkStealingScheduler::serve(const int thread) {
+  unsigned long seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      start_signal.wait(lock, [&] {
+        return stop || generation != seen_generation;
+      });
+      if (stop) return;
+      seen_generation = generation;
+    }
+    work(thread);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      active--;
+      if (active == 0) done_signal.notify_one();
+    }
+  }
+}
+
+bool WorkStealingScheduler::take_chunk(const int thread, Chunk& chunk) {
+  {
+    Queue& own = *queues[thread];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.chunks.empty()) {
+      chunk = own.chunks.front();
+      own.chunks.pop_front();
+      return true;
+    }
+  }
+  // Steal the cheapest chunk of the next thread that has any work left.
+  for (int i = 1; i < get_thread_count(); i++) {
+    Queue& victim = *queues[(thread + i) % get_thread_count()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.chunks.empty()) {
+      chunk = victim.chunks.back();
+      victim.chunks.pop_back();
+      statistics[thread].stolen_chunks++;
+      statistics[thread].stolen_tasks += chunk.end - chunk.begin;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingScheduler::work(const int thread) {
+  Chunk chunk;
+  while (take_chunk(thread, chunk)) execute(chunk, thread);
+  finish_times[thread] = Clock::now();
+}
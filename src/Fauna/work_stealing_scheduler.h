@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Runs independent tasks of different cost in a pool of threads.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_WORK_STEALING_SCHEDULER_H
+#define FAUNA_WORK_STEALING_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Fauna/thread_statistics.h"
+
+namespace Fauna {
+
+/// Distributes independent tasks over threads that steal from each other.
+/**
+ * Each call of \ref run() orders the tasks by their estimated cost, most
+ * expensive first. Consecutive tasks are grouped into chunks of about equal
+ * cost, so that an expensive task forms a chunk on its own and many cheap
+ * tasks share one. The chunks are dealt to the threads in turn. Each thread
+ * works through its own queue from the front, i.e. from the expensive end.
+ * A thread without work steals a chunk from the back of another queue,
+ * where the cheap chunks are.
+ *
+ * The calling thread takes part as thread 0, and the other threads are
+ * started once in the constructor. Between runs they wait without using
+ * the CPU.
+ *
+ * The tasks must be independent of each other. The scheduler doesn’t
+ * influence the results, only which thread executes which task.
+ * \see \ref sec_design_work_stealing
+ */
+class WorkStealingScheduler {
+ public:
+  /// Function to execute one task.
+  /**
+   * The first parameter is the index of the task in the `costs` of
+   * \ref run(), the second one the index of the executing thread in
+   * [0, \ref get_thread_count()).
+   */
+  typedef std::function<void(const int task, const int thread)> TaskFunction;
+
+  /// Constructor: Start the threads.
+  /**
+   * \param threads Number of threads including the calling thread.
+   * \param chunks_per_thread Number of chunks per thread that the tasks are
+   * grouped into in each run.
+   * \throw std::invalid_argument If a parameter is smaller than 1.
+   */
+  WorkStealingScheduler(const int threads, const int chunks_per_thread = 4);
+
+  /// Destructor: Stop the threads.
+  ~WorkStealingScheduler();
+
+  WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+  WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+  /// Number of chunks per thread in each run.
+  int get_chunks_per_thread() const { return chunks_per_thread; }
+
+  /// Counters of each thread since construction.
+  const std::vector<ThreadStatistics>& get_statistics() const {
+    return statistics;
+  }
+
+  /// Number of threads including the calling thread.
+  int get_thread_count() const { return statistics.size(); }
+
+  /// Execute all tasks and return when they are finished.
+  /**
+   * \param costs Estimated cost of each task in arbitrary units. Negative
+   * values count as zero.
+   * \param function Called once for each task, possibly from different
+   * threads at the same time.
+   * \throw std::exception If a task has thrown an exception, it is
+   * rethrown here. If several tasks have failed, it is the one with the
+   * lowest index. The remaining chunks are then skipped.
+   */
+  void run(const std::vector<double>& costs, const TaskFunction& function);
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  /// Consecutive tasks in \ref order: [begin, end)
+  struct Chunk {
+    int begin;
+    int end;
+  };
+
+  /// The chunks dealt to one thread.
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Chunk> chunks;
+  };
+
+  /// Group the tasks into chunks and deal them to the queues.
+  void deal_chunks(const std::vector<double>& costs);
+
+  /// Execute one chunk and record errors.
+  void execute(const Chunk& chunk, const int thread);
+
+  /// Main function of the threads other than the calling thread.
+  void serve(const int thread);
+
+  /// Take a chunk from the thread’s own queue or steal one.
+  /** \return False if there is no chunk left in any queue. */
+  bool take_chunk(const int thread, Chunk& chunk);
+
+  /// Execute chunks until all queues are empty.
+  void work(const int thread);
+
+  const int chunks_per_thread;
+
+  /// Task indices, ordered by decreasing cost.
+  std::vector<int> order;
+
+  /// One queue for each thread.
+  std::vector<std::unique_ptr<Queue> > queues;
+
+  /// Counters for each thread; each thread only changes its own.
+  std::vector<ThreadStatistics> statistics;
+
+  /// When each thread ran out of work in the current run.
+  std::vector<Clock::time_point> finish_times;
+
+  /// The function of the current run, or NULL between runs.
+  const TaskFunction* function = NULL;
+
+  /// Whether a task of the current run has thrown an exception.
+  std::atomic<bool> failed;
+
+  /// Guards the members below.
+  std::mutex mutex;
+
+  /// Wakes up the threads for a new run or to stop.
+  std::condition_variable start_signal;
+
+  /// Tells the calling thread that all other threads are done.
+  std::condition_variable done_signal;
+
+  /// Number of the current run, so that threads notice a new one.
+  unsigned long generation = 0;
+
+  /// Number of threads other than the calling thread still working.
+  int active = 0;
+
+  /// Signal for the threads to finish.
+  bool stop = false;
+
+  /// The first error of the current run, by task index.
+  std::exception_ptr error;
+
+  /// Index of the task that threw \ref error.
+  int error_task = -1;
+
+  /// Threads 1 to n-1; thread 0 is the calling thread.
+  /** Declared last so that all other members exist when they start. */
+  std::vector<std::thread> threads;
+};
+
+}  // namespace Fauna
+
+#endif  // FAUNA_WORK_STEALING_SCHEDULER_H
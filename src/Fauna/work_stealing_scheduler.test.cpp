@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for Fauna::WorkStealingScheduler.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "work_stealing_scheduler.h"
+
+#include <atomic>
+#include <stdexcept>
+#include "catch.hpp"
+
+using namespace Fauna;
+
+namespace {
+/// Sum up the statistics of all threads.
+ThreadStatistics get_sum(const WorkStealingScheduler& scheduler) {
+  ThreadStatistics sum;
+  for (const auto& stats : scheduler.get_statistics()) sum += stats;
+  return sum;
+}
+}  // namespace
+
+TEST_CASE("Fauna::WorkStealingScheduler", "") {
+  CHECK_THROWS_AS(WorkStealingScheduler(0), std::invalid_argument);
+  CHECK_THROWS_AS(WorkStealingScheduler(2, 0), std::invalid_argument);
+
+  const int THREADS = 4;
+  WorkStealingScheduler scheduler(THREADS, 2);
+  REQUIRE(scheduler.get_thread_count() == THREADS);
+  CHECK(scheduler.get_chunks_per_thread() == 2);
+  CHECK(scheduler.get_statistics().size() == THREADS);
+
+  SECTION("Each task runs exactly once") {
+    // Very different costs, like simulation units with and without
+    // herbivores.
+    const int TASKS = 100;
+    std::vector<double> costs(TASKS);
+    for (int i = 0; i < TASKS; i++) costs[i] = (i % 25 == 0) ? 1000.0 : 1.0;
+    std::vector<std::atomic<int> > calls(TASKS);
+    for (auto& c : calls) c = 0;
+    std::atomic<bool> valid_thread(true);
+
+    const int RUNS = 3;
+    for (int run = 0; run < RUNS; run++)
+      scheduler.run(costs, [&](const int task, const int thread) {
+        calls[task]++;
+        if (thread < 0 || thread >= THREADS) valid_thread = false;
+      });
+    for (const auto& c : calls) CHECK(c == RUNS);
+    CHECK(valid_thread);
+
+    const ThreadStatistics sum = get_sum(scheduler);
+    CHECK(sum.runs == RUNS * THREADS);
+    CHECK(sum.tasks == RUNS * TASKS);
+    // Each expensive task is a chunk on its own, and all cheap tasks share
+    // one because their cost is below the target of 4096/8 per chunk.
+    CHECK(sum.chunks == RUNS * 5);
+    CHECK(sum.stolen_chunks <= sum.chunks);
+    CHECK(sum.stolen_tasks <= sum.tasks);
+    CHECK(sum.stolen_tasks >= sum.stolen_chunks);
+    CHECK(sum.busy_seconds >= 0.0);
+    CHECK(sum.idle_seconds >= 0.0);
+  }
+
+  SECTION("No tasks") {
+    scheduler.run(std::vector<double>(), [](const int, const int) {
+      FAIL("No task should be called.");
+    });
+    CHECK(get_sum(scheduler).runs == 0);
+  }
+
+  SECTION("Zero and negative costs") {
+    std::atomic<int> count(0);
+    scheduler.run(std::vector<double>(10, 0.0),
+                  [&](const int, const int) { count++; });
+    scheduler.run(std::vector<double>(10, -1.0),
+                  [&](const int, const int) { count++; });
+    CHECK(count == 20);
+  }
+
+  SECTION("Exceptions") {
+    std::atomic<int> count(0);
+    const std::vector<double> costs(20, 1.0);
+    CHECK_THROWS_AS(scheduler.run(costs,
+                                  [&](const int task, const int) {
+                                    count++;
+                                    if (task == 7)
+                                      throw std::runtime_error("task 7");
+                                  }),
+                    std::runtime_error);
+    CHECK(count <= 20);
+
+    // The scheduler can be used again.
+    count = 0;
+    scheduler.run(costs, [&](const int, const int) { count++; });
+    CHECK(count == 20);
+  }
+}
+
+TEST_CASE("Fauna::WorkStealingScheduler with one thread", "") {
+  WorkStealingScheduler scheduler(1);
+  std::vector<int> order;
+  // The tasks run in the calling thread, most expensive first.
+  scheduler.run({1.0, 3.0, 2.0, 3.0}, [&](const int task, const int thread) {
+    CHECK(thread == 0);
+    order.push_back(task);
+  });
+  CHECK(order == std::vector<int>({1, 3, 2, 0}));
+
+  const ThreadStatistics& stats = scheduler.get_statistics().front();
+  CHECK(stats.runs == 1);
+  CHECK(stats.tasks == 4);
+  // Chunks of at least 9/4: {3}, {3}, {2, 1}
+  CHECK(stats.chunks == 3);
+  CHECK(stats.stolen_chunks == 0);
+  CHECK(stats.stolen_tasks == 0);
+}
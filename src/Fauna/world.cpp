@@ -11,44 +11,163 @@
 #include "world.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <sstream>
 #include <stdexcept>
 
 #include "aggregator.h"
+#include "async_writer.h"
+#include "batch_habitat.h"
+#include "checkpoint.h"
 #include "date.h"
 #include "feed_herbivores.h"
 #include "habitat.h"
+#include "heap_bytes.h"
 #include "hft.h"
+#include "insfile_cache.h"
 #include "insfile_reader.h"
+#include "memory_usage.h"
+#include "memory_writer.h"
 #include "parameters.h"
 #include "population_interface.h"
 #include "population_list.h"
+#include "profile.h"
+#include "scoped_timer.h"
 #include "simulate_day.h"
 #include "simulation_unit.h"
+#include "storage_real.h"
+#include "task_queue.h"
 #include "text_table_writer.h"
+#include "tracer.h"
+#include "work_stealing_scheduler.h"
 #include "world_constructor.h"
 
 using namespace Fauna;
 
-Output::WriterInterface* World::construct_output_writer() const {
+namespace {
+/// Identifies a file as megafauna checkpoint.
+const char CHECKPOINT_MAGIC[] = "MMMCHKPT";
+
+/// Version of the binary checkpoint format.
+/** Increment this whenever the checkpoint content changes. */
+const std::uint32_t CHECKPOINT_VERSION = 5;
+
+/// Marker to detect checkpoints written with a different byte order.
+const std::uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+/// Maximum number of daily outputs of simulation units to keep in memory.
+/** \see World::simulate_days() */
+const std::size_t MAX_BUFFERED_OUTPUTS = 1 << 16;
+}  // namespace
+
+/// The simulation units and what to do with them on one day.
+/** \see World::plan_day() */
+struct World::DayPlan {
+  /// Constructor
+  DayPlan(const Date& date, const SimDayOptions& opts,
+          const std::shared_ptr<const FeedHerbivores> feed_herbivores,
+          const SimulateDayFunction simulate_day)
+      : date(date),
+        opts(opts),
+        feed_herbivores(feed_herbivores),
+        simulate_day(simulate_day) {}
+
+  /// What to do in one simulation unit.
+  struct Task {
+    /// The simulation unit, owned by \ref World::sim_units.
+    SimulationUnit* sim_unit;
+    /// Whether the re-establishment interval has passed today.
+    bool establish_interval_passed;
+    /// Estimated cost of simulating the unit for the scheduler.
+    /**
+     * This is one plus the number of herbivore objects in all populations
+     * at the beginning of the day. It is only calculated if threads are
+     * enabled.
+     * \see \ref World::enable_threads()
+     */
+    double cost;
+  };
+
+  /// The estimated cost of each task.
+  std::vector<double> get_costs() const {
+    std::vector<double> costs;
+    costs.reserve(tasks.size());
+    for (const auto& task : tasks) costs.push_back(task.cost);
+    return costs;
+  }
+
+  /// The simulation day.
+  const Date date;
+
+  /// Options for the simulation day.
+  const SimDayOptions opts;
+
+  /// One function object to feed all herbivores, possibly on many days.
+  const std::shared_ptr<const FeedHerbivores> feed_herbivores;
+
+  /// Function to simulate one simulation unit.
+  /** \see \ref WorldConstructor::get_simulate_day() */
+  const SimulateDayFunction simulate_day;
+
+  /// One task for each living simulation unit, in the order of creation.
+  std::vector<Task> tasks;
+
+  // The following members are only used by World::submit_day().
+
+  /// Output of each task, aggregated in the order of the tasks at the end.
+  std::vector<Output::CombinedData> outputs;
+
+  /// Whether each task has been submitted.
+  std::vector<bool> submitted;
+
+  /// Number of tasks that have not been submitted yet.
+  std::atomic<int> unsubmitted{0};
+
+  /// Number of submitted tasks that are not finished yet.
+  std::atomic<int> remaining{0};
+
+  /// Completion handles of all submissions for this day.
+  std::vector<std::shared_future<void> > futures;
+};
+
+Output::WriterInterface* World::construct_output_writer() {
+  Output::WriterInterface* writer;
   switch (get_params().output_format) {
     case OutputFormat::TextTables: {
       std::set<std::string> hft_names;
       for (const auto& h : get_hfts()) hft_names.insert(h->name);
-      return new Output::TextTableWriter(get_params().output_interval,
-                                         get_params().output_text_tables,
-                                         hft_names);
+      writer = new Output::TextTableWriter(get_params().output_interval,
+                                           get_params().output_text_tables,
+                                           hft_names);
+      break;
     }
+    case OutputFormat::InMemory:
+      // There is no disk I/O to do in the background.
+      memory_writer = new Output::MemoryWriter();
+      return memory_writer;
       // Construct your new output writer here.
     default:
       throw std::logic_error(
           "Fauna::World::World() "
           "Selected output format parameter is not implemented.");
   }
+  if (get_params().output_async)
+    return new Output::AsyncWriter(writer,
+                                   get_params().output_async_queue_size);
+  return writer;
 }
 
-World::World(const std::string instruction_filename, const SimMode mode)
+World::World(const std::string instruction_filename, const SimMode mode,
+             const std::string cache_filename)
     : mode(mode),
-      insfile(read_instruction_file(instruction_filename)),
+      insfile(read_instruction_file(instruction_filename, cache_filename)),
       days_since_last_establishment(get_params().herbivore_establish_interval),
       output_aggregator(new Output::Aggregator()),
       output_writer(mode == SimMode::Lint ? NULL : construct_output_writer()),
@@ -56,7 +175,7 @@ World::World(const std::string instruction_filename, const SimMode mode)
 
 World::World(const std::shared_ptr<const Parameters> params,
              const std::shared_ptr<const HftList> hftlist)
-    : insfile({hftlist, params}),
+    : insfile({hftlist, params, ""}),
       days_since_last_establishment(get_params().herbivore_establish_interval),
       output_aggregator(new Output::Aggregator()),
       output_writer(construct_output_writer()),
@@ -73,7 +192,33 @@ World::World() : mode(SimMode::Lint) {}  // deprecated
 
 // The destructor must be implemented here in the source file, where the
 // forward-declared types are complete.
-World::~World() = default;
+World::~World() {
+  // The background tasks of submit_day() still refer to this object.
+  if (submitted_day)
+    for (auto& future : submitted_day->futures) future.wait();
+  // A destructor must not throw. So we can only print output errors.
+  try {
+    if (output_writer) output_writer->flush();
+  } catch (const std::exception& e) {
+    std::cerr << "Fauna::World::~World() "
+              << "Error while writing remaining output:\n"
+              << e.what() << std::endl;
+  }
+  try {
+    write_trace();
+  } catch (const std::exception& e) {
+    std::cerr << "Fauna::World::~World() "
+              << "Error while writing trace file:\n"
+              << e.what() << std::endl;
+  }
+}
+
+void World::check_equilibrium_monitor(const std::string& caller) const {
+  if (equilibrium_tolerance < 0.0)
+    throw std::logic_error("Fauna::World::" + caller +
+                           "() "
+                           "The equilibrium monitor has not been enabled.");
+}
 
 void World::create_simulation_unit(std::shared_ptr<Habitat> habitat) {
   if (habitat == NULL)
@@ -100,6 +245,243 @@ void World::create_simulation_unit(std::shared_ptr<Habitat> habitat) {
   simulation_units_checked = false;
 }
 
+int World::create_batch_simulation_unit(const std::string& aggregation_unit) {
+  const int index = batch_habitats.size();
+  batch_habitats.emplace_back(new BatchHabitat(aggregation_unit, index));
+  create_simulation_unit(batch_habitats.back());
+  return index;
+}
+
+void World::enable_equilibrium_monitor(const double tolerance,
+                                       const int years) {
+  if (!std::isfinite(tolerance) || tolerance < 0.0)
+    throw std::invalid_argument(
+        "Fauna::World::enable_equilibrium_monitor() "
+        "Parameter `tolerance` must be a non-negative number.");
+  if (years < 1)
+    throw std::invalid_argument(
+        "Fauna::World::enable_equilibrium_monitor() "
+        "Parameter `years` must be at least 1.");
+  equilibrium_tolerance = tolerance;
+  equilibrium_years = years;
+}
+
+std::size_t World::get_converged_count() const {
+  check_equilibrium_monitor("get_converged_count");
+  std::size_t count = 0;
+  for (const auto& sim_unit : sim_units)
+    if (sim_unit.get_equilibrium_monitor().is_converged(equilibrium_tolerance,
+                                                        equilibrium_years))
+      count++;
+  return count;
+}
+
+void World::enable_profiling(std::ostream* dump) {
+  if (!profile) profile.reset(new Profile());
+  profile_dump = dump;
+}
+
+void World::enable_threads(const int threads, const int chunks_per_thread) {
+  // Keep the old threads if the new ones cannot be started.
+  std::unique_ptr<WorkStealingScheduler> replacement(
+      new WorkStealingScheduler(threads, chunks_per_thread));
+  scheduler.swap(replacement);
+}
+
+void World::enable_tracing(const std::string& filename) {
+  if (tracer)
+    throw std::logic_error(
+        "Fauna::World::enable_tracing() "
+        "Tracing has already been enabled.");
+  tracer.reset(new Tracer(filename));
+}
+
+Output::MemoryWriter& World::get_memory_writer() {
+  if (mode != SimMode::Simulate)
+    throw std::logic_error(
+        "Fauna::World::get_memory_writer() "
+        "This World object is not in simulation mode.");
+  if (get_params().output_format != OutputFormat::InMemory)
+    throw std::logic_error(
+        "Fauna::World::get_memory_writer() "
+        "In-memory output requires `output.format = \"InMemory\"`.");
+  assert(memory_writer);
+  return *memory_writer;
+}
+
+void World::reset_profile() {
+  if (!profile)
+    throw std::logic_error(
+        "Fauna::World::reset_profile() "
+        "Profiling has not been enabled.");
+  profile->reset();
+}
+
+std::vector<Output::Datapoint> World::retrieve_output() {
+  return get_memory_writer().retrieve();
+}
+
+void World::save_checkpoint(const std::string& filename) const {
+  if (mode != SimMode::Simulate)
+    throw std::logic_error(
+        "Fauna::World::save_checkpoint() "
+        "This World object is not in simulation mode.");
+  CheckpointWriter out;
+
+  // Header
+  out.write(CHECKPOINT_MAGIC);
+  out.write(CHECKPOINT_VERSION);
+  out.write(CHECKPOINT_BYTE_ORDER);
+  out.write((std::uint32_t)sizeof(StorageReal));
+  out.write((std::uint64_t)get_hfts().size());
+  for (const auto& hft : get_hfts()) {
+    out.write(hft->name);
+    out.write(get_hft_hash(*hft));
+  }
+
+  // World
+  out.write(days_since_last_establishment);
+  out.write((bool)last_date);
+  if (last_date) out.write(*last_date);
+  output_aggregator->save_state(out);
+
+  // Simulation units
+  out.write((std::uint64_t)sim_units.size());
+  for (const auto& sim_unit : sim_units) {
+    out.write(std::string(sim_unit.get_habitat().get_aggregation_unit()));
+    sim_unit.save_state(out);
+  }
+
+  out.write_to_file(filename);
+}
+
+void World::write_trace() {
+  if (!tracer) return;
+  // Release the tracer even if writing fails so that the destructor doesn’t
+  // try again.
+  std::unique_ptr<Tracer> finished(std::move(tracer));
+  finished->write();
+}
+
+void World::set_output_callback(
+    std::function<void(const Output::Datapoint&)> callback) {
+  get_memory_writer().set_callback(callback);
+}
+
+void World::flush_output() {
+  if (output_writer) output_writer->flush();
+}
+
+void World::load_checkpoint(const std::string& filename) {
+  if (mode != SimMode::Simulate)
+    throw std::logic_error(
+        "Fauna::World::load_checkpoint() "
+        "This World object is not in simulation mode.");
+  const std::string error_msg =
+      "Fauna::World::load_checkpoint() Cannot restore from checkpoint file \"" +
+      filename + "\": ";
+
+  CheckpointReader in(filename);
+  try {
+    // Header
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    in.read(magic);
+    if (std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+      throw std::runtime_error("This is not a megafauna checkpoint file.");
+    std::uint32_t version, byte_order;
+    in.read(version);
+    if (version != CHECKPOINT_VERSION)
+      throw std::runtime_error("Checkpoint format version " +
+                               std::to_string(version) +
+                               " is not supported. Expected version " +
+                               std::to_string(CHECKPOINT_VERSION) + ".");
+    in.read(byte_order);
+    if (byte_order != CHECKPOINT_BYTE_ORDER)
+      throw std::runtime_error(
+          "The checkpoint was written on a platform with different byte "
+          "order.");
+    std::uint32_t storage_size;
+    in.read(storage_size);
+    if (storage_size != sizeof(StorageReal))
+      throw std::runtime_error(
+          "The checkpoint was written with a different floating point "
+          "precision for the herbivore state. Check the CMake option "
+          "MEGAFAUNA_FLOAT_STORAGE.");
+    std::uint64_t hft_count;
+    in.read(hft_count);
+    if (hft_count != get_hfts().size())
+      throw std::runtime_error(
+          "The number of HFTs doesn’t match the instruction file.");
+    for (const auto& hft : get_hfts()) {
+      std::string name;
+      in.read(name);
+      if (name != hft->name)
+        throw std::runtime_error("Expected HFT \"" + hft->name +
+                                 "\", but found \"" + name + "\".");
+      std::uint64_t hash;
+      in.read(hash);
+      if (hash != get_hft_hash(*hft))
+        throw std::runtime_error("The parameters of HFT \"" + hft->name +
+                                 "\" differ from the instruction file.");
+    }
+
+    // Read everything into temporary objects first, so that this object
+    // stays unchanged if the checkpoint is corrupt or doesn’t match.
+
+    // World
+    int restored_days_since_last_establishment;
+    in.read(restored_days_since_last_establishment);
+    bool has_last_date;
+    in.read(has_last_date);
+    std::unique_ptr<Date> restored_last_date;
+    if (has_last_date) {
+      restored_last_date.reset(new Date(0, 0));
+      in.read(*restored_last_date);
+    }
+    Output::Aggregator restored_aggregator;
+    restored_aggregator.load_state(in);
+
+    // Simulation units: new populations for the same habitats.
+    std::uint64_t sim_unit_count;
+    in.read(sim_unit_count);
+    if (sim_unit_count != sim_units.size())
+      throw std::runtime_error(
+          "The checkpoint contains " + std::to_string(sim_unit_count) +
+          " simulation units, but " + std::to_string(sim_units.size()) +
+          " have been created.");
+    std::list<SimulationUnit> restored_units;
+    // Number of habitats so far in each aggregation unit, like in
+    // create_simulation_unit().
+    std::map<std::string, int> habitat_counts;
+    for (const auto& sim_unit : sim_units) {
+      const std::string expected(sim_unit.get_habitat().get_aggregation_unit());
+      std::string agg_unit;
+      in.read(agg_unit);
+      if (agg_unit != expected)
+        throw std::runtime_error(
+            "The aggregation units of the simulation units don’t match. "
+            "Expected \"" +
+            expected + "\", but found \"" + agg_unit + "\".");
+      restored_units.emplace_back(
+          sim_unit.get_habitat_pointer(),
+          world_constructor->create_populations(habitat_counts[agg_unit]++));
+      restored_units.back().load_state(in);
+    }
+
+    if (!in.at_end())
+      throw std::runtime_error("Unexpected data at the end of the file.");
+
+    // Everything has been read successfully.
+    days_since_last_establishment = restored_days_since_last_establishment;
+    last_date = std::move(restored_last_date);
+    *output_aggregator = std::move(restored_aggregator);
+    sim_units.swap(restored_units);
+  } catch (const std::runtime_error& e) {
+    throw std::runtime_error(error_msg + e.what());
+  }
+  simulation_units_checked = false;
+}
+
 const HftList& World::get_hfts() const {
   if (!insfile.hftlist)
     throw std::logic_error(
@@ -109,6 +491,47 @@ const HftList& World::get_hfts() const {
   return *(insfile.hftlist);
 }
 
+std::vector<ThreadStatistics> World::get_thread_statistics() const {
+  if (!scheduler)
+    throw std::logic_error(
+        "Fauna::World::get_thread_statistics() "
+        "Threads have not been enabled.");
+  return scheduler->get_statistics();
+}
+
+const Profile& World::get_profile() const {
+  if (!profile)
+    throw std::logic_error(
+        "Fauna::World::get_profile() "
+        "Profiling has not been enabled.");
+  return *profile;
+}
+
+MemoryUsage World::get_memory_usage() const {
+  MemoryUsage result;
+  for (const auto& sim_unit : sim_units) {
+    result.simulation_unit_count++;
+    // A list node has two pointers besides the element.
+    result.simulation_units += sizeof(SimulationUnit) + 2 * sizeof(void*) +
+                               sizeof(PopulationList) +
+                               get_heap_bytes(sim_unit.get_populations());
+    for (const auto& pop : sim_unit.get_populations())
+      pop->add_memory_usage(result);
+  }
+  if (output_writer) result.output_buffers = output_writer->get_buffer_bytes();
+  if (output_aggregator)
+    result.aggregator = output_aggregator->get_memory_usage();
+  return result;
+}
+
+PoolStatistics World::get_pool_statistics() const {
+  PoolStatistics result;
+  for (const auto& sim_unit : sim_units)
+    for (const auto& pop : sim_unit.get_populations())
+      result += pop->get_pool_statistics();
+  return result;
+}
+
 const Parameters& World::get_params() const {
   if (!insfile.params)
     throw std::logic_error(
@@ -118,6 +541,31 @@ const Parameters& World::get_params() const {
   return *(insfile.params);
 }
 
+bool World::is_converged(const Habitat& habitat) const {
+  check_equilibrium_monitor("is_converged");
+  for (const auto& sim_unit : sim_units)
+    if (&sim_unit.get_habitat() == &habitat)
+      return sim_unit.get_equilibrium_monitor().is_converged(
+          equilibrium_tolerance, equilibrium_years);
+  throw std::invalid_argument(
+      "Fauna::World::is_converged() "
+      "The habitat doesn’t belong to any simulation unit.");
+}
+
+bool World::is_equilibrium_reached() const {
+  check_equilibrium_monitor("is_equilibrium_reached");
+  return !sim_units.empty() && get_converged_count() == sim_units.size();
+}
+
+void World::kill_batch_simulation_unit(const int index) {
+  if (index < 0 || index >= (int)batch_habitats.size())
+    throw std::out_of_range(
+        "Fauna::World::kill_batch_simulation_unit() "
+        "There is no batch habitat with index " +
+        std::to_string(index) + ".");
+  batch_habitats[index]->kill();
+}
+
 int World::get_habitat_count_per_agg_unit() const {
   // Habitat count for each aggregation unit.
   std::unordered_map<std::string, int> hab_counts;
@@ -156,20 +604,50 @@ int World::get_habitat_count_per_agg_unit() const {
 }
 
 World::InsfileContent World::read_instruction_file(
-    const std::string& filename) {
+    const std::string& filename, const std::string& cache_filename) {
   try {
+    InsfileCache cache;
+    if (!cache_filename.empty()) {
+      std::ifstream file(filename, std::ios::binary);
+      if (!file.is_open())
+        throw std::runtime_error("Could not open the file for reading.");
+      std::ostringstream content;
+      content << file.rdbuf();
+      const std::uint64_t key = get_fnv1a_hash(content.str());
+      if (cache.load(cache_filename, key))
+        return World::InsfileContent(
+            {std::make_shared<const HftList>(cache.hfts),
+             std::make_shared<const Parameters>(cache.params),
+             cache.warnings});
+      cache.key = key;
+    }
+
     InsfileReader reader(filename);
+    std::string warnings = reader.get_warnings();
+    if (!cache_filename.empty()) {
+      cache.params = reader.get_params();
+      cache.hfts = reader.get_hfts();
+      cache.warnings = warnings;
+      // Without the cache, the simulation is only slower to start.
+      try {
+        cache.save(cache_filename);
+      } catch (const std::runtime_error& err) {
+        warnings += std::string(err.what()) + '\n';
+      }
+    }
     return World::InsfileContent(
         {std::make_shared<const HftList>(reader.get_hfts()),
-         std::make_shared<const Parameters>(reader.get_params())});
+         std::make_shared<const Parameters>(reader.get_params()), warnings});
   } catch (std::runtime_error& err) {
     throw std::runtime_error("Error reading instruction file \"" + filename +
                              "\":\n" + err.what());
   }
 }
 
-void World::simulate_day(const Date& date, const SimDayOptions& opts) {
-  if (mode != SimMode::Simulate) return;
+void World::check_date(const Date& date, const SimDayOptions& opts) {
+  // Report any errors from writing output in the background.
+  assert(output_writer.get() != NULL);
+  output_writer->check_errors();
 
   // Sanity checks for simulation units
   if (!simulation_units_checked) {
@@ -189,7 +667,11 @@ void World::simulate_day(const Date& date, const SimDayOptions& opts) {
   }
   simulation_units_checked = true;
 
-  if (opts.reset_date) last_date.reset(NULL);
+  if (opts.reset_date) {
+    last_date.reset(NULL);
+    for (auto& sim_unit : sim_units)
+      sim_unit.get_equilibrium_monitor().reset();
+  }
   // Check if `date` follows `last_date`, but only if `last_date` has already
   // been initialized (which happens on the first call).
   if (!opts.reset_date && last_date && !last_date->is_successive(date)) {
@@ -202,12 +684,24 @@ void World::simulate_day(const Date& date, const SimDayOptions& opts) {
         "Now I received Julian day " + std::to_string(date.get_julian_day()) +
         " in year " + std::to_string(date.get_year()));
   }
+}
+
+std::shared_ptr<const FeedHerbivores> World::create_feed_herbivores() {
+  return std::make_shared<const FeedHerbivores>(
+      world_constructor->create_distribute_forage(), profile.get());
+}
 
-  // Create one function object to feed all herbivores.
-  const FeedHerbivores feed_herbivores(
-      world_constructor->create_distribute_forage());
+std::unique_ptr<World::DayPlan> World::plan_day(
+    const Date& date, const SimDayOptions& opts,
+    const std::shared_ptr<const FeedHerbivores> feed_herbivores) {
+  if (profile) profile->days++;
 
-  // We use an iterator in order to be able to call std::list::erase().
+  std::unique_ptr<DayPlan> plan(new DayPlan(
+      date, opts, feed_herbivores, world_constructor->get_simulate_day()));
+
+  // Advance the establishment cycle for all simulation units in order before
+  // any of them is simulated. This way it doesn’t depend on the order in
+  // which the simulation units are simulated.
   for (auto iter = sim_units.begin(); iter != sim_units.end();) {
     SimulationUnit& sim_unit = *iter;
 
@@ -217,47 +711,319 @@ void World::simulate_day(const Date& date, const SimDayOptions& opts) {
       continue;
     }
 
-    // Whether herbivores shall be (re-)established today.
-    bool establish_as_needed = false;
-
-    // If there was no initial establishment yet, we may do this now.
-    if (!sim_unit.is_initial_establishment_done()) establish_as_needed = true;
-
     // If one check interval has passed, we will check if HFTs have died out
     // and need to be re-established.
     // Note that re-establishment is only activated if the interval length is
     // a positive number.
+    bool interval_passed = false;
     if (days_since_last_establishment >=
             get_params().herbivore_establish_interval &&
         get_params().herbivore_establish_interval > 0) {
-      establish_as_needed = true;
+      interval_passed = true;
       days_since_last_establishment = 0;
     }
 
     // Keep track of the establishment cycle.
     if (opts.do_herbivores) days_since_last_establishment++;
 
-    // Create function object to delegate all simulations for this day to.
-    SimulateDay simulate_day(date.get_julian_day(), sim_unit, feed_herbivores);
+    // The simulation of each herbivore and the feeding dominate the cost.
+    double cost = 1.0;
+    if (scheduler)
+      for (const auto& pop : sim_unit.get_populations()) cost += pop->size();
 
-    // Call the function object.
-    simulate_day(opts.do_herbivores, establish_as_needed);
+    plan->tasks.push_back({&sim_unit, interval_passed, cost});
+    iter++;
+  }
+  return plan;
+}
 
-    // Aggregate output.
-    assert(output_aggregator.get() != NULL);
-    output_aggregator->add(date, sim_unit.get_habitat().get_aggregation_unit(),
-                           sim_unit.get_output());
+Output::CombinedData World::simulate_unit(
+    const DayPlan& plan, const int unit_index, Profile* unit_profile,
+    const FeedHerbivores& feed_herbivores) {
+  const DayPlan::Task& task = plan.tasks[unit_index];
+  SimulationUnit& sim_unit = *task.sim_unit;
 
-    iter++;
+  // Whether herbivores shall be (re-)established today. If there was no
+  // initial establishment yet, we may do this now.
+  const bool establish_as_needed = task.establish_interval_passed ||
+                                   !sim_unit.is_initial_establishment_done();
+
+  // Whether the herbivores in this simulation unit are simulated today.
+  // A unit without herbivores has zero change and therefore counts as
+  // converged, but it must not be skipped, so that it can be re-established.
+  const bool do_herbivores =
+      plan.opts.do_herbivores &&
+      !(plan.opts.skip_converged && equilibrium_tolerance >= 0.0 &&
+        sim_unit.has_herbivores() &&
+        sim_unit.get_equilibrium_monitor().is_converged(equilibrium_tolerance,
+                                                        equilibrium_years));
+
+  if (!(do_herbivores && establish_as_needed) && !sim_unit.has_herbivores()) {
+    // Without herbivores, only the habitat needs to be updated until the next
+    // establishment.
+    TraceScope trace(tracer.get(), "habitat_init_day", unit_index);
+    sim_unit.get_habitat().init_day(plan.date.get_julian_day());
+    if (unit_profile) unit_profile->empty_unit_days++;
+  } else {
+    // Delegate all simulations for this day to the selected function.
+    plan.simulate_day(plan.date.get_julian_day(), sim_unit, feed_herbivores,
+                      unit_profile, tracer.get(), unit_index, do_herbivores,
+                      establish_as_needed);
+  }
+  if (unit_profile) unit_profile->unit_days++;
+
+  Output::CombinedData output;
+  {
+    ScopedTimer timer(unit_profile, ProfilePhase::GetOutput);
+    TraceScope trace(tracer.get(), "get_output", unit_index);
+    output = sim_unit.get_output();
   }
 
+  if (equilibrium_tolerance >= 0.0)
+    sim_unit.get_equilibrium_monitor().add_day(plan.date, output);
+  return output;
+}
+
+void World::aggregate_output(const DayPlan& plan, const int unit_index,
+                             const Output::CombinedData& output) {
+  assert(output_aggregator.get() != NULL);
+  ScopedTimer timer(profile.get(), ProfilePhase::Aggregation);
+  TraceScope trace(tracer.get(), "aggregation", unit_index);
+  output_aggregator->add(
+      plan.date,
+      plan.tasks[unit_index].sim_unit->get_habitat().get_aggregation_unit(),
+      output);
+}
+
+void World::end_day(const DayPlan& plan) {
   // Write output when it’s ready.
   assert(output_writer.get() != NULL);
-  if (!sim_units.empty() &&
+  if (!plan.tasks.empty() &&
       output_aggregator->get_interval().matches_output_interval(
-          get_params().output_interval))
-    for (const auto& datapoint : output_aggregator->retrieve())
-      output_writer->write_datapoint(datapoint);
+          get_params().output_interval)) {
+    std::vector<Output::Datapoint> datapoints;
+    {
+      ScopedTimer timer(profile.get(), ProfilePhase::Aggregation);
+      TraceScope trace(tracer.get(), "aggregation");
+      datapoints = output_aggregator->retrieve();
+    }
+    {
+      ScopedTimer timer(profile.get(), ProfilePhase::OutputWriting);
+      TraceScope trace(tracer.get(), "output_writing");
+      for (auto& datapoint : datapoints)
+        output_writer->take_datapoint(std::move(datapoint));
+    }
+    if (profile && profile_dump) profile->print(*profile_dump);
+  }
 
-  last_date.reset(new Date(date));
+  last_date.reset(new Date(plan.date));
+}
+
+void World::simulate_day(const Date& date, const SimDayOptions& opts) {
+  if (mode != SimMode::Simulate) return;
+  wait_for_submitted_day("simulate_day");
+
+  check_date(date, opts);
+  const std::unique_ptr<DayPlan> plan =
+      plan_day(date, opts, create_feed_herbivores());
+  std::vector<Output::CombinedData> outputs(plan->tasks.size());
+  simulate_units(plan->get_costs(), *plan->feed_herbivores,
+                 [&](const int i, Profile* unit_profile,
+                     const FeedHerbivores& feed_herbivores) {
+                   TraceScope unit_trace(tracer.get(), "simulation_unit", i);
+                   outputs[i] =
+                       simulate_unit(*plan, i, unit_profile, feed_herbivores);
+                 });
+  for (int i = 0; i < (int)plan->tasks.size(); i++)
+    aggregate_output(*plan, i, outputs[i]);
+  end_day(*plan);
+}
+
+void World::simulate_days(const Date& first, const Date& last,
+                          const SimDayOptions& opts) {
+  if (mode != SimMode::Simulate) return;
+  if (last < first)
+    throw std::invalid_argument(
+        "Fauna::World::simulate_days() "
+        "The last day is before the first day.");
+  wait_for_submitted_day("simulate_days");
+
+  check_date(first, opts);
+  SimDayOptions day_opts = opts;
+  day_opts.reset_date = false;
+  const std::shared_ptr<const FeedHerbivores> feed_herbivores =
+      create_feed_herbivores();
+
+  Date next = first;
+  while (!(last < next)) {
+    // Plan a block of days so that the buffered output doesn’t exceed the
+    // limit.
+    std::vector<std::unique_ptr<DayPlan> > plans;
+    do {
+      plans.push_back(plan_day(next, day_opts, feed_herbivores));
+      next = next.get_next();
+    } while (!(last < next) &&
+             (plans.size() + 1) * plans.front()->tasks.size() <=
+                 MAX_BUFFERED_OUTPUTS);
+    const int day_count = plans.size();
+    const int unit_count = plans.front()->tasks.size();
+
+    // Simulate each simulation unit through all days of the block.
+    // The cost estimate of the first day stands for the whole block.
+    std::vector<Output::CombinedData> outputs(day_count * unit_count);
+    simulate_units(plans.front()->get_costs(), *feed_herbivores,
+                   [&](const int u, Profile* unit_profile,
+                       const FeedHerbivores& unit_feed_herbivores) {
+                     TraceScope unit_trace(tracer.get(), "simulation_unit", u);
+                     for (int d = 0; d < day_count; d++)
+                       outputs[u * day_count + d] = simulate_unit(
+                           *plans[d], u, unit_profile, unit_feed_herbivores);
+                   });
+
+    // Aggregate in the same order as simulate_day().
+    for (int d = 0; d < day_count; d++) {
+      for (int u = 0; u < unit_count; u++)
+        aggregate_output(*plans[d], u, outputs[u * day_count + d]);
+      end_day(*plans[d]);
+    }
+  }
+}
+
+void World::simulate_units(const std::vector<double>& costs,
+                           const FeedHerbivores& feed_herbivores,
+                           const UnitFunction& function) {
+  if (!scheduler) {
+    for (int i = 0; i < (int)costs.size(); i++)
+      function(i, profile.get(), feed_herbivores);
+    return;
+  }
+
+  // Each thread measures into its own profile, so that the threads don’t
+  // write to the same memory.
+  const int thread_count = scheduler->get_thread_count();
+  std::vector<Profile> profiles(profile ? thread_count : 0);
+  std::vector<std::unique_ptr<const FeedHerbivores> > feeders;
+  for (int t = 0; t < thread_count; t++)
+    feeders.emplace_back(
+        new FeedHerbivores(world_constructor->create_distribute_forage(),
+                           profile ? &profiles[t] : NULL));
+
+  scheduler->run(costs, [&](const int task, const int thread) {
+    function(task, profile ? &profiles[thread] : NULL, *feeders[thread]);
+  });
+  for (const auto& thread_profile : profiles) *profile += thread_profile;
+}
+
+std::shared_future<void> World::submit_day(
+    const Date& date, const std::vector<std::string>& aggregation_units,
+    const SimDayOptions& opts) {
+  if (mode != SimMode::Simulate) {
+    std::promise<void> nothing;
+    nothing.set_value();
+    return nothing.get_future().share();
+  }
+
+  if (submitted_day && !(submitted_day->date == date)) {
+    wait_for_submitted_day("submit_day");
+    submitted_day.reset();
+  }
+  if (!submitted_day) {
+    check_date(date, opts);
+    submitted_day = plan_day(date, opts, create_feed_herbivores());
+    const int count = submitted_day->tasks.size();
+    submitted_day->outputs.resize(count);
+    submitted_day->submitted.assign(count, false);
+    submitted_day->unsubmitted = count;
+  }
+  DayPlan& plan = *submitted_day;
+
+  // Select the tasks that haven’t been submitted yet.
+  std::vector<int> selection;
+  for (int i = 0; i < (int)plan.tasks.size(); i++) {
+    if (plan.submitted[i]) continue;
+    const std::string agg_unit =
+        plan.tasks[i].sim_unit->get_habitat().get_aggregation_unit();
+    if (aggregation_units.empty() ||
+        std::find(aggregation_units.begin(), aggregation_units.end(),
+                  agg_unit) != aggregation_units.end())
+      selection.push_back(i);
+  }
+  for (const auto& agg_unit : aggregation_units) {
+    bool found = false;
+    for (const int i : selection)
+      if (agg_unit == plan.tasks[i].sim_unit->get_habitat()
+                          .get_aggregation_unit())
+        found = true;
+    if (!found)
+      throw std::invalid_argument(
+          "Fauna::World::submit_day() "
+          "The aggregation unit \"" +
+          agg_unit +
+          "\" has no simulation units left to simulate on this day. Either "
+          "it doesn’t exist or it has already been submitted.");
+  }
+  for (const int i : selection) plan.submitted[i] = true;
+  // Increment `remaining` first so that a running task doesn’t see all
+  // tasks as submitted and finished before the new ones have even started.
+  plan.remaining += selection.size();
+  plan.unsubmitted -= selection.size();
+
+  // The tasks run one after the other in one background thread, so that
+  // they don’t compete for profile, tracer, and output aggregator. The host
+  // program works in parallel.
+  const auto task = [this, &plan, selection]() {
+    for (const int i : selection) {
+      TraceScope unit_trace(tracer.get(), "simulation_unit", i);
+      plan.outputs[i] =
+          simulate_unit(plan, i, profile.get(), *plan.feed_herbivores);
+      plan.remaining--;
+    }
+    // The last task aggregates all output in the original order.
+    if (plan.unsubmitted == 0 && plan.remaining == 0) {
+      for (int i = 0; i < (int)plan.tasks.size(); i++)
+        aggregate_output(plan, i, plan.outputs[i]);
+      end_day(plan);
+    }
+  };
+  if (!submit_queue) submit_queue.reset(new TaskQueue());
+  plan.futures.push_back(submit_queue->submit(task));
+  return plan.futures.back();
+}
+
+void World::wait_for_submitted_day(const std::string& caller) {
+  if (!submitted_day) return;
+  if (submitted_day->unsubmitted > 0)
+    throw std::logic_error("Fauna::World::" + caller +
+                           "() "
+                           "Not all simulation units have been submitted "
+                           "for the day that has been started with "
+                           "submit_day().");
+  for (auto& future : submitted_day->futures) future.wait();
+  // Only the last task completes the day. If any task has failed, the
+  // error has been passed to the host program through its future.
+  submitted_day.reset();
+}
+
+void World::simulate_day(const Date& date, const BatchForcing& forcing,
+                         const SimDayOptions& opts) {
+  if (mode != SimMode::Simulate) return;
+  if (!batch_habitats.empty() &&
+      (!forcing.grass_mass || !forcing.grass_digestibility ||
+       !forcing.grass_nitrogen_mass || !forcing.grass_fpc ||
+       !forcing.air_temperature || !forcing.eaten_grass))
+    throw std::invalid_argument(
+        "Fauna::World::simulate_day() "
+        "An array in the batch forcing is NULL.");
+
+  std::fill(forcing.eaten_grass, forcing.eaten_grass + batch_habitats.size(),
+            0.0);
+  for (auto& habitat : batch_habitats) habitat->set_forcing(&forcing);
+  // The habitats must not keep pointers to the arrays after this call.
+  try {
+    simulate_day(date, opts);
+  } catch (...) {
+    for (auto& habitat : batch_habitats) habitat->set_forcing(NULL);
+    throw;
+  }
+  for (auto& habitat : batch_habitats) habitat->set_forcing(NULL);
 }
@@ -10,15 +10,62 @@
  */
 #include "world.h"
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "batch_forcing.h"
 #include "catch.hpp"
 #include "cohort_population.h"
+#include "datapoint.h"
 #include "date.h"
 #include "dummy_habitat.h"
 #include "dummy_hft.h"
+#include "memory_usage.h"
 #include "parameters.h"
+#include "profile.h"
 #include "simulation_unit.h"
 using namespace Fauna;
 
+namespace {
+/// A habitat with a constant, plentiful amount of grass.
+class PastureHabitat : public DummyHabitat {
+ public:
+  using DummyHabitat::DummyHabitat;
+  virtual HabitatForage get_available_forage() const {
+    HabitatForage forage;
+    forage.grass.set_mass(1e6);
+    forage.grass.set_digestibility(0.6);
+    forage.grass.set_fpc(0.5);
+    return forage;
+  }
+};
+
+/// Check that two simulations produced the same output in the same order.
+void check_same_output(const std::vector<Output::Datapoint>& expected,
+                       const std::vector<Output::Datapoint>& result) {
+  REQUIRE(result.size() == expected.size());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    CHECK(result[i].aggregation_unit == expected[i].aggregation_unit);
+    CHECK(result[i].interval.get_first() == expected[i].interval.get_first());
+    CHECK(result[i].data.datapoint_count == expected[i].data.datapoint_count);
+    CHECK(result[i].data.habitat_data.eaten_forage[ForageType::Grass] ==
+          expected[i].data.habitat_data.eaten_forage[ForageType::Grass]);
+    REQUIRE(result[i].data.hft_data.size() ==
+            expected[i].data.hft_data.size());
+    for (const auto& itr : expected[i].data.hft_data) {
+      const Output::HerbivoreData& herbi =
+          result[i].data.hft_data.at(itr.first);
+      CHECK(herbi.inddens == itr.second.inddens);
+      CHECK(herbi.massdens == itr.second.massdens);
+      CHECK(herbi.bodyfat == itr.second.bodyfat);
+      CHECK(herbi.mortality == itr.second.mortality);
+    }
+  }
+}
+}  // namespace
+
 TEST_CASE("FAUNA::World", "") {
   static const std::shared_ptr<const Parameters> PARAMS(new Parameters);
   static const std::shared_ptr<const HftList> HFTLIST(create_hfts(3, *PARAMS));
@@ -446,4 +493,614 @@ TEST_CASE("FAUNA::World", "") {
       CHECK_NOTHROW(world.simulate_day(Date(0, 0)));
     }
   }
+
+  SECTION("Asynchronous output") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_async = true;
+    params->output_async_queue_size = 1;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new DummyHabitat("1")));
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new DummyHabitat("2")));
+    for (int day = 0; day < 10; day++)
+      CHECK_NOTHROW(world.simulate_day(Date(day, 0)));
+    CHECK_NOTHROW(world.flush_output());
+  }
+
+  SECTION("In-memory output") {
+    // Text tables have no in-memory interface.
+    CHECK_THROWS(World(PARAMS, HFTLIST).retrieve_output());
+    CHECK_THROWS(World(PARAMS, HFTLIST).set_output_callback(NULL));
+
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new DummyHabitat("1")));
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new DummyHabitat("2")));
+
+    world.simulate_day(Date(0, 0));
+    world.simulate_day(Date(1, 0));
+    SECTION("Pull") {
+      const auto datapoints = world.retrieve_output();
+      // Two days for two aggregation units.
+      REQUIRE(datapoints.size() == 4);
+      CHECK(datapoints[0].interval.get_first() == Date(0, 0));
+      CHECK(datapoints[3].interval.get_first() == Date(1, 0));
+      CHECK(world.retrieve_output().empty());
+    }
+    SECTION("Push") {
+      int count = 0;
+      world.set_output_callback(
+          [&count](const Output::Datapoint&) { count++; });
+      CHECK(count == 4);
+      world.simulate_day(Date(2, 0));
+      CHECK(count == 6);
+      CHECK(world.retrieve_output().empty());
+    }
+  }
+
+  SECTION("Equilibrium monitor") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    World world(params, HFTLIST);
+    std::shared_ptr<Habitat> habitat(new PastureHabitat());
+    world.create_simulation_unit(habitat);
+
+    CHECK_THROWS_AS(world.is_equilibrium_reached(), std::logic_error);
+    CHECK_THROWS_AS(world.get_converged_count(), std::logic_error);
+    CHECK_THROWS_AS(world.is_converged(*habitat), std::logic_error);
+    CHECK_THROWS_AS(world.enable_equilibrium_monitor(-1.0),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(world.enable_equilibrium_monitor(NAN),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(world.enable_equilibrium_monitor(0.1, 0),
+                    std::invalid_argument);
+
+    // Every change is below 100%, so each complete year counts.
+    world.enable_equilibrium_monitor(1.0, 2);
+    CHECK_THROWS_AS(world.is_converged(DummyHabitat()), std::invalid_argument);
+
+    World::SimDayOptions opts;
+    opts.skip_converged = true;
+    for (int year = 0; year < 3; year++) {
+      CHECK(!world.is_equilibrium_reached());
+      for (int day = 0; day < 365; day++)
+        world.simulate_day(Date(day, year), opts);
+    }
+    CHECK(world.is_equilibrium_reached());
+    CHECK(world.is_converged(*habitat));
+    CHECK(world.get_converged_count() == 1);
+
+    // The herbivores of the converged simulation unit are frozen.
+    const auto& populations = world.get_sim_units().front().get_populations();
+    const double kg_per_km2 = populations.front()->get_kg_per_km2();
+    REQUIRE(kg_per_km2 > 0.0);
+    for (int day = 0; day < 10; day++) world.simulate_day(Date(day, 3), opts);
+    CHECK(populations.front()->get_kg_per_km2() == kg_per_km2);
+    opts.skip_converged = false;
+    world.simulate_day(Date(10, 3), opts);
+    CHECK(populations.front()->get_kg_per_km2() != kg_per_km2);
+
+    // A new simulation from the beginning resets the monitor.
+    opts.reset_date = true;
+    world.simulate_day(Date(0, 0), opts);
+    CHECK(!world.is_equilibrium_reached());
+  }
+
+  SECTION("Equilibrium monitor with extinct simulation unit") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->herbivore_establish_interval = 4 * 365;
+    World world(params, HFTLIST);
+    // Without forage, the herbivores die out.
+    std::shared_ptr<Habitat> habitat(new DummyHabitat());
+    world.create_simulation_unit(habitat);
+    world.enable_equilibrium_monitor(0.01, 1);
+
+    World::SimDayOptions opts;
+    opts.skip_converged = true;
+    for (int year = 0; year < 4; year++)
+      for (int day = 0; day < 365; day++)
+        world.simulate_day(Date(day, year), opts);
+    const SimulationUnit& sim_unit = world.get_sim_units().front();
+    REQUIRE(!sim_unit.has_herbivores());
+    // Zero densities don’t change.
+    CHECK(world.is_converged(*habitat));
+
+    // The extinct simulation unit is not skipped, but re-established.
+    bool reestablished = false;
+    for (int day = 0; day < 365 && !reestablished; day++) {
+      world.simulate_day(Date(day, 4), opts);
+      reestablished = sim_unit.has_herbivores();
+    }
+    CHECK(reestablished);
+  }
+
+  SECTION("Profiling") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+
+    CHECK_THROWS_AS(world.get_profile(), std::logic_error);
+    CHECK_THROWS_AS(world.reset_profile(), std::logic_error);
+
+    std::ostringstream dump;
+    world.enable_profiling(&dump);
+    for (int day = 0; day < 3; day++) world.simulate_day(Date(day, 0));
+
+    const Profile& profile = world.get_profile();
+    CHECK(profile.days == 3);
+    CHECK(profile.unit_days == 6);
+    CHECK(profile.herbivore_days > 0);
+    CHECK(profile.feeding_iterations >= 6);
+    CHECK(profile[ProfilePhase::Establishment].calls == 2);
+    CHECK(profile[ProfilePhase::SimulateHerbivores].calls == 6);
+    CHECK(profile[ProfilePhase::FeedingEat].calls > 0);
+    CHECK(profile[ProfilePhase::GetOutput].calls == 6);
+    CHECK(profile[ProfilePhase::OutputWriting].calls == 3);
+    CHECK(profile.get_total_seconds() > 0.0);
+
+    // The profile is printed with each daily output.
+    CHECK(dump.str().find("output_writing") != std::string::npos);
+
+    CHECK(profile.empty_unit_days == 0);
+
+    // Before establishment, there are no herbivores.
+    World::SimDayOptions opts;
+    opts.do_herbivores = false;
+    opts.reset_date = true;
+    World pasture(params, HFTLIST);
+    pasture.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+    pasture.enable_profiling();
+    pasture.simulate_day(Date(0, 0), opts);
+    CHECK(pasture.get_profile().empty_unit_days == 1);
+    CHECK(!pasture.get_sim_units().front().has_herbivores());
+    CHECK(pasture.get_pool_statistics().bytes == 0);
+    pasture.simulate_day(Date(1, 0));
+    CHECK(pasture.get_profile().empty_unit_days == 1);
+    CHECK(pasture.get_profile().unit_days == 2);
+    CHECK(pasture.get_sim_units().front().has_herbivores());
+    CHECK(pasture.get_pool_statistics().in_use > 0);
+    CHECK(pasture.get_pool_statistics().bytes > 0);
+
+    world.reset_profile();
+    CHECK(world.get_profile().days == 0);
+    CHECK(world.get_profile().get_total_seconds() == 0.0);
+  }
+
+  SECTION("Memory usage") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    CHECK(world.get_memory_usage().simulation_unit_count == 0);
+    CHECK(world.get_memory_usage().cohorts == 0);
+
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+    world.simulate_day(Date(0, 0));
+
+    const MemoryUsage usage = world.get_memory_usage();
+    CHECK(usage.simulation_unit_count == 2);
+    CHECK(usage.population_count == 2 * HFTLIST->size());
+    CHECK(usage.cohort_count > 0);
+    CHECK(usage.simulation_units > 0);
+    CHECK(usage.populations > 0);
+    CHECK(usage.cohorts > usage.cohort_count * sizeof(HerbivoreCohort));
+    CHECK(usage.output_buffers > 0);  // The daily datapoint is kept.
+    CHECK(usage.aggregator > 0);
+    CHECK(usage.get_total() > usage.cohorts);
+
+    std::ostringstream text;
+    usage.print(text);
+    CHECK(text.str().find("cohorts: ") != std::string::npos);
+
+    // Retrieving the output empties the buffer.
+    world.retrieve_output();
+    CHECK(world.get_memory_usage().output_buffers == 0);
+  }
+
+  SECTION("Batch forcing") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    CHECK(world.create_batch_simulation_unit("a") == 0);
+    CHECK(world.create_batch_simulation_unit("b") == 1);
+    CHECK(world.get_batch_habitat_count() == 2);
+    CHECK(world.get_sim_units().size() == 2);
+
+    const double mass[] = {1e6, 1e6};
+    const double digestibility[] = {0.6, 0.6};
+    const double nitrogen[] = {1e4, 1e4};
+    const double fpc[] = {0.5, 0.5};
+    const double temperature[] = {20.0, 20.0};
+    double eaten[] = {-1.0, -1.0};
+    BatchForcing forcing;
+    CHECK_THROWS_AS(world.simulate_day(Date(0, 0), forcing),
+                    std::invalid_argument);
+    forcing.grass_mass = mass;
+    forcing.grass_digestibility = digestibility;
+    forcing.grass_nitrogen_mass = nitrogen;
+    forcing.grass_fpc = fpc;
+    forcing.air_temperature = temperature;
+    forcing.eaten_grass = eaten;
+
+    // Without forcing arrays, the batch habitats cannot be initialized.
+    CHECK_THROWS_AS(world.simulate_day(Date(0, 0)), std::logic_error);
+
+    for (int day = 0; day < 10; day++) {
+      world.simulate_day(Date(day, 0), forcing);
+      const auto datapoints = world.retrieve_output();
+      REQUIRE(datapoints.size() == 2);
+      for (int i = 0; i < 2; i++) {
+        const Output::HabitatData& habitat = datapoints[i].data.habitat_data;
+        CHECK(habitat.available_forage.grass.get_mass() == mass[i]);
+        CHECK(habitat.environment.air_temperature == temperature[i]);
+        CHECK(habitat.eaten_forage[ForageType::Grass] == Approx(eaten[i]));
+      }
+    }
+    // The herbivores have been eating.
+    CHECK(eaten[0] > 0.0);
+    CHECK(eaten[1] > 0.0);
+
+    CHECK_THROWS_AS(world.kill_batch_simulation_unit(2), std::out_of_range);
+    CHECK_THROWS_AS(world.kill_batch_simulation_unit(-1), std::out_of_range);
+    world.kill_batch_simulation_unit(0);
+    world.simulate_day(Date(10, 0), forcing);
+    CHECK(world.get_sim_units().size() == 1);
+    CHECK(eaten[0] == 0.0);
+    CHECK(eaten[1] > 0.0);
+
+    // Batch habitats can be mixed with habitat objects.
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+    CHECK(world.get_batch_habitat_count() == 2);
+    CHECK_NOTHROW(world.simulate_day(Date(11, 0), forcing));
+    CHECK(world.get_sim_units().size() == 2);
+  }
+
+  SECTION("Simulate many days") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    params->herbivore_establish_interval = 30;
+    World daily(params, HFTLIST);
+    World ranged(params, HFTLIST);
+    for (const auto& agg_unit : {"1", "1", "2", "2"}) {
+      daily.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+      ranged.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+    }
+
+    CHECK_THROWS_AS(ranged.simulate_days(Date(10, 0), Date(9, 0)),
+                    std::invalid_argument);
+    for (int i = 0; i < 400; i++) daily.simulate_day(Date(i % 365, i / 365));
+    ranged.simulate_days(Date(0, 0), Date(34, 1));
+    // The range continues the simulation just like single days.
+    CHECK_THROWS_AS(ranged.simulate_days(Date(0, 0), Date(1, 0)),
+                    std::invalid_argument);
+
+    const auto expected = daily.retrieve_output();
+    const auto result = ranged.retrieve_output();
+    REQUIRE(expected.size() == 2 * 400);
+    REQUIRE(!expected.back().data.hft_data.empty());
+    check_same_output(expected, result);
+    CHECK_NOTHROW(ranged.simulate_day(Date(35, 1)));
+  }
+
+  SECTION("Submit day") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World blocking(params, HFTLIST);
+    World async(params, HFTLIST);
+    for (const auto& agg_unit : {"1", "1", "2", "2"}) {
+      blocking.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+      async.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+    }
+
+    // The host submits the aggregation units one by one and doesn’t wait
+    // before it submits the next day.
+    std::vector<std::shared_future<void> > futures;
+    for (int day = 0; day < 40; day++) {
+      blocking.simulate_day(Date(day, 0));
+      futures.push_back(async.submit_day(Date(day, 0), {"2"}));
+      futures.push_back(async.submit_day(Date(day, 0), {"1"}));
+    }
+    for (auto& future : futures) CHECK_NOTHROW(future.get());
+    CHECK_THROWS_AS(async.submit_day(Date(40, 0), {"3"}),
+                    std::invalid_argument);
+    CHECK_THROWS_AS(async.simulate_day(Date(40, 0)), std::logic_error);
+    CHECK_THROWS_AS(async.submit_day(Date(41, 0)), std::logic_error);
+    async.submit_day(Date(40, 0), {"1"}).get();
+    CHECK_THROWS_AS(async.submit_day(Date(40, 0), {"1"}),
+                    std::invalid_argument);
+    async.submit_day(Date(40, 0)).get();
+    blocking.simulate_day(Date(40, 0));
+
+    // The output is identical and in the same order.
+    const auto expected = blocking.retrieve_output();
+    const auto result = async.retrieve_output();
+    REQUIRE(expected.size() == 2 * 41);
+    REQUIRE(!expected.back().data.hft_data.empty());
+    check_same_output(expected, result);
+
+    // The blocking interface continues with the next day.
+    CHECK_NOTHROW(async.simulate_day(Date(41, 0)));
+    CHECK_THROWS_AS(async.submit_day(Date(41, 0)), std::invalid_argument);
+  }
+
+  SECTION("Parallel threads") {
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    params->herbivore_establish_interval = 30;
+    World serial(params, HFTLIST);
+    World parallel(params, HFTLIST);
+    const std::vector<std::string> AGG_UNITS = {"1", "1", "2", "2", "3", "3"};
+    for (const auto& agg_unit : AGG_UNITS) {
+      serial.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+      parallel.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat(agg_unit)));
+    }
+
+    CHECK_THROWS_AS(parallel.get_thread_statistics(), std::logic_error);
+    CHECK_THROWS_AS(parallel.enable_threads(0), std::invalid_argument);
+    CHECK_THROWS_AS(parallel.enable_threads(2, 0), std::invalid_argument);
+    const int THREADS = 4;
+    parallel.enable_threads(THREADS, 2);
+    serial.enable_profiling();
+    parallel.enable_profiling();
+
+    for (int day = 0; day < 50; day++) {
+      serial.simulate_day(Date(day, 0));
+      parallel.simulate_day(Date(day, 0));
+    }
+    serial.simulate_days(Date(50, 0), Date(99, 0));
+    parallel.simulate_days(Date(50, 0), Date(99, 0));
+
+    // The output is identical and in the same order.
+    const auto expected = serial.retrieve_output();
+    const auto result = parallel.retrieve_output();
+    REQUIRE(expected.size() == 3 * 100);
+    REQUIRE(!expected.back().data.hft_data.empty());
+    check_same_output(expected, result);
+
+    // The profiles of all threads are summed up.
+    CHECK(parallel.get_profile().days == serial.get_profile().days);
+    CHECK(parallel.get_profile().unit_days == 6 * 100);
+    CHECK(parallel.get_profile().herbivore_days ==
+          serial.get_profile().herbivore_days);
+    CHECK(parallel.get_profile().feeding_iterations ==
+          serial.get_profile().feeding_iterations);
+
+    // simulate_day() has one task per simulation unit and day, but
+    // simulate_days() only one per simulation unit.
+    const auto statistics = parallel.get_thread_statistics();
+    REQUIRE(statistics.size() == THREADS);
+    ThreadStatistics sum;
+    for (const auto& stats : statistics) sum += stats;
+    CHECK(sum.runs == THREADS * (50 + 1));
+    CHECK(sum.tasks == 6 * (50 + 1));
+
+    // A failed call keeps the threads and their statistics.
+    CHECK_THROWS_AS(parallel.enable_threads(0), std::invalid_argument);
+    REQUIRE(parallel.get_thread_statistics().size() == THREADS);
+    CHECK(parallel.get_thread_statistics().front().runs == 50 + 1);
+
+    // Enabling again resets the statistics.
+    parallel.enable_threads(1);
+    REQUIRE(parallel.get_thread_statistics().size() == 1);
+    CHECK(parallel.get_thread_statistics().front().tasks == 0);
+    CHECK_NOTHROW(parallel.simulate_day(Date(100, 0)));
+    CHECK(parallel.get_thread_statistics().front().tasks == 6);
+  }
+
+  SECTION("Tracing") {
+    const std::string FILENAME = "world_test_trace.json";
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Daily;
+    World world(params, HFTLIST);
+    world.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat()));
+
+    world.enable_tracing(FILENAME);
+    CHECK_THROWS_AS(world.enable_tracing(FILENAME), std::logic_error);
+    for (int day = 0; day < 3; day++) world.simulate_day(Date(day, 0));
+    world.write_trace();
+
+    std::ifstream file(FILENAME);
+    REQUIRE(file.good());
+    std::stringstream json;
+    json << file.rdbuf();
+    CHECK(json.str().find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.str().find("\"habitat_init_day\"") != std::string::npos);
+    CHECK(json.str().find("\"feeding\"") != std::string::npos);
+    CHECK(json.str().find("\"output_writing\"") != std::string::npos);
+    file.close();
+    std::remove(FILENAME.c_str());
+  }
+
+  SECTION("Checkpoint") {
+    const std::string FILENAME = "world_test_checkpoint.bin";
+    std::shared_ptr<Parameters> params(new Parameters);
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = OutputInterval::Annual;
+
+    // Simulate into the middle of an output interval and save the state.
+    World original(params, HFTLIST);
+    original.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat("1")));
+    original.create_simulation_unit(
+        std::shared_ptr<Habitat>(new PastureHabitat("2")));
+    for (int day = 0; day < 200; day++) original.simulate_day(Date(day, 0));
+    original.save_checkpoint(FILENAME);
+
+    SECTION("Restored simulation continues identically") {
+      World restored(params, HFTLIST);
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("1")));
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("2")));
+      restored.load_checkpoint(FILENAME);
+
+      // The next day must follow the last day of the original.
+      CHECK_THROWS(restored.simulate_day(Date(0, 0)));
+
+      for (int year = 0; year < 2; year++)
+        for (int day = (year == 0) ? 200 : 0; day < 365; day++) {
+          original.simulate_day(Date(day, year));
+          restored.simulate_day(Date(day, year));
+        }
+      const auto expected = original.retrieve_output();
+      const auto result = restored.retrieve_output();
+      // Two years for two aggregation units.
+      REQUIRE(expected.size() == 4);
+      // Make sure there are herbivores to compare.
+      REQUIRE(!expected[0].data.hft_data.empty());
+      CHECK(expected[0].data.hft_data.begin()->second.inddens > 0.0);
+      // The herbivores are still alive, so the restored state evolves.
+      REQUIRE(!expected[3].data.hft_data.empty());
+      CHECK(expected[3].data.hft_data.begin()->second.inddens > 0.0);
+      check_same_output(expected, result);
+    }
+
+    SECTION("Different HFTs") {
+      World restored(params,
+                     std::shared_ptr<const HftList>(create_hfts(2, *params)));
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("1")));
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("2")));
+      CHECK_THROWS_AS(restored.load_checkpoint(FILENAME), std::runtime_error);
+    }
+
+    SECTION("Changed HFT parameters") {
+      std::shared_ptr<HftList> hfts(new HftList(*HFTLIST));
+      std::shared_ptr<Hft> changed(new Hft(*hfts->front()));
+      changed->establishment_density *= 2.0;
+      hfts->front() = changed;
+      World restored(params, hfts);
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("1")));
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("2")));
+      CHECK_THROWS_AS(restored.load_checkpoint(FILENAME), std::runtime_error);
+    }
+
+    SECTION("Different simulation units") {
+      World restored(params, HFTLIST);
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("2")));
+      restored.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("1")));
+      CHECK_THROWS_AS(restored.load_checkpoint(FILENAME), std::runtime_error);
+
+      World missing(params, HFTLIST);
+      missing.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat("1")));
+      CHECK_THROWS_AS(missing.load_checkpoint(FILENAME), std::runtime_error);
+
+      // A failed restore leaves the object unchanged: It still starts on
+      // any day and has not established herbivores.
+      CHECK(!missing.get_sim_units().front().is_initial_establishment_done());
+      CHECK_NOTHROW(missing.simulate_day(Date(0, 0)));
+    }
+
+    SECTION("Missing file") {
+      World restored(params, HFTLIST);
+      CHECK_THROWS_AS(restored.load_checkpoint("non-existing file"),
+                      std::runtime_error);
+    }
+
+    std::remove(FILENAME.c_str());
+  }
+}
+
+TEST_CASE("FAUNA::World instances in parallel threads", "") {
+  // Build with ENABLE_TSAN to let ThreadSanitizer find data races here.
+  std::shared_ptr<Parameters> params(new Parameters);
+  params->output_format = OutputFormat::InMemory;
+  params->output_interval = OutputInterval::Daily;
+  std::shared_ptr<HftList> hfts(create_hfts(2, *params));
+  {
+    // Cover both starvation mortality functions.
+    std::shared_ptr<Hft> hft(new Hft(*hfts->back()));
+    hft->mortality_factors.erase(MortalityFactor::StarvationIlliusOConnor2000);
+    hft->mortality_factors.insert(MortalityFactor::StarvationThreshold);
+    std::string msg;
+    REQUIRE(hft->is_valid(*params, msg));
+    hfts->back() = hft;
+  }
+  const int THREADS = 8;
+  const int DAYS = 2 * 365;
+
+  // Each World gets its own habitats; only the parameters are shared.
+  const auto simulate = [&](std::vector<Output::Datapoint>& output) {
+    World world(params, hfts);
+    // Some herbivores find food, others starve.
+    for (int i = 0; i < 2; i++) {
+      world.create_simulation_unit(
+          std::shared_ptr<Habitat>(new PastureHabitat()));
+      world.create_simulation_unit(
+          std::shared_ptr<Habitat>(new DummyHabitat("barren")));
+    }
+    for (int d = 0; d < DAYS; d++) world.simulate_day(Date(d % 365, d / 365));
+    output = world.retrieve_output();
+  };
+
+  std::vector<Output::Datapoint> reference;
+  simulate(reference);
+  REQUIRE(!reference.empty());
+
+  // Catch assertions are not thread-safe, so the threads only collect the
+  // results and exceptions.
+  std::vector<std::vector<Output::Datapoint> > results(THREADS);
+  std::vector<std::exception_ptr> errors(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; t++)
+    threads.emplace_back([&, t]() {
+      try {
+        simulate(results[t]);
+      } catch (...) {
+        errors[t] = std::current_exception();
+      }
+    });
+  for (auto& thread : threads) thread.join();
+
+  for (int t = 0; t < THREADS; t++) {
+    if (errors[t]) std::rethrow_exception(errors[t]);
+    REQUIRE(results[t].size() == reference.size());
+    for (std::size_t i = 0; i < reference.size(); i++) {
+      const Output::CombinedData& a = reference[i].data;
+      const Output::CombinedData& b = results[t][i].data;
+      CHECK(a.habitat_data.eaten_forage == b.habitat_data.eaten_forage);
+      REQUIRE(a.hft_data.size() == b.hft_data.size());
+      for (const auto& itr : a.hft_data) {
+        const Output::HerbivoreData& h = b.hft_data.at(itr.first);
+        CHECK(itr.second.massdens == h.massdens);
+        CHECK(itr.second.bodyfat == h.bodyfat);
+        CHECK(itr.second.mortality == h.mortality);
+      }
+    }
+  }
 }
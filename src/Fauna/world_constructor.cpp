@@ -14,6 +14,7 @@
 #include "forage_distribution_algorithms.h"
 #include "hft.h"
 #include "parameters.h"
+#include "static_simulate_day.h"
 
 using namespace Fauna;
 
@@ -32,6 +33,12 @@ DistributeForage* WorldConstructor::create_distribute_forage() const {
   };
 }
 
+SimulateDayFunction WorldConstructor::get_simulate_day() const {
+  if (get_params().herbivore_type == HerbivoreType::Cohort)
+    return &simulate_day_with<StaticSimulateDay<CohortPopulation> >;
+  return &simulate_day_with<SimulateDay>;
+}
+
 PopulationList* WorldConstructor::create_populations(
     const unsigned int habitat_ctr_in_agg_unit) const {
   PopulationList* plist = new PopulationList();
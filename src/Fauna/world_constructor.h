@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "population_list.h"
+#include "simulate_day.h"
 
 namespace Fauna {
 // Forward declarations
@@ -58,6 +59,17 @@ class WorldConstructor {
   /// Create new \ref DistributeForage object according to parameters.
   DistributeForage* create_distribute_forage() const;
 
+  /// Select the function to simulate one day in a simulation unit.
+  /**
+   * The herbivore type is fixed for the whole run, so the choice is made
+   * only once. For \ref HerbivoreType::Cohort this is
+   * \ref StaticSimulateDay with \ref CohortPopulation, which matches the
+   * populations of \ref create_populations(). Other herbivore types use
+   * \ref SimulateDay through the virtual interfaces.
+   * \see \ref sec_design_static_dispatch
+   */
+  SimulateDayFunction get_simulate_day() const;
+
   /// Get herbivore functional types.
   const HftList& get_hftlist() const { return hftlist; }
 
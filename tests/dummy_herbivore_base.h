@@ -14,6 +14,13 @@
 #include "parameters.h"
 
 namespace Fauna {
+/// Gross energy for dummy herbivores, which only keep a reference to it.
+inline const ForageEnergyContent& get_dummy_gross_energy() {
+  static const ForageEnergyContent gross_energy =
+      Parameters().forage_gross_energy;
+  return gross_energy;
+}
+
 /// Dummy class to test \ref HerbivoreBase
 class HerbivoreBaseDummy : public HerbivoreBase {
  public:
@@ -23,14 +30,14 @@ class HerbivoreBaseDummy : public HerbivoreBase {
   virtual void kill() {}
   /// Establishment Constructor
   HerbivoreBaseDummy(const int age_days, const double body_condition,
-                     std::shared_ptr<const Hft> hft, const Sex sex)
+                     const Hft& hft, const Sex sex)
       : HerbivoreBase(age_days, body_condition, hft, sex,
-                      Parameters().forage_gross_energy),
+                      get_dummy_gross_energy()),
         ind_per_km2(1.0) {}
 
   /// Birth Constructor
-  HerbivoreBaseDummy(std::shared_ptr<const Hft> hft, const Sex sex)
-      : HerbivoreBase(hft, sex, Parameters().forage_gross_energy),
+  HerbivoreBaseDummy(const Hft& hft, const Sex sex)
+      : HerbivoreBase(hft, sex, get_dummy_gross_energy()),
         ind_per_km2(1.0) {}
 
   HerbivoreBaseDummy(const HerbivoreBaseDummy& other)
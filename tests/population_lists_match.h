@@ -17,13 +17,22 @@
 using namespace Fauna;
 
 /// \brief Check if the lengths of the modifiable and the
-/// read-only population vectors match.
+/// read-only population vectors match, and whether the size and the
+/// iteration with `for_each()` agree with them.
 inline bool population_lists_match(PopulationInterface& pop) {
   // FIRST the read-only -> no chance for the population
   // object to change the list.
   ConstHerbivoreVector readonly = ((const PopulationInterface&)pop).get_list();
   HerbivoreVector modifiable = pop.get_list();
-  return modifiable.size() == readonly.size();
+  int readonly_count = 0, modifiable_count = 0;
+  ((const PopulationInterface&)pop)
+      .for_each([&](const HerbivoreInterface&) { readonly_count++; });
+  pop.for_each([&](HerbivoreInterface&) { modifiable_count++; });
+  return modifiable.size() == readonly.size() &&
+         readonly.size() == pop.size() &&
+         pop.empty() == readonly.empty() &&
+         (std::size_t)readonly_count == readonly.size() &&
+         (std::size_t)modifiable_count == readonly.size();
 }
 
 #endif  // TESTS_POPULATION_LISTS_MATCH_H
@@ -0,0 +1,386 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Measure the throughput of the megafauna model in synthetic worlds.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "insfile_reader.h"
+#include "megafauna.h"
+#include "parameters.h"
+#include "simple_habitat.h"
+
+using namespace Fauna;
+using namespace Fauna::Demo;
+
+#ifndef MEGAFAUNA_VERSION
+/// Library version, defined by CMake.
+#define MEGAFAUNA_VERSION "unknown"
+#endif
+
+namespace {
+/// Settings of one benchmark run, given on the command line.
+struct Options {
+  /// Path to the megafauna instruction file with the HFTs.
+  std::string insfile;
+  /// Total number of habitats (= simulation units).
+  int habitats = 16;
+  /// Number of aggregation units, among which the habitats are distributed.
+  int aggregation_units = 4;
+  /// Number of HFTs, or zero to take the HFTs from the instruction file.
+  int hfts = 0;
+  /// Number of simulation years.
+  int years = 10;
+  /// Output format: "memory" (discarded) or "text".
+  std::string output = "memory";
+  /// Output interval: "daily", "annual", or "decadal".
+  std::string interval = "annual";
+  /// Whether to write output in a background thread.
+  bool async = false;
+  /// Number of threads to simulate the habitats in.
+  int threads = 1;
+  /// Chunks of habitats per thread for the scheduler.
+  int chunks_per_thread = 4;
+  /// Directory for text table output.
+  std::string output_dir = "./";
+  /// Path to the JSON result file, or empty for STDOUT.
+  std::string json;
+};
+
+/// Print the command line syntax to STDERR.
+void print_usage() {
+  // We use C++11 raw string literals like a Bash Here Document.
+  std::cerr << R"EOF(
+Usage:
+  megafauna_benchmark [options] <fauna_instruction_file>
+
+Simulates a synthetic world of demo habitats with logistic grass growth and
+the HFTs from the instruction file. Throughput, peak memory, and run times of
+the simulation phases are written as JSON.
+
+Options:
+  --habitats <n>           Total number of habitats. (default: 16)
+  --aggregation-units <n>  Aggregation units to group habitats. (default: 4)
+  --hfts <n>               Number of HFTs. The HFTs of the instruction file
+                           are repeated under new names to reach the number.
+                           (default: as in instruction file)
+  --years <n>              Simulation years. (default: 10)
+  --output <memory|text>   Discard output in memory or write text tables.
+                           (default: memory)
+  --interval <daily|annual|decadal>
+                           Output interval. (default: annual)
+  --async                  Write output in a background thread.
+  --threads <n>            Simulate the habitats in this many threads.
+                           The phase times are summed over all threads.
+                           (default: 1)
+  --chunks-per-thread <n>  Chunks of habitats per thread for the
+                           work-stealing scheduler. (default: 4)
+  --output-dir <path>      Existing directory for text tables. (default: ./)
+  --json <path>            Write results to file instead of STDOUT.
+  --help                   Print this help text.
+)EOF";
+}
+
+/// Parse a positive integer from a command line argument.
+/**
+ * \throw std::invalid_argument If the string is not a positive integer.
+ */
+int parse_count(const std::string& option, const std::string& value) {
+  std::size_t pos = 0;
+  int result = 0;
+  try {
+    result = std::stoi(value, &pos);
+  } catch (const std::exception&) {
+    pos = 0;
+  }
+  if (pos != value.size() || result < 1)
+    throw std::invalid_argument("Option " + option +
+                                " expects a positive integer, not \"" + value +
+                                "\".");
+  return result;
+}
+
+/// Read the options from the command line.
+/**
+ * \throw std::invalid_argument If the command line is malformed.
+ */
+Options parse_options(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--async") {
+      options.async = true;
+      continue;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      if (!options.insfile.empty())
+        throw std::invalid_argument("Only one instruction file is allowed.");
+      options.insfile = arg;
+      continue;
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument("Option " + arg + " expects a value.");
+    const std::string value = argv[++i];
+    if (arg == "--habitats")
+      options.habitats = parse_count(arg, value);
+    else if (arg == "--aggregation-units")
+      options.aggregation_units = parse_count(arg, value);
+    else if (arg == "--hfts")
+      options.hfts = parse_count(arg, value);
+    else if (arg == "--years")
+      options.years = parse_count(arg, value);
+    else if (arg == "--threads")
+      options.threads = parse_count(arg, value);
+    else if (arg == "--chunks-per-thread")
+      options.chunks_per_thread = parse_count(arg, value);
+    else if (arg == "--output") {
+      if (value != "memory" && value != "text")
+        throw std::invalid_argument("Unknown output format: \"" + value +
+                                    "\"");
+      options.output = value;
+    } else if (arg == "--interval") {
+      if (value != "daily" && value != "annual" && value != "decadal")
+        throw std::invalid_argument("Unknown output interval: \"" + value +
+                                    "\"");
+      options.interval = value;
+    } else if (arg == "--output-dir")
+      options.output_dir = value;
+    else if (arg == "--json")
+      options.json = value;
+    else
+      throw std::invalid_argument("Unknown option: \"" + arg + "\"");
+  }
+  if (options.insfile.empty())
+    throw std::invalid_argument("No instruction file given.");
+  return options;
+}
+
+/// Habitat parameters as in `examples/demo_simulation.toml`.
+SimpleHabitat::Parameters get_habitat_parameters() {
+  SimpleHabitat::Parameters p;
+  p.air_temperature = {-2, 2, 7, 12, 18, 23, 26, 25, 20, 13, 6, 0};
+  p.grass.decay_monthly = {0.005};
+  p.grass.growth_monthly = {0.00, 0.00, 0.00, 0.03, 0.03, 0.03,
+                            0.03, 0.03, 0.03, 0.00, 0.00, 0.00};
+  p.grass.digestibility = {0.4, 0.4, 0.4, 0.7, 0.7, 0.7,
+                           0.7, 0.6, 0.5, 0.5, 0.4, 0.4};
+  p.grass.fpc = 0.8;
+  // Convert g/m² to kg/km².
+  p.grass.init_mass = 100 * 1000;
+  p.grass.saturation = 200 * 1000;
+  p.grass.reserve = 20 * 1000;
+  return p;
+}
+
+/// Repeat the HFTs under new names until there are `count` of them.
+std::shared_ptr<HftList> create_hfts(const HftList& original,
+                                     const int count) {
+  if (original.empty())
+    throw std::invalid_argument("The instruction file defines no HFTs.");
+  std::shared_ptr<HftList> result(new HftList);
+  for (int i = 0; i < count; i++) {
+    const Hft& base = *original[i % original.size()];
+    std::shared_ptr<Hft> hft(new Hft(base));
+    if (i >= (int)original.size())
+      hft->name = base.name + "_" + std::to_string(i / original.size());
+    result->push_back(hft);
+  }
+  return result;
+}
+
+/// Maximum resident set size of this process so far [KiB], or -1.
+long get_peak_rss_kib() {
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+  // macOS reports bytes instead of kilobytes.
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+#else
+  return -1;
+#endif
+}
+
+/// Escape a string for use as JSON string literal.
+std::string json_string(const std::string& s) {
+  std::string result = "\"";
+  for (const char c : s) {
+    if (c == '"' || c == '\\') result += '\\';
+    if (c == '\n')
+      result += "\\n";
+    else
+      result += c;
+  }
+  return result + '"';
+}
+
+/// Write the benchmark results as JSON object.
+void print_json(std::ostream& out, const Options& options, const int hfts,
+                const double setup_seconds, const double run_seconds,
+                const Profile& profile, const PoolStatistics& pool,
+                const MemoryUsage& memory,
+                const std::vector<ThreadStatistics>& threads) {
+  const double habitat_days = (double)profile.unit_days;
+  const double cohort_days = (double)profile.herbivore_days;
+  out << "{\n"
+      << "  \"version\": " << json_string(MEGAFAUNA_VERSION) << ",\n"
+      << "  \"scenario\": {\n"
+      << "    \"instruction_file\": " << json_string(options.insfile) << ",\n"
+      << "    \"habitats\": " << options.habitats << ",\n"
+      << "    \"aggregation_units\": " << options.aggregation_units << ",\n"
+      << "    \"hfts\": " << hfts << ",\n"
+      << "    \"years\": " << options.years << ",\n"
+      << "    \"output\": " << json_string(options.output) << ",\n"
+      << "    \"interval\": " << json_string(options.interval) << ",\n"
+      << "    \"async\": " << (options.async ? "true" : "false") << ",\n"
+      << "    \"threads\": " << options.threads << ",\n"
+      << "    \"chunks_per_thread\": " << options.chunks_per_thread << "\n"
+      << "  },\n"
+      << "  \"setup_seconds\": " << setup_seconds << ",\n"
+      << "  \"run_seconds\": " << run_seconds << ",\n"
+      << "  \"habitat_days\": " << profile.unit_days << ",\n"
+      << "  \"empty_habitat_days\": " << profile.empty_unit_days << ",\n"
+      << "  \"cohort_days\": " << profile.herbivore_days << ",\n"
+      << "  \"feeding_iterations\": " << profile.feeding_iterations << ",\n"
+      << "  \"habitat_days_per_second\": "
+      << (run_seconds > 0.0 ? habitat_days / run_seconds : 0.0) << ",\n"
+      << "  \"cohort_days_per_second\": "
+      << (run_seconds > 0.0 ? cohort_days / run_seconds : 0.0) << ",\n"
+      << "  \"peak_rss_kib\": " << get_peak_rss_kib() << ",\n"
+      << "  \"pool_bytes\": " << pool.bytes << ",\n"
+      << "  \"pool_reuses\": " << pool.reuses << ",\n"
+      << "  \"memory_bytes\": {\n"
+      << "    \"simulation_units\": " << memory.simulation_units << ",\n"
+      << "    \"populations\": " << memory.populations << ",\n"
+      << "    \"cohorts\": " << memory.cohorts << ",\n"
+      << "    \"output_buffers\": " << memory.output_buffers << ",\n"
+      << "    \"aggregator\": " << memory.aggregator << ",\n"
+      << "    \"total\": " << memory.get_total() << "\n"
+      << "  },\n"
+      << "  \"phases\": {";
+  for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    const ProfilePhase phase = static_cast<ProfilePhase>(i);
+    out << (i ? "," : "") << "\n    "
+        << json_string(get_profile_phase_name(phase))
+        << ": {\"seconds\": " << profile[phase].seconds
+        << ", \"calls\": " << profile[phase].calls << "}";
+  }
+  out << "\n  },\n"
+      << "  \"threads\": [";
+  for (std::size_t t = 0; t < threads.size(); t++) {
+    const ThreadStatistics& stats = threads[t];
+    out << (t ? "," : "") << "\n    {\"tasks\": " << stats.tasks
+        << ", \"chunks\": " << stats.chunks
+        << ", \"stolen_chunks\": " << stats.stolen_chunks
+        << ", \"stolen_tasks\": " << stats.stolen_tasks
+        << ", \"busy_seconds\": " << stats.busy_seconds
+        << ", \"idle_seconds\": " << stats.idle_seconds << "}";
+  }
+  out << (threads.empty() ? "]\n" : "\n  ]\n") << "}\n";
+}
+}  // namespace
+
+/// Run one benchmark scenario and print the results.
+int main(int argc, char* argv[]) {
+  if (argc == 2 && std::string(argv[1]) == "--help") {
+    print_usage();
+    return EXIT_SUCCESS;
+  }
+
+  Options options;
+  try {
+    options = parse_options(argc, argv);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  try {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point setup_start = Clock::now();
+
+    // Read parameters and HFTs from the instruction file and adjust them to
+    // the scenario.
+    const InsfileReader reader(options.insfile);
+    std::cerr << reader.get_warnings();
+    std::shared_ptr<Parameters> params(new Parameters(reader.get_params()));
+    params->output_async = options.async;
+    if (options.output == "memory")
+      params->output_format = OutputFormat::InMemory;
+    else
+      params->output_format = OutputFormat::TextTables;
+    if (options.interval == "daily")
+      params->output_interval = OutputInterval::Daily;
+    else if (options.interval == "annual")
+      params->output_interval = OutputInterval::Annual;
+    else
+      params->output_interval = OutputInterval::Decadal;
+    params->output_text_tables.directory = options.output_dir;
+
+    const int hft_count =
+        options.hfts > 0 ? options.hfts : reader.get_hfts().size();
+    World world(params, create_hfts(reader.get_hfts(), hft_count));
+    if (params->output_format == OutputFormat::InMemory)
+      world.set_output_callback([](const Output::Datapoint&) {});
+
+    const SimpleHabitat::Parameters habitat_params = get_habitat_parameters();
+    for (int h = 0; h < options.habitats; h++)
+      world.create_simulation_unit(std::shared_ptr<Habitat>(new SimpleHabitat(
+          habitat_params, std::to_string(h % options.aggregation_units))));
+
+    world.enable_profiling();
+    if (options.threads > 1)
+      world.enable_threads(options.threads, options.chunks_per_thread);
+    const Clock::time_point run_start = Clock::now();
+    for (int year = 0; year < options.years; year++)
+      for (int day = 0; day < 365; day++)
+        world.simulate_day(Date(day, year), true);
+    world.flush_output();
+    const Clock::time_point run_end = Clock::now();
+
+    const double setup_seconds =
+        std::chrono::duration<double>(run_start - setup_start).count();
+    const double run_seconds =
+        std::chrono::duration<double>(run_end - run_start).count();
+
+    std::vector<ThreadStatistics> thread_statistics;
+    if (options.threads > 1) thread_statistics = world.get_thread_statistics();
+
+    if (options.json.empty())
+      print_json(std::cout, options, hft_count, setup_seconds, run_seconds,
+                 world.get_profile(), world.get_pool_statistics(),
+                 world.get_memory_usage(), thread_statistics);
+    else {
+      std::ofstream file(options.json, std::ios::trunc);
+      print_json(file, options, hft_count, setup_seconds, run_seconds,
+                 world.get_profile(), world.get_pool_statistics(),
+                 world.get_memory_usage(), thread_statistics);
+      if (!file.good())
+        throw std::runtime_error("Could not write file \"" + options.json +
+                                 "\".");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Benchmark failed:\n" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
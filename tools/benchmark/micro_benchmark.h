@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Minimal timing harness for micro-benchmarks.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_MICRO_BENCHMARK_H
+#define FAUNA_MICRO_BENCHMARK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Fauna {
+namespace Benchmark {
+
+/// Keep the compiler from optimizing away the computation of a value.
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  const volatile char* volatile address =
+      reinterpret_cast<const volatile char*>(&value);
+  (void)address;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/// Measured run time of one kernel with one input size.
+struct Result {
+  /// Name of the kernel.
+  std::string name;
+  /// Number of items processed in one operation.
+  int size;
+  /// How often the operation was repeated in the final measurement.
+  long long iterations;
+  /// Average wall-clock time per operation [ns].
+  double ns_per_op;
+};
+
+/// Runs kernels repeatedly until the measurement is long enough.
+/**
+ * Each kernel is a function object that performs one operation. The harness
+ * calls it once to warm up caches, then doubles the number of calls until
+ * they take at least the minimum time. The last round is reported.
+ *
+ * Results are printed as a table row as soon as they are available.
+ */
+class Harness {
+ public:
+  /// Constructor.
+  /**
+   * \param out Stream for the result table, or NULL to print nothing.
+   * \param min_seconds Minimum duration of the final measurement.
+   * \param filter Only run kernels whose name contains this string.
+   */
+  Harness(std::ostream* out, const double min_seconds = 0.2,
+          const std::string& filter = "")
+      : out(out), min_seconds(min_seconds), filter(filter) {
+    if (out)
+      *out << std::left << std::setw(40) << "kernel" << std::right
+           << std::setw(8) << "size" << std::setw(14) << "ns/op"
+           << std::setw(12) << "ns/item" << std::setw(14) << "iterations"
+           << '\n';
+  }
+
+  /// Measure one kernel.
+  /**
+   * \param name Name of the kernel.
+   * \param size Number of items processed in one call of `function`.
+   * \param function Performs one operation. It should pass its result to
+   * \ref do_not_optimize().
+   */
+  template <class Function>
+  void run(const std::string& name, const int size, Function function) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+    typedef std::chrono::steady_clock Clock;
+
+    function();  // warm-up
+    long long iterations = 1;
+    double seconds = 0.0;
+    while (true) {
+      const Clock::time_point start = Clock::now();
+      for (long long i = 0; i < iterations; i++) function();
+      seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      if (seconds >= min_seconds) break;
+      // Aim a little above the minimum time, but grow at most 100-fold.
+      const double factor =
+          seconds > 0.0 ? 1.2 * min_seconds / seconds : 100.0;
+      iterations = (long long)(iterations *
+                               std::min(100.0, std::max(2.0, factor)));
+    }
+
+    const Result result = {name, size, iterations, seconds * 1e9 / iterations};
+    results.push_back(result);
+    if (out) {
+      const std::ios::fmtflags flags = out->flags();
+      *out << std::left << std::setw(40) << name << std::right << std::setw(8)
+           << size << std::fixed << std::setprecision(1) << std::setw(14)
+           << result.ns_per_op << std::setw(12) << result.ns_per_op / size
+           << std::setw(14) << iterations << std::endl;
+      out->flags(flags);
+    }
+  }
+
+  /// All measurements so far.
+  const std::vector<Result>& get_results() const { return results; }
+
+  /// Write all results as a JSON array.
+  void print_json(std::ostream& stream) const {
+    stream << "[";
+    for (std::size_t i = 0; i < results.size(); i++) {
+      const Result& r = results[i];
+      stream << (i ? "," : "") << "\n  {\"kernel\": \"" << r.name
+             << "\", \"size\": " << r.size << ", \"ns_per_op\": "
+             << r.ns_per_op << ", \"iterations\": " << r.iterations << "}";
+    }
+    stream << "\n]\n";
+  }
+
+ private:
+  std::ostream* const out;
+  const double min_seconds;
+  const std::string filter;
+  std::vector<Result> results;
+};
+}  // namespace Benchmark
+}  // namespace Fauna
+
+#endif  // FAUNA_MICRO_BENCHMARK_H
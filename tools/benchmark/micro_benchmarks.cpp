@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Micro-benchmarks of the hot kernels of the megafauna model.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "combined_data.h"
+#include "datapoint.h"
+#include "dummy_herbivore.h"
+#include "feed_herbivores.h"
+#include "fileystem.h"
+#include "forage_distribution_algorithms.h"
+#include "get_forage_demands.h"
+#include "habitat_forage.h"
+#include "herbivore_cohort.h"
+#include "herbivore_data.h"
+#include "hft.h"
+#include "micro_benchmark.h"
+#include "mortality_factors.h"
+#include "parameters.h"
+#include "text_table_writer.h"
+
+using namespace Fauna;
+using namespace Fauna::Benchmark;
+using namespace Fauna::Output;
+
+namespace {
+/// Input sizes for kernels that process a list of objects.
+const std::vector<int> SIZES = {1, 10, 100, 1000};
+
+/// Output directory for \ref TextTableWriter.
+const std::string OUTPUT_DIRECTORY = "micro_benchmark_output";
+
+/// Create a valid HFT with default parameters.
+std::shared_ptr<const Hft> create_hft(const std::string& name) {
+  std::shared_ptr<Hft> hft(new Hft());
+  hft->name = name;
+  std::string msg;
+  if (!hft->is_valid(Parameters(), msg))
+    throw std::logic_error("Default HFT is not valid:\n" + msg);
+  return hft;
+}
+
+/// Plenty of grass.
+HabitatForage create_available_forage(const double mass = 1e6) {
+  HabitatForage available;
+  available.grass.set_mass(mass);
+  available.grass.set_digestibility(0.6);
+  available.grass.set_fpc(0.5);
+  return available;
+}
+
+void bench_forage_values(Harness& harness) {
+  for (const int n : SIZES) {
+    const std::vector<ForageMass> a(n, ForageMass(2.0));
+    const std::vector<ForageMass> b(n, ForageMass(3.0));
+    const std::vector<ForageFraction> f(n, ForageFraction(0.5));
+    harness.run("ForageValues arithmetic", n, [&]() {
+      double sum = 0.0;
+      for (int i = 0; i < n; i++) {
+        ForageMass c = (a[i] + b[i]) * f[i];
+        c.min(b[i]);
+        sum += (c / 2.0).sum();
+      }
+      do_not_optimize(sum);
+    });
+  }
+}
+
+void bench_distribute_forage(Harness& harness) {
+  const Hft hft = *create_hft("hft");
+  const DistributeForageEqually distribute;
+  // Little forage so that it must be divided among the herbivores.
+  const HabitatForage available = create_available_forage(100.0);
+  for (const int n : SIZES) {
+    std::vector<DummyHerbivore> herbivores(n, DummyHerbivore(&hft, 1.0));
+    ForageDistribution demands;
+    for (auto& h : herbivores) demands.emplace_back(&h, ForageMass(10.0));
+    ForageDistribution portions;
+    // The algorithm overwrites the demands, so they are copied each time.
+    harness.run("DistributeForageEqually", n, [&]() {
+      portions = demands;
+      distribute(available, portions);
+      do_not_optimize(portions);
+    });
+  }
+}
+
+void bench_feed_herbivores(Harness& harness) {
+  const Hft hft = *create_hft("hft");
+  const FeedHerbivores feed(new DistributeForageEqually());
+  const HabitatForage pristine = create_available_forage(1000.0);
+  for (const int n : SIZES) {
+    std::vector<DummyHerbivore> herbivores(n, DummyHerbivore(&hft, 1.0));
+    HerbivoreVector pointers;
+    for (auto& h : herbivores) pointers.push_back(&h);
+    // The herbivores and the habitat are restored each time.
+    harness.run("FeedHerbivores::operator()", n, [&]() {
+      HabitatForage available = pristine;
+      for (auto& h : herbivores) h.set_demand(ForageMass(10.0));
+      feed(available, pointers);
+      do_not_optimize(available);
+    });
+  }
+}
+
+void bench_get_forage_demands(Harness& harness) {
+  const std::shared_ptr<const Hft> hft = create_hft("hft");
+  const HabitatForage available = create_available_forage();
+  const ForageEnergyContent energy_content(7.0);
+  GetForageDemands demands(hft.get(), Sex::Female);
+  int day = 0;
+  harness.run("GetForageDemands::init_today", 1, [&]() {
+    demands.init_today(day, available, energy_content, hft->body_mass_female);
+    day = (day + 1) % 365;
+  });
+  harness.run("GetForageDemands::operator()", 1, [&]() {
+    const ForageMass result = demands(50.0);
+    do_not_optimize(result);
+  });
+}
+
+void bench_simulate_day(Harness& harness) {
+  const std::shared_ptr<const Hft> hft = create_hft("hft");
+  // The herbivores only keep a reference to the gross energy.
+  const ForageEnergyContent gross_energy(19.0);
+  const HabitatEnvironment environment;
+  // The herbivores don’t eat, so they are replaced with fresh copies
+  // before they could starve to death.
+  const int RESET_INTERVAL = 30;
+  for (const int n : SIZES) {
+    const std::vector<HerbivoreCohort> pristine(
+        n, HerbivoreCohort(2 * 365, 1.0, *hft, Sex::Female, 1.0, gross_energy));
+    std::vector<HerbivoreCohort> cohorts(pristine);
+    int day = 0;
+    harness.run("HerbivoreBase::simulate_day", n, [&]() {
+      if (day % RESET_INTERVAL == 0) {
+        // Herbivore objects cannot be assigned, only copy-constructed.
+        cohorts.clear();
+        for (const auto& c : pristine) cohorts.push_back(c);
+      }
+      double offspring = 0.0;
+      for (auto& c : cohorts) c.simulate_day(day % 365, environment, offspring);
+      do_not_optimize(offspring);
+      day++;
+    });
+  }
+}
+
+void bench_starvation(Harness& harness) {
+  const GetStarvationIlliusOConnor2000 starvation;
+  std::vector<double> body_conditions;
+  for (int i = 0; i < 16; i++) body_conditions.push_back(0.05 + 0.06 * i);
+  harness.run("GetStarvationIlliusOConnor2000", body_conditions.size(), [&]() {
+    double sum = 0.0;
+    for (const double bc : body_conditions) {
+      double new_bc = bc;
+      sum += starvation(bc, new_bc) + new_bc;
+    }
+    do_not_optimize(sum);
+  });
+}
+
+/// Herbivore output with all fields and some mortality factors set.
+HerbivoreData create_herbivore_data() {
+  HerbivoreData data;
+  data.age_years = 3.0;
+  data.bodyfat = 0.2;
+  data.expenditure = 30.0;
+  data.inddens = 1.0;
+  data.massdens = 100.0;
+  data.mortality[MortalityFactor::Background] = 0.001;
+  data.mortality[MortalityFactor::StarvationIlliusOConnor2000] = 0.01;
+  data.offspring = 0.01;
+  data.eaten_forage_per_ind = ForageMass(5.0);
+  data.eaten_forage_per_mass = ForageMass(0.05);
+  data.energy_content = ForageEnergyContent(7.0);
+  data.energy_intake_per_ind = ForageEnergy(35.0);
+  data.energy_intake_per_mass = ForageEnergy(0.35);
+  return data;
+}
+
+void bench_herbivore_data_merge(Harness& harness) {
+  const HerbivoreData other = create_herbivore_data();
+  HerbivoreData data = other;
+  harness.run("HerbivoreData::merge", 1, [&]() {
+    data.merge(other, 1.0, 1.0);
+    do_not_optimize(data);
+  });
+}
+
+/// Habitat and herbivore output of one day with the given number of HFTs.
+CombinedData create_combined_data(const int hft_count) {
+  CombinedData data;
+  data.datapoint_count = 1;
+  data.habitat_data.available_forage = create_available_forage();
+  for (int i = 0; i < hft_count; i++)
+    data.hft_data["hft" + std::to_string(i)] = create_herbivore_data();
+  return data;
+}
+
+void bench_combined_data_merge(Harness& harness) {
+  for (const int n : SIZES) {
+    const CombinedData other = create_combined_data(n);
+    CombinedData data = other;
+    // The datapoint count grows with each merge, which doesn’t change the
+    // amount of work.
+    harness.run("CombinedData::merge", n, [&]() {
+      data.merge(other);
+      do_not_optimize(data);
+    });
+  }
+}
+
+void bench_write_datapoint(Harness& harness) {
+  for (const int n : SIZES) {
+    if (directory_exists(OUTPUT_DIRECTORY)) remove_directory(OUTPUT_DIRECTORY);
+    Datapoint datapoint;
+    datapoint.aggregation_unit = "unit";
+    datapoint.interval = DateInterval(Date(0, 0), Date(364, 0));
+    datapoint.data = create_combined_data(n);
+    std::set<std::string> hft_names;
+    for (const auto& itr : datapoint.data.hft_data) hft_names.insert(itr.first);
+
+    TextTableWriterOptions options;
+    options.directory = OUTPUT_DIRECTORY;
+    options.available_forage = true;
+    options.body_fat = true;
+    options.digestibility = true;
+    options.eaten_forage_per_ind = true;
+    options.individual_density = true;
+    options.mass_density = true;
+    {
+      TextTableWriter writer(OutputInterval::Annual, options, hft_names);
+      harness.run("TextTableWriter::write_datapoint", n,
+                  [&]() { writer.write_datapoint(datapoint); });
+    }
+    remove_directory(OUTPUT_DIRECTORY);
+  }
+}
+
+/// Print the command line syntax to STDERR.
+void print_usage() {
+  // We use C++11 raw string literals like a Bash Here Document.
+  std::cerr << R"EOF(
+Usage:
+  megafauna_micro_benchmarks [options]
+
+Measures the run time of individual kernels of the megafauna model in
+nanoseconds per operation. One operation processes `size` items.
+
+Options:
+  --filter <text>   Only run kernels whose name contains the text.
+  --min-time <s>    Minimum measurement time per kernel. (default: 0.2)
+  --json <path>     Additionally write the results as JSON.
+  --help            Print this help text.
+)EOF";
+}
+}  // namespace
+
+/// Run all micro-benchmarks and print a table of the results.
+int main(int argc, char* argv[]) {
+  std::string filter;
+  std::string json;
+  double min_seconds = 0.2;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help") {
+      print_usage();
+      return EXIT_SUCCESS;
+    }
+    if (i + 1 >= argc) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+    const std::string value = argv[++i];
+    if (arg == "--filter")
+      filter = value;
+    else if (arg == "--json")
+      json = value;
+    else if (arg == "--min-time")
+      min_seconds = std::atof(value.c_str());
+    else {
+      std::cerr << "Unknown option: \"" << arg << "\"" << std::endl;
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    Harness harness(&std::cout, min_seconds, filter);
+    bench_forage_values(harness);
+    bench_distribute_forage(harness);
+    bench_feed_herbivores(harness);
+    bench_get_forage_demands(harness);
+    bench_simulate_day(harness);
+    bench_starvation(harness);
+    bench_herbivore_data_merge(harness);
+    bench_combined_data_merge(harness);
+    bench_write_datapoint(harness);
+
+    if (!json.empty()) {
+      std::ofstream file(json, std::ios::trunc);
+      harness.print_json(file);
+      if (!file.good())
+        throw std::runtime_error("Could not write file \"" + json + "\".");
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Micro-benchmark failed:\n" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Parameters of the demo simulation framework.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "demo_parameters.h"
+
+#include "cpptoml.h"
+
+using namespace Fauna;
+using namespace Fauna::Demo;
+
+namespace {
+/// Convert g/m² to kg/km².
+double g_m2_to_kg_km2(const double g_m2) { return g_m2 * 1000; }
+}  // namespace
+
+DemoParameters Demo::read_demo_parameters(const std::string& filename) {
+  const auto ins = cpptoml::parse_file(filename);
+  DemoParameters params;
+
+  {
+    const std::string key = "general.years";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.nyears = *value;
+      if (params.nyears < 1)
+        throw std::runtime_error(key + " must be greater than 1.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "general.habitat_groups";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.ngroups = *value;
+      if (params.ngroups < 1)
+        throw std::runtime_error(key + " must be greater than 1.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "general.habitats_per_group";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.nhabitats_per_group = *value;
+      if (params.nhabitats_per_group < 1)
+        throw std::runtime_error(key + " must be greater than 1.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "environment.air_temperature";
+    const auto value = ins->get_qualified_array_of<double>(key);
+    if (value) {
+      params.habitat.air_temperature = *value;
+      for (const auto& i : params.habitat.air_temperature)
+        if (i <= -273)
+          throw std::runtime_error(key +
+                                   " must be greater than -273 °C (= 0 K).");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.daily_decay_rate";
+    const auto value = ins->get_qualified_array_of<double>(key);
+    if (value) {
+      params.habitat.grass.decay_monthly = *value;
+      for (const auto& i : params.habitat.grass.decay_monthly) {
+        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
+        if (i > 1) throw std::runtime_error(key + " must be smaller than 1.");
+      }
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.daily_growth_rate";
+    const auto value = ins->get_qualified_array_of<double>(key);
+    if (value) {
+      params.habitat.grass.growth_monthly = *value;
+      for (const auto& i : params.habitat.grass.growth_monthly) {
+        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
+        if (i > 1) throw std::runtime_error(key + " must smaller than 1.");
+      }
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.digestibility";
+    const auto value = ins->get_qualified_array_of<double>(key);
+    if (value) {
+      params.habitat.grass.digestibility = *value;
+      for (const auto& i : params.habitat.grass.digestibility) {
+        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
+        if (i > 1) throw std::runtime_error(key + " must smaller than 1.");
+      }
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.fpc";
+    const auto value = ins->get_qualified_as<double>(key);
+    if (value) {
+      params.habitat.grass.fpc = *value;
+      if (params.habitat.grass.fpc <= 0.0 || params.habitat.grass.fpc > 1.0)
+        throw std::runtime_error(key + " must be between 0 and 1.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.initial_mass";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.habitat.grass.init_mass = g_m2_to_kg_km2(*value);
+      if (params.habitat.grass.init_mass <= 0)
+        throw std::runtime_error(key + " must be greater than 0.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.saturation_mass";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.habitat.grass.saturation = g_m2_to_kg_km2(*value);
+      if (params.habitat.grass.saturation < params.habitat.grass.init_mass)
+        throw std::runtime_error(key +
+                                 " must be greater than grass.initial_mass.");
+    } else
+      throw missing_parameter(key);
+  }
+  {
+    const std::string key = "grass.ungrazeable_reserve";
+    const auto value = ins->get_qualified_as<int>(key);
+    if (value) {
+      params.habitat.grass.reserve = g_m2_to_kg_km2(*value);
+      if (params.habitat.grass.reserve >= params.habitat.grass.saturation)
+        throw std::runtime_error(
+            key + " must be smaller than grass.saturation_mass.");
+    } else
+      throw missing_parameter(key);
+  }
+  return params;
+}
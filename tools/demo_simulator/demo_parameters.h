@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Parameters of the demo simulation framework.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_DEMO_PARAMETERS_H
+#define FAUNA_DEMO_PARAMETERS_H
+
+#include <stdexcept>
+#include <string>
+
+#include "simple_habitat.h"
+
+namespace Fauna {
+namespace Demo {
+
+/// Exception that a parameter is missing in the instruction file.
+struct missing_parameter : public std::runtime_error {
+  /// Constructor for missing global parameter.
+  /**
+   * \param key The fully qualified TOML key.
+   */
+  missing_parameter(const std::string& key)
+      : runtime_error("Missing mandatory parameter: \"" + key + '"'){};
+};
+
+/// Parameter values from the demo simulation instruction file.
+/** The initialization values are just arbitrary. */
+struct DemoParameters {
+  /// Number of simulation years.
+  int nyears = 100;
+  /// Number of habitats in each aggregation unit.
+  int nhabitats_per_group = 4;
+  /// Number of aggregation units.
+  int ngroups = 3;
+  /// Settings for each \ref SimpleHabitat.
+  SimpleHabitat::Parameters habitat;
+};
+
+/// Read the TOML instruction file for the demo simulator.
+/**
+ * \param filename Path to the instruction file.
+ * \throw missing_parameter If a mandatory parameter is missing.
+ * \throw std::runtime_error If a parameter has an invalid value or if the
+ * file cannot be parsed.
+ */
+DemoParameters read_demo_parameters(const std::string& filename);
+}  // namespace Demo
+}  // namespace Fauna
+
+#endif  // FAUNA_DEMO_PARAMETERS_H
@@ -15,17 +15,11 @@
 #include <climits>
 #include <iostream>
 
-#include "cpptoml.h"
 #include "megafauna.h"
 
 using namespace Fauna;
 using namespace Fauna::Demo;
 
-namespace {
-/// Convert g/m² to kg/km².
-double g_m2_to_kg_km2(const double g_m2) { return g_m2 * 1000; }
-}  // namespace
-
 /// Run the demo simulation with parameters read from instruction file
 int main(int argc, char* argv[]) {
   std::string insfile_fauna;
@@ -34,23 +28,36 @@ int main(int argc, char* argv[]) {
     // The singleton instance for managing the whole simulation.
     Framework& framework = Framework::get_instance();
 
+    const std::string option = argc > 1 ? argv[1] : "";
     if (argc == 2) {
-      if (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-help") {
+      if (option == "--help" || option == "-help") {
         framework.print_help();
         return EXIT_SUCCESS;
       } else {
         framework.print_usage();
         return EXIT_FAILURE;
       }
-    } else if (argc == 3) {
+    } else if (argc == 3 || (argc == 5 && option == "--record")) {
       std::cerr << "This is the demo simulator for the Modular Megafauna Model."
                 << std::endl;
       // Read ins file from command line parameters.
       // We expect two arguments: the two instruction files.
-      insfile_fauna = argv[1];
-      insfile_demo = argv[2];
+      const int first = (argc == 5) ? 3 : 1;
+      insfile_fauna = argv[first];
+      insfile_demo = argv[first + 1];
+      const std::string trace_file = (argc == 5) ? argv[2] : "";
       // Run the simulation with the global parameters
-      const bool success = framework.run(insfile_fauna, insfile_demo);
+      const bool success =
+          framework.run(insfile_fauna, insfile_demo, trace_file);
+      if (!success) {
+        std::cerr << "Exiting simulation." << std::endl;
+        return EXIT_FAILURE;
+      }
+    } else if (argc == 4 && option == "--replay") {
+      std::cerr << "This is the demo simulator for the Modular Megafauna Model."
+                << std::endl;
+      insfile_fauna = argv[3];
+      const bool success = framework.replay(insfile_fauna, argv[2]);
       if (!success) {
         std::cerr << "Exiting simulation." << std::endl;
         return EXIT_FAILURE;
@@ -79,6 +86,12 @@ to simulate ecosystems, but to demonstrate how to integrate the megafauna
 library in a vegetation model. Moreover, it serves as a testing framework
 to run the megafauna model with as little overhead as possible and in a
 controlled environment.
+
+With `--record`, the daily forage and environment of all habitats are written
+to a binary trace file. With `--replay`, the simulation is repeated from such
+a trace file without the vegetation model. This also works with a trace that
+was recorded by another host program. The demo simulation instruction file
+is not needed for replay.
 )EOF";
 }
 
@@ -87,137 +100,16 @@ void Framework::print_usage() {
   std::cerr << R"EOF(
 Usage:
   megafauna_demo_simulator <fauna_instruction_file> <simulation_instruction_file>
+  megafauna_demo_simulator --record <trace_file> <fauna_instruction_file>
+                           <simulation_instruction_file>
+  megafauna_demo_simulator --replay <trace_file> <fauna_instruction_file>
   megafauna_demo_simulator --help
 )EOF";
 }
 
-void Framework::read_instruction_file(const std::string filename) {
-  const auto ins = cpptoml::parse_file(filename);
-
-  {
-    const std::string key = "general.years";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.nyears = *value;
-      if (params.nyears < 1)
-        throw std::runtime_error(key + " must be greater than 1.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "general.habitat_groups";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.ngroups = *value;
-      if (params.ngroups < 1)
-        throw std::runtime_error(key + " must be greater than 1.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "general.habitats_per_group";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.nhabitats_per_group = *value;
-      if (params.nhabitats_per_group < 1)
-        throw std::runtime_error(key + " must be greater than 1.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "environment.air_temperature";
-    const auto value = ins->get_qualified_array_of<double>(key);
-    if (value) {
-      params.habitat.air_temperature = *value;
-      for (const auto& i : params.habitat.air_temperature)
-        if (i <= -273)
-          throw std::runtime_error(key +
-                                   " must be greater than -273 °C (= 0 K).");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.daily_decay_rate";
-    const auto value = ins->get_qualified_array_of<double>(key);
-    if (value) {
-      params.habitat.grass.decay_monthly = *value;
-      for (const auto& i : params.habitat.grass.decay_monthly) {
-        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
-        if (i > 1) throw std::runtime_error(key + " must be smaller than 1.");
-      }
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.daily_growth_rate";
-    const auto value = ins->get_qualified_array_of<double>(key);
-    if (value) {
-      params.habitat.grass.growth_monthly = *value;
-      for (const auto& i : params.habitat.grass.growth_monthly) {
-        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
-        if (i > 1) throw std::runtime_error(key + " must smaller than 1.");
-      }
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.digestibility";
-    const auto value = ins->get_qualified_array_of<double>(key);
-    if (value) {
-      params.habitat.grass.digestibility = *value;
-      for (const auto& i : params.habitat.grass.digestibility) {
-        if (i < 0) throw std::runtime_error(key + " must be greater than 0.");
-        if (i > 1) throw std::runtime_error(key + " must smaller than 1.");
-      }
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.fpc";
-    const auto value = ins->get_qualified_as<double>(key);
-    if (value) {
-      params.habitat.grass.fpc = *value;
-      if (params.habitat.grass.fpc <= 0.0 || params.habitat.grass.fpc > 1.0)
-        throw std::runtime_error(key + " must be between 0 and 1.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.initial_mass";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.habitat.grass.init_mass = g_m2_to_kg_km2(*value);
-      if (params.habitat.grass.init_mass <= 0)
-        throw std::runtime_error(key + " must be greater than 0.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.saturation_mass";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.habitat.grass.saturation = g_m2_to_kg_km2(*value);
-      if (params.habitat.grass.saturation < params.habitat.grass.init_mass)
-        throw std::runtime_error(key +
-                                 " must be greater than grass.initial_mass.");
-    } else
-      throw missing_parameter(key);
-  }
-  {
-    const std::string key = "grass.ungrazeable_reserve";
-    const auto value = ins->get_qualified_as<int>(key);
-    if (value) {
-      params.habitat.grass.reserve = g_m2_to_kg_km2(*value);
-      if (params.habitat.grass.reserve >= params.habitat.grass.saturation)
-        throw std::runtime_error(
-            key + " must be smaller than grass.saturation_mass.");
-    } else
-      throw missing_parameter(key);
-  }
-}
-
 bool Framework::run(const std::string insfile_fauna,
-                    const std::string insfile_demo) {
+                    const std::string insfile_demo,
+                    const std::string trace_file) {
   std::unique_ptr<Fauna::World> fauna_world;
 
   try {
@@ -227,15 +119,26 @@ bool Framework::run(const std::string insfile_fauna,
               << e.what() << std::endl;
     return false;
   }
+  std::cerr << fauna_world->get_warnings();
 
   try {
-    read_instruction_file(insfile_demo);
+    params = read_demo_parameters(insfile_demo);
   } catch (const std::runtime_error& e) {
     std::cerr << "Bad instruction file: \"" << insfile_demo << "\"\n"
               << e.what() << std::endl;
     return false;
   }
 
+  std::shared_ptr<ForcingRecorder> recorder;
+  if (!trace_file.empty()) {
+    try {
+      recorder.reset(new ForcingRecorder(trace_file));
+    } catch (const std::runtime_error& e) {
+      std::cerr << e.what() << std::endl;
+      return false;
+    }
+  }
+
   // Container for all the groups, each being a vector of
   // simulation units.
   for (int g = 0; g < params.ngroups; g++) {
@@ -245,8 +148,10 @@ bool Framework::run(const std::string insfile_fauna,
       try {
         // We only pass the pointer to the new habitat to the megafauna
         // library, so special care is needed that it will stay valid.
-        fauna_world->create_simulation_unit(std::shared_ptr<Habitat>(
-            new SimpleHabitat(params.habitat, aggregation_unit)));
+        std::shared_ptr<Habitat> habitat(
+            new SimpleHabitat(params.habitat, aggregation_unit));
+        if (recorder) habitat.reset(new RecordingHabitat(habitat, recorder));
+        fauna_world->create_simulation_unit(habitat);
       } catch (const std::exception& e) {
         std::cerr << "Exception during habitat creation:" << std::endl
                   << "group number " << g << " of " << params.ngroups << '\n'
@@ -263,27 +168,83 @@ bool Framework::run(const std::string insfile_fauna,
   std::cerr << "Starting simulation." << std::endl;
 
   for (int year = 0; year < params.nyears; year++) {
-    for (int day_of_year = 0; day_of_year < 365; day_of_year++) {
-      // PRINT PROGRESS
-      std::cerr << "\r\e[2K"  // clear line
-                << "Year: " << year + 1 << "/" << params.nyears
-                << " Day: " << day_of_year + 1 << std::flush;
-
-      // VEGATATION AND HERBIVORE SIMULATION
-      const bool do_herbivores = true;
-      const Date date(day_of_year, year);
-      try {
-        // The Fauna::World class will take care to iterate over all habitat
-        // groups.
-        fauna_world->simulate_day(date, do_herbivores);
-      } catch (const std::exception& e) {
-        std::cerr << "\n"  // Linebreak after simulation day counter.
-                  << "Exception during herbivore simulation:\n"
-                  << e.what() << std::endl;
-        return false;
-      }
-    }  // day loop: end of year
-  }    // year loop
+    // PRINT PROGRESS
+    std::cerr << "\r\e[2K"  // clear line
+              << "Year: " << year + 1 << "/" << params.nyears << std::flush;
+
+    // VEGATATION AND HERBIVORE SIMULATION
+    try {
+      // The habitats grow their grass by themselves. So the Fauna::World
+      // class can simulate the whole year in one call, iterating over all
+      // habitat groups.
+      fauna_world->simulate_days(Date(0, year), Date(364, year));
+    } catch (const std::exception& e) {
+      std::cerr << "\n"  // Linebreak after simulation year counter.
+                << "Exception during herbivore simulation:\n"
+                << e.what() << std::endl;
+      return false;
+    }
+  }  // year loop
   std::cerr << std::endl;
+  if (recorder) {
+    try {
+      recorder->flush();
+    } catch (const std::runtime_error& e) {
+      std::cerr << e.what() << std::endl;
+      return false;
+    }
+  }
   return true;  // success!
 }
+
+bool Framework::replay(const std::string insfile_fauna,
+                       const std::string trace_file) {
+  std::unique_ptr<Fauna::World> fauna_world;
+  std::shared_ptr<ForcingPlayer> player;
+  std::vector<std::shared_ptr<ReplayHabitat>> habitats;
+
+  try {
+    fauna_world.reset(new Fauna::World(insfile_fauna));
+    std::cerr << fauna_world->get_warnings();
+    player.reset(new ForcingPlayer(trace_file));
+    for (int i = 0; i < player->get_habitat_count(); i++) {
+      habitats.emplace_back(new ReplayHabitat(player, i));
+      fauna_world->create_simulation_unit(habitats.back());
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "An exception ocurred while preparing the replay.\n"
+              << e.what() << std::endl;
+    return false;
+  }
+
+  std::cerr << "Replaying " << player->get_habitat_count()
+            << " habitats from \"" << trace_file << "\"." << std::endl;
+
+  // The simulation ends when all recorded days have been replayed.
+  for (int i = 0;; i++) {
+    bool finished = true;
+    for (auto& habitat : habitats) {
+      // A habitat without further records has been killed by the host.
+      if (habitat->is_exhausted())
+        habitat->kill();
+      else
+        finished = false;
+    }
+    if (finished) break;
+
+    const Date date(i % 365, i / 365);
+    std::cerr << "\r\e[2K"  // clear line
+              << "Year: " << date.get_year() + 1
+              << " Day: " << date.get_julian_day() + 1 << std::flush;
+    try {
+      fauna_world->simulate_day(date, true);
+    } catch (const std::exception& e) {
+      std::cerr << "\n"  // Linebreak after simulation day counter.
+                << "Exception during herbivore simulation:\n"
+                << e.what() << std::endl;
+      return false;
+    }
+  }
+  std::cerr << std::endl;
+  return true;
+}
@@ -13,21 +13,11 @@
 
 #include <vector>
 
-#include "simple_habitat.h"
+#include "demo_parameters.h"
 
 namespace Fauna {
 namespace Demo {
 
-/// Exception that a parameter is missing in the instruction file.
-struct missing_parameter : public std::runtime_error {
-  /// Constructor for missing global parameter.
-  /**
-   * \param key The fully qualified TOML key.
-   */
-  missing_parameter(const std::string& key)
-      : runtime_error("Missing mandatory parameter: \"" + key + '"'){};
-};
-
 /// Performs demo simulations for the Modular Megafauna Model.
 /**
  * \see \ref sec_singleton for an explanation of the design pattern used.
@@ -56,23 +46,26 @@ class Framework {
    * At all critical points, exceptions are caught.
    * \param insfile_fauna Path to the instruction file for the megafauna model.
    * \param insfile_demo Instruction file for the demo simulator framework.
+   * \param trace_file If not empty, record the habitat forcing in this file
+   * with \ref Fauna::RecordingHabitat.
    * \return true on success, false on failure
    */
-  bool run(const std::string insfile_fauna, const std::string insfile_demo);
+  bool run(const std::string insfile_fauna, const std::string insfile_demo,
+           const std::string trace_file = "");
 
- private:
-  /// Set \ref params from given TOML instruction file for the demo simulator.
-  void read_instruction_file(const std::string filename);
+  /// Repeat a simulation from a recorded forcing trace.
+  /**
+   * The habitats are \ref Fauna::ReplayHabitat objects. The simulation runs
+   * until all recorded days have been replayed.
+   * \param insfile_fauna Path to the instruction file for the megafauna model.
+   * \param trace_file Path to a file written by \ref Fauna::ForcingRecorder.
+   * \return true on success, false on failure
+   */
+  bool replay(const std::string insfile_fauna, const std::string trace_file);
 
+ private:
   /// Parameter values from instruction file
-  /** The initialization values are just arbitrary. */
-  struct {
-    std::string outputdirectory = "./";
-    int nyears = 100;
-    int nhabitats_per_group = 4;
-    int ngroups = 3;
-    SimpleHabitat::Parameters habitat;
-  } params;
+  DemoParameters params;
 
   /// List of mandatory instruction file parameters.
   std::vector<std::string> mandatory_parameters;
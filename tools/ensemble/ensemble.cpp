@@ -0,0 +1,288 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Run many megafauna instruction files with the same forcing.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "demo_parameters.h"
+#include "insfile_reader.h"
+#include "megafauna.h"
+#include "parameters.h"
+#include "simple_habitat.h"
+
+using namespace Fauna;
+using namespace Fauna::Demo;
+
+namespace {
+/// Settings given on the command line.
+struct Options {
+  /// Parent directory of the output directories of all members.
+  std::string output_directory;
+  /// Megafauna instruction files, one for each ensemble member.
+  std::vector<std::string> insfiles;
+  /// Demo simulation instruction file for simulated forcing.
+  std::string demo_insfile;
+  /// Forcing trace for replayed forcing.
+  std::string trace_file;
+  /// Number of members to simulate in parallel.
+  int threads = 0;
+};
+
+/// Read-only inputs that all ensemble members share.
+struct SharedForcing {
+  /// Parameters for \ref SimpleHabitat if the forcing is simulated.
+  std::unique_ptr<const DemoParameters> demo;
+  /// Recorded habitat forcing if the forcing is replayed.
+  std::shared_ptr<const ForcingTrace> trace;
+};
+
+/// One megafauna instruction file in the ensemble.
+struct Member {
+  /// Path to the megafauna instruction file.
+  std::string insfile;
+  /// Unique name, which is also the name of the output directory.
+  std::string name;
+  /// Whether the simulation finished without error.
+  bool success = false;
+  /// Warnings from the instruction file and error messages.
+  std::string messages;
+  /// Wall-clock time of the simulation [s].
+  double seconds = 0.0;
+};
+
+/// Print the command line syntax to STDERR.
+void print_usage() {
+  // We use C++11 raw string literals like a Bash Here Document.
+  std::cerr << R"EOF(
+Usage:
+  megafauna_ensemble [options] (--demo <simulation_instruction_file> |
+                     --trace <trace_file>) <output_directory>
+                     <fauna_instruction_file>...
+
+Runs one megafauna simulation for each fauna instruction file in parallel.
+All members share the same habitat forcing: either the logistic grass model
+of the demo simulator with parameters from the simulation instruction file,
+or a trace recorded with `megafauna_demo_simulator --record`, which is read
+into memory only once.
+
+The output of each member is written to a subdirectory of the output
+directory. It is named after the instruction file without its extension.
+
+Options:
+  --demo <file>      Simulate the forcing like the demo simulator.
+  --trace <file>     Replay the forcing from a trace file.
+  --threads <n>      Number of members to simulate in parallel.
+                     (default: number of CPU cores)
+  --help             Print this help text.
+)EOF";
+}
+
+/// File name without directory and extension.
+std::string get_stem(const std::string& path) {
+  const std::size_t slash = path.find_last_of("/\\");
+  std::string name =
+      (slash == std::string::npos) ? path : path.substr(slash + 1);
+  const std::size_t dot = name.find_last_of('.');
+  if (dot != std::string::npos && dot > 0) name.erase(dot);
+  return name;
+}
+
+/// Read the options from the command line.
+/**
+ * \return false if the program should exit successfully.
+ * \throw std::invalid_argument If the command line is malformed.
+ */
+bool parse_options(int argc, char* argv[], Options& options) {
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help") {
+      print_usage();
+      return false;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      files.push_back(arg);
+      continue;
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument("Option " + arg + " expects a value.");
+    const std::string value = argv[++i];
+    if (arg == "--demo")
+      options.demo_insfile = value;
+    else if (arg == "--trace")
+      options.trace_file = value;
+    else if (arg == "--threads") {
+      std::size_t pos = 0;
+      try {
+        options.threads = std::stoi(value, &pos);
+      } catch (const std::exception&) {
+        pos = 0;
+      }
+      if (pos != value.size() || options.threads < 1)
+        throw std::invalid_argument(
+            "Option --threads expects a positive integer, not \"" + value +
+            "\".");
+    } else
+      throw std::invalid_argument("Unknown option: \"" + arg + "\"");
+  }
+  if (options.demo_insfile.empty() == options.trace_file.empty())
+    throw std::invalid_argument("Expected either --demo or --trace.");
+  if (files.size() < 2)
+    throw std::invalid_argument(
+        "Expected an output directory and at least one instruction file.");
+  options.output_directory = files.front();
+  options.insfiles.assign(files.begin() + 1, files.end());
+  if (options.threads == 0)
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+  return true;
+}
+
+/// Simulate one ensemble member.
+/**
+ * \throw std::exception If the instruction file is invalid or the
+ * simulation fails.
+ */
+void simulate(const std::string& output_directory,
+              const SharedForcing& forcing, Member& member) {
+  const InsfileReader reader(member.insfile);
+  member.messages += reader.get_warnings();
+  std::shared_ptr<Parameters> params(new Parameters(reader.get_params()));
+  params->output_text_tables.directory =
+      output_directory + "/" + member.name;
+  const std::shared_ptr<const HftList> hfts(new HftList(reader.get_hfts()));
+  World world(params, hfts);
+
+  if (forcing.demo) {
+    const DemoParameters& demo = *forcing.demo;
+    for (int g = 0; g < demo.ngroups; g++)
+      for (int h = 0; h < demo.nhabitats_per_group; h++)
+        world.create_simulation_unit(std::shared_ptr<Habitat>(
+            new SimpleHabitat(demo.habitat, std::to_string(g))));
+    for (int year = 0; year < demo.nyears; year++)
+      for (int day_of_year = 0; day_of_year < 365; day_of_year++)
+        world.simulate_day(Date(day_of_year, year), true);
+  } else {
+    std::vector<std::shared_ptr<ReplayHabitat>> habitats;
+    for (int i = 0; i < forcing.trace->get_habitat_count(); i++) {
+      habitats.emplace_back(new ReplayHabitat(forcing.trace, i));
+      world.create_simulation_unit(habitats.back());
+    }
+    // The simulation ends when all recorded days have been replayed.
+    for (int i = 0;; i++) {
+      bool finished = true;
+      for (auto& habitat : habitats) {
+        // A habitat without further records has been killed by the host.
+        if (habitat->is_exhausted())
+          habitat->kill();
+        else
+          finished = false;
+      }
+      if (finished) break;
+      world.simulate_day(Date(i % 365, i / 365), true);
+    }
+  }
+  world.flush_output();
+}
+}  // namespace
+
+/// Run all ensemble members on a pool of worker threads.
+int main(int argc, char* argv[]) {
+  Options options;
+  try {
+    if (!parse_options(argc, argv, options)) return EXIT_SUCCESS;
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Member> members(options.insfiles.size());
+  std::set<std::string> names;
+  for (std::size_t i = 0; i < members.size(); i++) {
+    members[i].insfile = options.insfiles[i];
+    members[i].name = get_stem(options.insfiles[i]);
+    if (!names.insert(members[i].name).second) {
+      std::cerr << "Two instruction files would write to the same output "
+                   "directory: \""
+                << members[i].name << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Prepare the forcing only once for all members.
+  SharedForcing forcing;
+  try {
+    if (!options.demo_insfile.empty()) {
+      forcing.demo.reset(
+          new DemoParameters(read_demo_parameters(options.demo_insfile)));
+    } else {
+      ForcingPlayer player(options.trace_file);
+      forcing.trace.reset(new ForcingTrace(player));
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Could not prepare the forcing:\n" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const int thread_count = std::min<int>(options.threads, members.size());
+  std::cerr << "Simulating " << members.size() << " ensemble members in "
+            << thread_count << " threads." << std::endl;
+
+  // Each worker takes the next member that nobody has started yet.
+  std::atomic<int> next_member(0);
+  std::mutex print_mutex;
+  int finished_count = 0;
+  const auto worker = [&]() {
+    for (int i = next_member++; i < (int)members.size(); i = next_member++) {
+      Member& member = members[i];
+      const auto start = std::chrono::steady_clock::now();
+      try {
+        simulate(options.output_directory, forcing, member);
+        member.success = true;
+      } catch (const std::exception& e) {
+        member.messages += e.what();
+        member.messages += '\n';
+      }
+      member.seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+      std::lock_guard<std::mutex> lock(print_mutex);
+      std::cerr << "[" << ++finished_count << "/" << members.size() << "] "
+                << (member.success ? "Finished " : "FAILED ") << member.name
+                << " (" << member.seconds << " s)" << std::endl;
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; t++) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+
+  int failures = 0;
+  for (const auto& member : members) {
+    if (!member.success) failures++;
+    if (!member.messages.empty())
+      std::cerr << "\n" << member.insfile << ":\n" << member.messages;
+  }
+  if (failures > 0) {
+    std::cerr << failures << " of " << members.size()
+              << " ensemble members failed." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cerr << "Successfully finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -8,63 +8,218 @@
  * \copyright LGPL-3.0-or-later
  * \date 2020
  */
-#include <fstream>
+#include <cstdio>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "fileystem.h"
 #include "megafauna.h"
 
 using namespace Fauna;
 
-/// Check the given instruction file.
+namespace {
+/// Settings given on the command line.
+struct Options {
+  /// Paths to the instruction files.
+  std::vector<std::string> files;
+  /// Output format of the summary: "text", "json", or "tsv".
+  std::string format = "text";
+  /// Number of files to check in parallel. Zero means one per CPU core.
+  int threads = 0;
+};
+
+/// Print the command line syntax to STDERR.
+void print_usage() {
+  // We use C++11 raw string literals like a Bash Here Document.
+  std::cerr << R"EOF(
+This is the instruction file linter of the Modular Megafauna Model (MMM).
+Use this program to check if TOML instruction files are valid.
+
+Usage:
+  megafauna_insfile_linter [options] <file_or_directory>...
+
+For a directory, all files ending with ".toml" in it are checked.
+The exit status is non-zero if any file is invalid.
+
+Options:
+  --format <text|json|tsv>  Format of the summary on STDOUT. (default: text)
+  --threads <n>             Number of files to check in parallel.
+                            (default: number of CPU cores)
+  --help                    Print this help text.
+)EOF";
+}
+
+/// Read the options from the command line.
 /**
- * \param argc Number of CLI parameters. Must be 2.
- * \param argv Vector of CLI parameters, must only contain two
- * elements: 1) the program name, 2) the path to the TOML instruction file.
+ * \return false if the program should exit successfully.
+ * \throw std::invalid_argument If the command line is malformed.
+ * \throw std::runtime_error If a directory cannot be read.
  */
-int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cerr << "This is the instruction file linter of the Modular "
-                 "Megafauna Model (MMM)."
-              << std::endl;
-    std::cerr
-        << "Use this program to check if a TOML instruction file is valid."
-        << std::endl;
-    std::cerr
-        << "Please provide the path to the TOML file as the only argument."
-        << std::endl;
-    return EXIT_FAILURE;
+bool parse_options(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help") {
+      print_usage();
+      return false;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      if (directory_exists(arg)) {
+        const std::vector<std::string> files = list_files(arg, ".toml");
+        options.files.insert(options.files.end(), files.begin(), files.end());
+      } else
+        options.files.push_back(arg);
+      continue;
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument("Option " + arg + " expects a value.");
+    const std::string value = argv[++i];
+    if (arg == "--format") {
+      if (value != "text" && value != "json" && value != "tsv")
+        throw std::invalid_argument("Unknown format: \"" + value + "\"");
+      options.format = value;
+    } else if (arg == "--threads") {
+      std::size_t pos = 0;
+      try {
+        options.threads = std::stoi(value, &pos);
+      } catch (const std::exception&) {
+        pos = 0;
+      }
+      if (pos != value.size() || options.threads < 1)
+        throw std::invalid_argument(
+            "Option --threads expects a positive integer, not \"" + value +
+            "\".");
+    } else
+      throw std::invalid_argument("Unknown option: \"" + arg + "\"");
   }
+  if (options.files.empty())
+    throw std::invalid_argument("Please provide at least one TOML file.");
+  return true;
+}
 
-  assert(argc == 2);
-  const std::string insfile = argv[1];
+/// Escape a string for a JSON string literal.
+std::string escape_json(const std::string& s) {
+  std::string result;
+  for (const char c : s) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", (int)c);
+          result += buffer;
+        } else
+          result += c;
+    }
+  }
+  return result;
+}
 
-  std::unique_ptr<Fauna::World> fauna_world;
+/// Escape a string for one TSV cell.
+std::string escape_tsv(const std::string& s) {
+  std::string result;
+  for (const char c : s) {
+    if (c == '\t')
+      result += "\\t";
+    else if (c == '\n')
+      result += "\\n";
+    else if (c == '\\')
+      result += "\\\\";
+    else if (c != '\r')
+      result += c;
+  }
+  return result;
+}
 
-  // Check if file exists
+/// Short status of a file: "ok", "warning", or "error".
+std::string get_status(const LintResult& result) {
+  if (!result.valid) return "error";
+  return result.warnings.empty() ? "ok" : "warning";
+}
 
-  std::ifstream f(insfile.c_str());
-  if (!f.good()) {
-    std::cerr
-        << "I cannot read the given file: "
-        << "'" << insfile << "'" << std::endl
-        << "Please check that the file exists and that we have read permission."
-        << std::endl;
-    return EXIT_FAILURE;
+/// Print the results in human-readable form.
+void print_text(const std::vector<LintResult>& results) {
+  for (const auto& r : results) {
+    if (!r.valid)
+      std::cout << r.filename << ": The instruction file looks problematic:\n"
+                << r.errors << "\n\n";
+    else if (!r.warnings.empty())
+      std::cout << r.filename
+                << ": The instruction file is valid, but there were "
+                   "warnings:\n"
+                << r.warnings << "\n";
+    else
+      std::cout << r.filename << ": The instruction file looks good.\n";
+  }
+}
+
+/// Print the results as JSON array of objects.
+void print_json(const std::vector<LintResult>& results) {
+  std::cout << "[\n";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const LintResult& r = results[i];
+    std::cout << "  {\"file\": \"" << escape_json(r.filename)
+              << "\", \"status\": \"" << get_status(r) << "\", \"errors\": \""
+              << escape_json(r.errors) << "\", \"warnings\": \""
+              << escape_json(r.warnings) << "\"}"
+              << (i + 1 < results.size() ? "," : "") << '\n';
   }
+  std::cout << "]\n";
+}
+
+/// Print the results as table with a header row.
+void print_tsv(const std::vector<LintResult>& results) {
+  std::cout << "file\tstatus\terrors\twarnings\n";
+  for (const auto& r : results)
+    std::cout << escape_tsv(r.filename) << '\t' << get_status(r) << '\t'
+              << escape_tsv(r.errors) << '\t' << escape_tsv(r.warnings)
+              << '\n';
+}
+}  // namespace
 
+/// Check the given instruction files.
+int main(int argc, char* argv[]) {
+  Options options;
   try {
-    fauna_world.reset(new Fauna::World(insfile, SimMode::Lint));
-  } catch (const std::runtime_error& e) {
-    std::cerr << "The instruction file looks problematic:" << std::endl
-              << std::endl
-              << e.what() << std::endl;
-    return EXIT_FAILURE;
+    if (!parse_options(argc, argv, options)) return EXIT_SUCCESS;
   } catch (const std::exception& e) {
-    std::cerr << "An unknown error occurred:" << std::endl
-              << std::endl
-              << e.what() << std::endl;
+    std::cerr << e.what() << std::endl;
+    print_usage();
     return EXIT_FAILURE;
   }
-  std::cerr << "The instruction file looks good." << std::endl;
-  return EXIT_SUCCESS;
+
+  const std::vector<LintResult> results =
+      lint_instruction_files(options.files, options.threads);
+
+  if (options.format == "json")
+    print_json(results);
+  else if (options.format == "tsv")
+    print_tsv(results);
+  else
+    print_text(results);
+
+  int invalid = 0, with_warnings = 0;
+  for (const auto& r : results) {
+    if (!r.valid) invalid++;
+    if (!r.warnings.empty()) with_warnings++;
+  }
+  std::cerr << results.size() << " files checked: " << invalid
+            << " invalid, " << with_warnings << " with warnings."
+            << std::endl;
+  return invalid > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
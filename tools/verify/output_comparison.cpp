@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Compare the output of two simulation runs within a tolerance.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "output_comparison.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include "Fauna/hft.h"
+
+using namespace Fauna;
+using namespace Fauna::Verify;
+
+namespace {
+/// Map the bits of a double to an integer that is monotonic in the value.
+std::int64_t get_ordered_bits(const double d) {
+  static_assert(sizeof(double) == sizeof(std::int64_t),
+                "A double must have 64 bits.");
+  std::int64_t i;
+  std::memcpy(&i, &d, sizeof(d));
+  // Negative values are stored as sign and magnitude. Flip them so that the
+  // integers increase together with the doubles. Then −0 maps to 0, too.
+  if (i < 0) i = std::numeric_limits<std::int64_t>::min() - i;
+  return i;
+}
+
+/// Name of a mortality factor for use in variable names.
+std::string get_mortality_name(const MortalityFactor factor) {
+  switch (factor) {
+    case MortalityFactor::Background:
+      return "background";
+    case MortalityFactor::Lifespan:
+      return "lifespan";
+    case MortalityFactor::StarvationIlliusOConnor2000:
+      return "starvation_illius_oconnor_2000";
+    case MortalityFactor::StarvationThreshold:
+      return "starvation_threshold";
+    default:
+      return std::to_string((int)factor);
+  }
+}
+
+/// Append one value per forage type.
+template <class T>
+void add_forage_values(const std::string& prefix, const T& values,
+                       std::vector<NamedValue>& result) {
+  for (const auto ft : FORAGE_TYPES)
+    result.emplace_back(prefix + "/" + get_forage_type_name(ft), values[ft]);
+}
+
+/// Key to match datapoints of two runs.
+typedef std::pair<Date, std::string> DatapointKey;
+
+/// Index the datapoints by date and aggregation unit.
+std::map<DatapointKey, const Output::Datapoint*> index_datapoints(
+    const std::vector<Output::Datapoint>& datapoints) {
+  std::map<DatapointKey, const Output::Datapoint*> result;
+  for (const auto& d : datapoints)
+    result[DatapointKey(d.interval.get_first(), d.aggregation_unit)] = &d;
+  return result;
+}
+}  // namespace
+
+long long Verify::get_ulp_distance(const double a, const double b) {
+  if (std::isnan(a) || std::isnan(b))
+    return std::isnan(a) == std::isnan(b) ? 0 : -1;
+  const std::int64_t ia = get_ordered_bits(a);
+  const std::int64_t ib = get_ordered_bits(b);
+  // Avoid signed overflow for values of opposite sign far apart.
+  const std::uint64_t diff = ia > ib ? (std::uint64_t)ia - (std::uint64_t)ib
+                                     : (std::uint64_t)ib - (std::uint64_t)ia;
+  if (diff > (std::uint64_t)std::numeric_limits<long long>::max())
+    return std::numeric_limits<long long>::max();
+  return (long long)diff;
+}
+
+bool Tolerance::accepts(const double a, const double b) const {
+  const long long ulps = get_ulp_distance(a, b);
+  if (ulps == 0) return true;
+  if (ulps < 0) return false;  // NaN
+  return ulps <= max_ulps || std::fabs(a - b) <= absolute;
+}
+
+std::vector<NamedValue> Verify::get_named_values(
+    const Output::CombinedData& data) {
+  std::vector<NamedValue> result;
+  const Output::HabitatData& habitat = data.habitat_data;
+  for (const auto ft : FORAGE_TYPES) {
+    const ForageBase& forage = habitat.available_forage[ft];
+    const std::string prefix =
+        "habitat/available_forage/" + get_forage_type_name(ft);
+    result.emplace_back(prefix + "/mass", forage.get_mass());
+    result.emplace_back(prefix + "/digestibility", forage.get_digestibility());
+    result.emplace_back(prefix + "/nitrogen_mass", forage.get_nitrogen_mass());
+  }
+  add_forage_values("habitat/eaten_forage", habitat.eaten_forage, result);
+  result.emplace_back("habitat/environment/air_temperature",
+                      habitat.environment.air_temperature);
+
+  // std::map is sorted by HFT name.
+  for (const auto& itr : data.hft_data) {
+    const std::string prefix = "hft/" + itr.first + "/";
+    const Output::HerbivoreData& h = itr.second;
+    result.emplace_back(prefix + "age_years", h.age_years);
+    result.emplace_back(prefix + "bodyfat", h.bodyfat);
+    result.emplace_back(prefix + "expenditure", h.expenditure);
+    result.emplace_back(prefix + "inddens", h.inddens);
+    result.emplace_back(prefix + "massdens", h.massdens);
+    for (const auto& m : h.mortality)
+      result.emplace_back(prefix + "mortality/" + get_mortality_name(m.first),
+                          m.second);
+    result.emplace_back(prefix + "offspring", h.offspring);
+    add_forage_values(prefix + "eaten_forage_per_ind", h.eaten_forage_per_ind,
+                      result);
+    add_forage_values(prefix + "eaten_forage_per_mass",
+                      h.eaten_forage_per_mass, result);
+    result.emplace_back(prefix + "eaten_nitrogen_per_ind",
+                        h.eaten_nitrogen_per_ind);
+    add_forage_values(prefix + "energy_content", h.energy_content, result);
+    add_forage_values(prefix + "energy_intake_per_ind",
+                      h.energy_intake_per_ind, result);
+    add_forage_values(prefix + "energy_intake_per_mass",
+                      h.energy_intake_per_mass, result);
+  }
+  return result;
+}
+
+std::string Divergence::to_string() const {
+  std::ostringstream s;
+  s.precision(17);
+  s << "aggregation unit \"" << aggregation_unit << "\", year "
+    << date.get_year() << ", day " << date.get_julian_day() << ": "
+    << variable;
+  if (ulps != 0)
+    s << " (expected " << expected << ", actual " << actual << ", " << ulps
+      << " ULPs)";
+  return s.str();
+}
+
+bool Verify::compare_output(const std::vector<Output::Datapoint>& reference,
+                            const std::vector<Output::Datapoint>& actual,
+                            const Tolerance& tolerance,
+                            Divergence& divergence) {
+  const auto expected_index = index_datapoints(reference);
+  const auto actual_index = index_datapoints(actual);
+
+  auto e = expected_index.begin();
+  auto a = actual_index.begin();
+  while (e != expected_index.end() || a != actual_index.end()) {
+    // Report a datapoint that exists in only one of the runs.
+    const bool missing =
+        a == actual_index.end() ||
+        (e != expected_index.end() && e->first < a->first);
+    const bool extra = e == expected_index.end() || a->first < e->first;
+    if (missing || extra) {
+      const DatapointKey& key = missing ? e->first : a->first;
+      divergence = Divergence();
+      divergence.date = key.first;
+      divergence.aggregation_unit = key.second;
+      divergence.variable = missing ? "datapoint is missing"
+                                    : "datapoint is not in reference";
+      return false;
+    }
+
+    const std::vector<NamedValue> expected_values =
+        get_named_values(e->second->data);
+    const std::vector<NamedValue> actual_values =
+        get_named_values(a->second->data);
+    divergence = Divergence();
+    divergence.date = e->first.first;
+    divergence.aggregation_unit = e->first.second;
+    for (std::size_t i = 0; i < expected_values.size(); i++) {
+      const NamedValue& ev = expected_values[i];
+      if (i >= actual_values.size() || actual_values[i].first != ev.first) {
+        divergence.variable = ev.first + " is missing";
+        return false;
+      }
+      const double av = actual_values[i].second;
+      if (!tolerance.accepts(ev.second, av)) {
+        divergence.variable = ev.first;
+        divergence.expected = ev.second;
+        divergence.actual = av;
+        divergence.ulps = get_ulp_distance(ev.second, av);
+        return false;
+      }
+    }
+    if (actual_values.size() > expected_values.size()) {
+      divergence.variable = actual_values[expected_values.size()].first +
+                            " is not in reference";
+      return false;
+    }
+    ++e;
+    ++a;
+  }
+  return true;
+}
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Compare the output of two simulation runs within a tolerance.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#ifndef FAUNA_VERIFY_OUTPUT_COMPARISON_H
+#define FAUNA_VERIFY_OUTPUT_COMPARISON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Fauna/Output/datapoint.h"
+
+namespace Fauna {
+namespace Verify {
+
+/// Number of representable doubles between two values.
+/**
+ * Zero means that the values are identical (+0 and −0 are equal). Adjacent
+ * doubles have a distance of one.
+ * \return The distance, or -1 if one of the values is NaN and the other is
+ * not. Two NaN values have a distance of zero.
+ */
+long long get_ulp_distance(const double a, const double b);
+
+/// Maximum deviation for two values to be considered equal.
+struct Tolerance {
+  /// Maximum distance in units in the last place.
+  /** \see \ref get_ulp_distance() */
+  long long max_ulps = 0;
+
+  /// Absolute difference that is always accepted.
+  /**
+   * Values close to zero can be very many ULPs apart even though the
+   * difference is negligible.
+   */
+  double absolute = 0.0;
+
+  /// Whether the two values are equal within the tolerance.
+  bool accepts(const double a, const double b) const;
+};
+
+/// A named numeric value in a datapoint, e.g. "hft/Deer/massdens".
+typedef std::pair<std::string, double> NamedValue;
+
+/// List all numeric output variables of one datapoint with unique names.
+/**
+ * Habitat variables start with "habitat/", herbivore variables with
+ * "hft/<name>/". The order is deterministic.
+ */
+std::vector<NamedValue> get_named_values(const Output::CombinedData& data);
+
+/// Where and how the output of two runs differ first.
+struct Divergence {
+  /// Aggregation unit of the datapoint.
+  std::string aggregation_unit;
+  /// First day of the output interval.
+  Date date = Date(0, 0);
+  /// Name of the variable as in \ref get_named_values().
+  /**
+   * If a datapoint or a variable is missing in one of the runs, this
+   * describes what is missing.
+   */
+  std::string variable;
+  /// Value in the reference run.
+  double expected = 0.0;
+  /// Value in the compared run.
+  double actual = 0.0;
+  /// Distance between `expected` and `actual`.
+  long long ulps = 0;
+
+  /// One line of human-readable text.
+  std::string to_string() const;
+};
+
+/// Compare the datapoints of two simulation runs.
+/**
+ * Datapoints are matched by aggregation unit and output interval, so their
+ * order in the vectors doesn’t matter. They are compared in chronological
+ * order, and within each date in alphabetical order of the aggregation
+ * units.
+ * \param reference Output of the reference run.
+ * \param actual Output of the run to check.
+ * \param tolerance Accepted deviation of each value.
+ * \param[out] divergence The first difference, if one was found.
+ * \return true if all datapoints are equal within the tolerance.
+ */
+bool compare_output(const std::vector<Output::Datapoint>& reference,
+                    const std::vector<Output::Datapoint>& actual,
+                    const Tolerance& tolerance, Divergence& divergence);
+
+}  // namespace Verify
+}  // namespace Fauna
+
+#endif  // FAUNA_VERIFY_OUTPUT_COMPARISON_H
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Unit test for the output comparison of the verification tool.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include "output_comparison.h"
+
+#include <cmath>
+#include <limits>
+
+#include "Fauna/storage_real.h"
+#include "catch.hpp"
+
+using namespace Fauna;
+using namespace Fauna::Verify;
+
+TEST_CASE("Fauna::Verify::get_ulp_distance()", "") {
+  const double NaN = std::numeric_limits<double>::quiet_NaN();
+  CHECK(get_ulp_distance(1.0, 1.0) == 0);
+  CHECK(get_ulp_distance(0.0, -0.0) == 0);
+  CHECK(get_ulp_distance(1.0, std::nextafter(1.0, 2.0)) == 1);
+  CHECK(get_ulp_distance(std::nextafter(1.0, 2.0), 1.0) == 1);
+  CHECK(get_ulp_distance(-1.0, std::nextafter(-1.0, -2.0)) == 1);
+  // The smallest denormals on either side of zero.
+  const double tiny = std::numeric_limits<double>::denorm_min();
+  CHECK(get_ulp_distance(-tiny, tiny) == 2);
+  CHECK(get_ulp_distance(NaN, NaN) == 0);
+  CHECK(get_ulp_distance(NaN, 1.0) == -1);
+  CHECK(get_ulp_distance(-1e300, 1e300) > 0);
+
+  Tolerance tolerance;
+  CHECK(tolerance.accepts(2.0, 2.0));
+  CHECK(!tolerance.accepts(2.0, std::nextafter(2.0, 3.0)));
+  CHECK(!tolerance.accepts(NaN, 2.0));
+  tolerance.max_ulps = 1;
+  CHECK(tolerance.accepts(2.0, std::nextafter(2.0, 3.0)));
+  CHECK(!tolerance.accepts(0.0, 1e-20));
+  tolerance.absolute = 1e-10;
+  CHECK(tolerance.accepts(0.0, 1e-20));
+  CHECK(!tolerance.accepts(0.0, 1e-9));
+}
+
+TEST_CASE("Fauna::Verify::compare_output()", "") {
+  Output::Datapoint datapoint;
+  datapoint.aggregation_unit = "a";
+  datapoint.interval = DateInterval(Date(3, 1), Date(3, 1));
+  datapoint.data.habitat_data.available_forage.grass.set_mass(100.0);
+  datapoint.data.hft_data["deer"].massdens = 5.0;
+  datapoint.data.hft_data["deer"].mortality[MortalityFactor::Background] =
+      0.1;
+
+  const std::vector<NamedValue> values = get_named_values(datapoint.data);
+  REQUIRE(!values.empty());
+  CHECK(values.front().first == "habitat/available_forage/grass/mass");
+  CHECK(values.front().second == 100.0);
+  int massdens_count = 0;
+  for (const auto& v : values)
+    if (v.first == "hft/deer/massdens") {
+      massdens_count++;
+      CHECK(v.second == 5.0);
+    }
+  CHECK(massdens_count == 1);
+
+  std::vector<Output::Datapoint> reference;
+  reference.push_back(datapoint);
+  datapoint.aggregation_unit = "b";
+  reference.push_back(datapoint);
+  Divergence divergence;
+  const Tolerance tolerance;
+
+  SECTION("Identical") {
+    CHECK(compare_output(reference, reference, tolerance, divergence));
+  }
+
+  SECTION("Different order") {
+    std::vector<Output::Datapoint> actual;
+    actual.push_back(reference[1]);
+    actual.push_back(reference[0]);
+    CHECK(compare_output(reference, actual, tolerance, divergence));
+  }
+
+  SECTION("Different value") {
+    // One ulp of the herbivore output in units of double, which is more with
+    // MEGAFAUNA_FLOAT_STORAGE.
+    const long long ULPS =
+        (sizeof(StorageReal) == sizeof(double))
+            ? 1
+            : 1LL << (std::numeric_limits<double>::digits -
+                      std::numeric_limits<StorageReal>::digits);
+    std::vector<Output::Datapoint> actual = reference;
+    actual[1].data.hft_data["deer"].massdens =
+        std::nextafter(StorageReal(5.0), StorageReal(6.0));
+    REQUIRE(!compare_output(reference, actual, tolerance, divergence));
+    CHECK(divergence.aggregation_unit == "b");
+    CHECK(divergence.date == Date(3, 1));
+    CHECK(divergence.variable == "hft/deer/massdens");
+    CHECK(divergence.expected == 5.0);
+    CHECK(divergence.ulps == ULPS);
+    CHECK(divergence.to_string().find("massdens") != std::string::npos);
+
+    Tolerance loose;
+    loose.max_ulps = ULPS;
+    CHECK(compare_output(reference, actual, loose, divergence));
+  }
+
+  SECTION("Different habitat value") {
+    std::vector<Output::Datapoint> actual = reference;
+    actual[1].data.habitat_data.available_forage.grass.set_mass(
+        std::nextafter(100.0, 101.0));
+    REQUIRE(!compare_output(reference, actual, tolerance, divergence));
+    CHECK(divergence.aggregation_unit == "b");
+    CHECK(divergence.date == Date(3, 1));
+    CHECK(divergence.variable == "habitat/available_forage/grass/mass");
+    CHECK(divergence.expected == 100.0);
+    CHECK(divergence.ulps == 1);
+    CHECK(divergence.to_string().find("grass/mass") != std::string::npos);
+  }
+
+  SECTION("Missing datapoint") {
+    std::vector<Output::Datapoint> actual = reference;
+    actual.pop_back();
+    REQUIRE(!compare_output(reference, actual, tolerance, divergence));
+    CHECK(divergence.aggregation_unit == "b");
+    CHECK(divergence.variable == "datapoint is missing");
+    REQUIRE(!compare_output(actual, reference, tolerance, divergence));
+    CHECK(divergence.variable == "datapoint is not in reference");
+  }
+
+  SECTION("Missing HFT") {
+    std::vector<Output::Datapoint> actual = reference;
+    actual[0].data.hft_data.clear();
+    REQUIRE(!compare_output(reference, actual, tolerance, divergence));
+    CHECK(divergence.aggregation_unit == "a");
+    CHECK(divergence.variable.find("hft/deer/") == 0);
+  }
+}
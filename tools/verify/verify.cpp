@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: 2020 W. Traylor <wolfgang.traylor@senckenberg.de>
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+/**
+ * \file
+ * \brief Check that execution settings don’t change the simulation results.
+ * \copyright LGPL-3.0-or-later
+ * \date 2026
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "insfile_reader.h"
+#include "megafauna.h"
+#include "output_comparison.h"
+#include "parameters.h"
+
+using namespace Fauna;
+using namespace Fauna::Verify;
+
+namespace {
+/// How the simulation is executed in one run.
+/**
+ * None of these settings may change the simulation results.
+ */
+struct Configuration {
+  /// Unique name to select the configuration on the command line.
+  std::string name;
+  /// What is different from the reference run.
+  std::string description;
+  /// Create the simulation units in reverse order of the trace.
+  bool reverse_units = false;
+  /// Enable profiling, tracing, and the equilibrium monitor.
+  bool instrumented = false;
+  /// Save a checkpoint halfway and continue in a new \ref World object.
+  bool checkpoint = false;
+  /// Simulate ranges of days with \ref World::simulate_days().
+  bool ranged = false;
+  /// Number of threads for \ref World::enable_threads(), or 1 to disable.
+  int threads = 1;
+};
+
+/// All configurations. The first one is the reference.
+std::vector<Configuration> get_configurations() {
+  std::vector<Configuration> result;
+  Configuration c;
+  c.name = "reference";
+  c.description = "simulation units in recorded order";
+  result.push_back(c);
+
+  c = Configuration();
+  c.name = "reverse_units";
+  c.description = "simulation units in reverse order";
+  c.reverse_units = true;
+  result.push_back(c);
+
+  c = Configuration();
+  c.name = "instrumented";
+  c.description = "profiling, tracing, and equilibrium monitor";
+  c.instrumented = true;
+  result.push_back(c);
+
+  c = Configuration();
+  c.name = "checkpoint";
+  c.description = "restart from a checkpoint halfway";
+  c.checkpoint = true;
+  result.push_back(c);
+
+  c = Configuration();
+  c.name = "ranged";
+  c.description = "many days per call, one simulation unit after the other";
+  c.ranged = true;
+  result.push_back(c);
+
+  c = Configuration();
+  c.name = "threads";
+  c.description = "simulation units in 4 threads with work stealing";
+  c.threads = 4;
+  result.push_back(c);
+  return result;
+}
+
+/// Settings given on the command line.
+struct Options {
+  /// Path to the megafauna instruction file.
+  std::string insfile;
+  /// Path to the forcing trace.
+  std::string trace;
+  /// Names of the configurations to compare with the reference.
+  std::vector<std::string> configurations;
+  /// Output interval: "daily", "monthly", "annual", or "decadal".
+  std::string interval = "daily";
+  /// Accepted deviation.
+  Tolerance tolerance;
+};
+
+/// Print the command line syntax to STDERR.
+void print_usage() {
+  // We use C++11 raw string literals like a Bash Here Document.
+  std::cerr << R"EOF(
+Usage:
+  megafauna_verify [options] <fauna_instruction_file> <trace_file>
+
+Replays the habitat forcing of a trace file, which was recorded with
+`megafauna_demo_simulator --record`, under different execution
+configurations. The output of each configuration is compared with the
+reference run, and the first diverging value is reported.
+
+Options:
+  --config <name>       Compare only this configuration with the reference.
+                        Can be given multiple times. (default: all)
+  --list                Print the available configurations.
+  --interval <daily|monthly|annual|decadal>
+                        Output interval. (default: daily)
+  --max-ulps <n>        Accepted distance in units in the last place.
+                        (default: 0)
+  --abs-tolerance <x>   Accepted absolute difference. (default: 0)
+  --help                Print this help text.
+)EOF";
+}
+
+/// Parse a number from a command line argument.
+/**
+ * \throw std::invalid_argument If the string is not a non-negative number.
+ */
+double parse_number(const std::string& option, const std::string& value) {
+  std::size_t pos = 0;
+  double result = -1.0;
+  try {
+    result = std::stod(value, &pos);
+  } catch (const std::exception&) {
+    pos = 0;
+  }
+  if (pos != value.size() || !(result >= 0.0))
+    throw std::invalid_argument("Option " + option +
+                                " expects a non-negative number, not \"" +
+                                value + "\".");
+  return result;
+}
+
+/// Find a configuration by name.
+/**
+ * \throw std::invalid_argument If there is no configuration with the name.
+ */
+const Configuration& get_configuration(const std::string& name) {
+  static const std::vector<Configuration> all = get_configurations();
+  for (const auto& c : all)
+    if (c.name == name) return c;
+  throw std::invalid_argument("Unknown configuration: \"" + name + "\"");
+}
+
+/// Convert the command line option into the parameter value.
+OutputInterval get_interval(const std::string& interval) {
+  if (interval == "daily") return OutputInterval::Daily;
+  if (interval == "monthly") return OutputInterval::Monthly;
+  if (interval == "annual") return OutputInterval::Annual;
+  if (interval == "decadal") return OutputInterval::Decadal;
+  throw std::invalid_argument("Unknown output interval: \"" + interval +
+                              "\"");
+}
+
+/// Read the options from the command line.
+/**
+ * \return false if the program should exit successfully.
+ * \throw std::invalid_argument If the command line is malformed.
+ */
+bool parse_options(int argc, char* argv[], Options& options) {
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--help") {
+      print_usage();
+      return false;
+    }
+    if (arg == "--list") {
+      for (const auto& c : get_configurations())
+        std::cout << c.name << "\t" << c.description << '\n';
+      return false;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      files.push_back(arg);
+      continue;
+    }
+    if (i + 1 >= argc)
+      throw std::invalid_argument("Option " + arg + " expects a value.");
+    const std::string value = argv[++i];
+    if (arg == "--config")
+      options.configurations.push_back(get_configuration(value).name);
+    else if (arg == "--interval") {
+      get_interval(value);  // validate
+      options.interval = value;
+    } else if (arg == "--max-ulps")
+      options.tolerance.max_ulps = (long long)parse_number(arg, value);
+    else if (arg == "--abs-tolerance")
+      options.tolerance.absolute = parse_number(arg, value);
+    else
+      throw std::invalid_argument("Unknown option: \"" + arg + "\"");
+  }
+  if (files.size() != 2)
+    throw std::invalid_argument(
+        "Expected an instruction file and a trace file.");
+  options.insfile = files[0];
+  options.trace = files[1];
+  if (options.configurations.empty())
+    for (const auto& c : get_configurations())
+      if (c.name != "reference") options.configurations.push_back(c.name);
+  return true;
+}
+
+/// Replay the trace with the given configuration.
+/**
+ * \return All output datapoints.
+ * \throw std::exception If the simulation fails.
+ */
+std::vector<Output::Datapoint> run(
+    const Configuration& config, const std::string& trace,
+    const std::shared_ptr<const Parameters> params,
+    const std::shared_ptr<const HftList> hfts) {
+  std::shared_ptr<ForcingPlayer> player(new ForcingPlayer(trace));
+  std::vector<std::shared_ptr<ReplayHabitat>> habitats;
+  int days = 0;
+  // Days on which a habitat has run out of records.
+  std::set<int> exhaustion_days;
+  for (int i = 0; i < player->get_habitat_count(); i++) {
+    habitats.emplace_back(new ReplayHabitat(player, i));
+    days = std::max(days, player->get_day_count(i));
+    exhaustion_days.insert(player->get_day_count(i));
+  }
+  if (config.reverse_units) std::reverse(habitats.begin(), habitats.end());
+
+  std::vector<Output::Datapoint> output;
+  std::unique_ptr<World> world;
+  const std::string checkpoint_file = "megafauna_verify_checkpoint.bin";
+  const std::string trace_file = "megafauna_verify_trace.json";
+  // Create a World with all living habitats.
+  const auto create_world = [&]() {
+    world.reset(new World(params, hfts));
+    world->set_output_callback(
+        [&output](const Output::Datapoint& d) { output.push_back(d); });
+    for (const auto& h : habitats)
+      if (!h->is_dead()) world->create_simulation_unit(h);
+    if (config.instrumented) {
+      world->enable_profiling();
+      world->enable_tracing(trace_file);
+      world->enable_equilibrium_monitor(0.01);
+    }
+    if (config.threads > 1) world->enable_threads(config.threads);
+  };
+  create_world();
+
+  for (int i = 0; i < days;) {
+    if (config.checkpoint && i == days / 2) {
+      world->save_checkpoint(checkpoint_file);
+      create_world();
+      world->load_checkpoint(checkpoint_file);
+      std::remove(checkpoint_file.c_str());
+    }
+    // A habitat without further records has been killed in the recording.
+    for (auto& h : habitats)
+      if (h->is_exhausted()) h->kill();
+    if (config.ranged) {
+      // Habitats must not be killed within a range of days.
+      int end = days;
+      const auto next = exhaustion_days.upper_bound(i);
+      if (next != exhaustion_days.end()) end = std::min(end, *next);
+      world->simulate_days(Date(i % 365, i / 365),
+                           Date((end - 1) % 365, (end - 1) / 365));
+      i = end;
+    } else {
+      world->simulate_day(Date(i % 365, i / 365), true);
+      i++;
+    }
+  }
+  world->flush_output();
+  world.reset();
+  if (config.instrumented) std::remove(trace_file.c_str());
+  return output;
+}
+}  // namespace
+
+/// Compare the output of the configurations with the reference run.
+int main(int argc, char* argv[]) {
+  Options options;
+  try {
+    if (!parse_options(argc, argv, options)) return EXIT_SUCCESS;
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  bool all_equal = true;
+  try {
+    const InsfileReader reader(options.insfile);
+    std::cerr << reader.get_warnings();
+    std::shared_ptr<Parameters> params(new Parameters(reader.get_params()));
+    params->output_format = OutputFormat::InMemory;
+    params->output_interval = get_interval(options.interval);
+    const std::shared_ptr<const HftList> hfts(
+        new HftList(reader.get_hfts()));
+
+    std::cerr << "Running reference configuration..." << std::endl;
+    const std::vector<Output::Datapoint> reference =
+        run(get_configuration("reference"), options.trace, params, hfts);
+    std::cerr << reference.size() << " datapoints." << std::endl;
+
+    for (const auto& name : options.configurations) {
+      const Configuration& config = get_configuration(name);
+      const std::vector<Output::Datapoint> actual =
+          run(config, options.trace, params, hfts);
+      Divergence divergence;
+      if (compare_output(reference, actual, options.tolerance, divergence)) {
+        std::cout << "PASS " << config.name << " (" << config.description
+                  << ")" << std::endl;
+      } else {
+        all_equal = false;
+        std::cout << "FAIL " << config.name << " (" << config.description
+                  << ")\n  first divergence at " << divergence.to_string()
+                  << std::endl;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Verification failed:\n" << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return all_equal ? EXIT_SUCCESS : EXIT_FAILURE;
+}